@@ -2,16 +2,19 @@
 #include "Benchmark.h"
 
 #include "aquila/dtw/Dtw.h"
+#include "aquila/LargeFft.h"
 #include "aquila/Transform.h"
 #include "aquila/WaveFile.h"
 #include "aquila/ConsoleProcessingIndicator.h"
 #include "../utils.h"
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <iostream>
 #include <numeric>
 #include <boost/filesystem.hpp>
 #include <boost/progress.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
 
 
 Benchmark::Benchmark(int iterations_count):
@@ -29,10 +32,14 @@ void Benchmark::run()
 {
     std::cout << "Benchmarking, please wait..." << std::endl;
     testFft();
+    testLargeFft();
     testDct();
     testWavefile();
+    testWavefileMapped();
+    testWavefileNative();
     testEnergy();
     testMfcc();
+    checkMfccLength();
     testDtw();
 
     double result = std::accumulate(durations.begin(), durations.end(), 0.0);
@@ -42,7 +49,9 @@ void Benchmark::run()
 
 void Benchmark::testFft()
 {
-    const int TEST_DATA_SIZE = 65536;
+    // the largest single-threaded radix-4 size; longer transforms are
+    // computed by LargeFft on many threads, see testLargeFft()
+    const int TEST_DATA_SIZE = Aquila::LARGE_FFT_MIN_LENGTH / 2;
     std::vector<double> testData(TEST_DATA_SIZE);
     std::generate(testData.begin(), testData.end(), generateRandomDouble);
     Aquila::spectrumType spectrum(TEST_DATA_SIZE);
@@ -61,6 +70,32 @@ void Benchmark::testFft()
     std::cout << "FFT: " << duration << std::endl;
 }
 
+void Benchmark::testLargeFft()
+{
+    using namespace boost::posix_time;
+
+    // whole-recording sizes; the transform runs on many threads,
+    // so wall time is measured instead of processor time, and it is
+    // not added to the total result, which sums processor times
+    for (unsigned int power = 20; power <= 24; ++power)
+    {
+        const unsigned int size = 1u << power;
+        std::vector<double> testData(size);
+        std::generate(testData.begin(), testData.end(), generateRandomDouble);
+        Aquila::spectrumType spectrum(size);
+        Aquila::Transform transform(0);
+
+        // the first call creates sub-transform plans
+        transform.fft(testData, spectrum);
+
+        ptime start = microsec_clock::universal_time();
+        transform.fft(testData, spectrum);
+        double duration = (microsec_clock::universal_time() - start)
+            .total_microseconds() / 1e6;
+        std::cout << "Large FFT (2^" << power << "): " << duration << std::endl;
+    }
+}
+
 void Benchmark::testDct()
 {
     const int TEST_DATA_SIZE = 1024, DCT_SIZE = 12;
@@ -100,6 +135,46 @@ void Benchmark::testWavefile()
     delete wav;
 }
 
+void Benchmark::testWavefileMapped()
+{
+    Aquila::WaveFile* wav = new Aquila::WaveFile(20, 0.66);
+    wav->setLoadMode(Aquila::LOAD_MAPPED);
+    std::string filename = getFile("test.wav");
+
+    boost::progress_display progress(ITERATIONS);
+    startTime = clock();
+    for (int i = 0; i < ITERATIONS; ++i)
+    {
+        wav->load(filename);
+        ++progress;
+    }
+
+    double duration = clock() - startTime;
+    durations.push_back(duration);
+    std::cout << "Wave file (mapped): " << duration << std::endl;
+    delete wav;
+}
+
+void Benchmark::testWavefileNative()
+{
+    Aquila::WaveFile* wav = new Aquila::WaveFile(20, 0.66);
+    wav->setLoadMode(Aquila::LOAD_NATIVE);
+    std::string filename = getFile("test.wav");
+
+    boost::progress_display progress(ITERATIONS);
+    startTime = clock();
+    for (int i = 0; i < ITERATIONS; ++i)
+    {
+        wav->load(filename);
+        ++progress;
+    }
+
+    double duration = clock() - startTime;
+    durations.push_back(duration);
+    std::cout << "Wave file (native): " << duration << std::endl;
+    delete wav;
+}
+
 void Benchmark::testEnergy()
 {
     Aquila::WaveFile* wav = new Aquila::WaveFile(20, 0.66);
@@ -152,6 +227,38 @@ void Benchmark::testMfcc()
     delete wav;
 }
 
+void Benchmark::checkMfccLength()
+{
+    // more coefficients than Mel filters are computed by the direct DCT,
+    // the leading ones must match those of a shorter feature vector
+    Aquila::WaveFile wav(20, 0.66);
+    wav.load(getFile("test.wav"));
+
+    Aquila::TransformOptions options;
+    options.preemphasisFactor = 0.9375;
+    options.windowType = Aquila::WIN_HAMMING;
+    options.zeroPaddedLength = wav.getSamplesPerFrameZP();
+
+    const unsigned int SHORT_SIZE = 10, LONG_SIZE = Aquila::MELFILTERS + 6;
+    Aquila::MfccExtractor shortMfcc(20, SHORT_SIZE), longMfcc(20, LONG_SIZE);
+    shortMfcc.process(&wav, options);
+    longMfcc.process(&wav, options);
+
+    bool ok = shortMfcc.getFramesCount() == longMfcc.getFramesCount();
+    for (unsigned int i = 0; ok && i < shortMfcc.getFramesCount(); ++i)
+    {
+        const std::vector<double>& a = shortMfcc.getVector(i);
+        const std::vector<double>& b = longMfcc.getVector(i);
+        for (unsigned int j = 0; j < SHORT_SIZE; ++j)
+        {
+            if (std::fabs(a[j] - b[j]) > 1e-9 * (1.0 + std::fabs(a[j])))
+                ok = false;
+        }
+    }
+    std::cout << "MFCC (" << LONG_SIZE << " coefficients): "
+              << (ok ? "OK" : "FAILED") << std::endl;
+}
+
 void Benchmark::testDtw()
 {
     if (!extractor)
@@ -14,10 +14,14 @@ public:
 
 private:
     void testFft();
+    void testLargeFft();
     void testDct();
     void testWavefile();
+    void testWavefileMapped();
+    void testWavefileNative();
     void testEnergy();
     void testMfcc();
+    void checkMfccLength();
     void testDtw();
 
     double clock();
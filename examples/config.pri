@@ -6,11 +6,13 @@ win32 {
     INCLUDEPATH += F:\boost_1_41_0
     LIBS += -LF:\boost_1_41_0\stage\lib
     LIBS += -llibboost_filesystem-mgw44-s \
-            -llibboost_system-mgw44-s
+            -llibboost_system-mgw44-s \
+            -llibboost_thread-mgw44-mt-s
 }
 unix {
     LIBS += -lboost_filesystem-mt \
-            -lboost_system-mt
+            -lboost_system-mt \
+            -lboost_thread-mt
 }
 # AQUILA
 win32 {
@@ -0,0 +1,126 @@
+/**
+ * @file AlignedAllocator.h
+ *
+ * STL allocator returning aligned memory - header.
+ *
+ * Vectorized kernels load several values at once, which is fastest
+ * when the data is aligned to the vector size (64 bytes for AVX-512).
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#ifndef ALIGNEDALLOCATOR_H
+#define ALIGNEDALLOCATOR_H
+
+#include "global.h"
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace Aquila
+{
+    /**
+     * Default alignment in bytes - enough for any SIMD register.
+     */
+    const std::size_t SIMD_ALIGNMENT = 64;
+
+    /**
+     * An allocator for STL containers, which aligns memory blocks.
+     *
+     * The memory is taken from malloc() with some slack, and the original
+     * pointer is stored just before the aligned block.
+     */
+    template <typename T, std::size_t Alignment = SIMD_ALIGNMENT>
+    class AlignedAllocator
+    {
+    public:
+        typedef T value_type;
+        typedef T* pointer;
+        typedef const T* const_pointer;
+        typedef T& reference;
+        typedef const T& const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        /**
+         * Allocator of another type, with the same alignment.
+         */
+        template <typename U>
+        struct rebind
+        {
+            typedef AlignedAllocator<U, Alignment> other;
+        };
+
+        AlignedAllocator() throw() {}
+
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>&) throw() {}
+
+        pointer address(reference x) const { return &x; }
+        const_pointer address(const_reference x) const { return &x; }
+
+        /**
+         * Allocates aligned memory for n objects.
+         *
+         * @param n number of objects
+         * @return aligned pointer
+         * @throw std::bad_alloc when out of memory
+         */
+        pointer allocate(size_type n, const void* = 0)
+        {
+            void* raw = std::malloc(n * sizeof(T) + Alignment + sizeof(void*));
+            if (!raw)
+                throw std::bad_alloc();
+
+            std::size_t address = reinterpret_cast<std::size_t>(raw) +
+                sizeof(void*);
+            address = (address + Alignment - 1) & ~(Alignment - 1);
+            void** aligned = reinterpret_cast<void**>(address);
+            aligned[-1] = raw;
+
+            return reinterpret_cast<pointer>(aligned);
+        }
+
+        /**
+         * Frees memory returned by allocate().
+         *
+         * @param p aligned pointer
+         */
+        void deallocate(pointer p, size_type)
+        {
+            if (p)
+                std::free(reinterpret_cast<void**>(p)[-1]);
+        }
+
+        size_type max_size() const
+        {
+            return (static_cast<size_type>(-1) - Alignment) / sizeof(T);
+        }
+
+        void construct(pointer p, const T& value) { new (p) T(value); }
+        void destroy(pointer p) { p->~T(); }
+    };
+
+    template <typename T, typename U, std::size_t A>
+    bool operator==(const AlignedAllocator<T, A>&, const AlignedAllocator<U, A>&)
+    {
+        return true;
+    }
+
+    template <typename T, typename U, std::size_t A>
+    bool operator!=(const AlignedAllocator<T, A>&, const AlignedAllocator<U, A>&)
+    {
+        return false;
+    }
+
+    /**
+     * A vector of doubles aligned for SIMD access.
+     */
+    typedef std::vector<double, AlignedAllocator<double> > alignedVectorType;
+}
+
+#endif // ALIGNEDALLOCATOR_H
@@ -12,24 +12,57 @@
 #ifndef CACHE_H
 #define CACHE_H
 
-#define AQUILA_CACHE_STATS 0
-
+#include <cstddef>
+#include <list>
 #include <map>
-#ifdef AQUILA_CACHE_STATS
-#include <iostream>
-static int s_cacheHits = 0, s_cacheLookups = 0;
-#endif
+#include <utility>
+#include <vector>
+#include <boost/functional/hash.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
 
 
 namespace Aquila
 {
     /**
-     * A generic calculation cache.
+     * Default number of independently locked parts of a cache.
+     */
+    const unsigned int DEFAULT_CACHE_SHARDS = 8;
+
+    /**
+     * Counters of cache activity, as returned by Cache::getStats().
+     */
+    struct CacheStats
+    {
+        /**
+         * Number of lookups which found the value in cache.
+         */
+        unsigned long hits;
+
+        /**
+         * Number of lookups which called the generator.
+         */
+        unsigned long misses;
+
+        /**
+         * Number of values removed to keep the cache within its capacity.
+         */
+        unsigned long evictions;
+
+        /**
+         * Number of values currently stored.
+         */
+        std::size_t size;
+    };
+
+
+    /**
+     * A generic, thread-safe calculation cache.
      *
      * The cache class holds results of possibly expensive calculations, for
-     * example intermediate values in FFT transform. The values (which can
-     * be scalars, C-style arrays, vectors etc.) are identified by a cache
-     * key of type Cache::KeyType.
+     * example twiddle factors of FFT. The values are identified by a cache
+     * key of type Cache::KeyType, which must be comparable with operator<
+     * and hashable with boost::hash.
      *
      * Cache object constructor call needs to be supplied with a generator
      * function. It can be a standalone function or a static class method
@@ -37,6 +70,16 @@ namespace Aquila
      * of the cache value type. For example, if the cache stores integer
      * values identified by a string, the generator signature should match
      * int generate(const string& key).
+     *
+     * Keys are spread over a few shards, each with its own lock, so that
+     * threads looking up different keys rarely wait for each other. The
+     * generator is called without holding any lock; when two threads
+     * compute the same value at once, the first stored one is kept.
+     *
+     * A capacity limits the number of stored values; least recently used
+     * ones are evicted first. Values are returned by copy, so they should
+     * be cheap to copy - eg. shared pointers, which also keep evicted
+     * values alive while they are in use.
      */
     template <typename K, typename V>
     class Cache
@@ -57,26 +100,36 @@ namespace Aquila
          */
         typedef ValueType (*GeneratorFunction)(const KeyType&);
 
+        /**
+         * Predicate function pointer type, used by removeIf().
+         */
+        typedef bool (*PredicateFunction)(const ValueType&);
+
         /**
          * Creates the cache and sets the pointer to a generator function.
          *
          * @param fn a pointer to a generator function or static class method
+         * @param capacity maximum number of values, 0 means unbounded
+         * @param shardsCount number of independently locked parts
          */
-        Cache(GeneratorFunction fn): generator(fn) {}
+        explicit Cache(GeneratorFunction fn, std::size_t capacity = 0,
+                       unsigned int shardsCount = DEFAULT_CACHE_SHARDS):
+            generator(fn)
+        {
+            if (0 == shardsCount)
+                shardsCount = 1;
+            for (unsigned int i = 0; i < shardsCount; ++i)
+                shards.push_back(new Shard);
+            setCapacity(capacity);
+        }
 
         /**
          * Clears the cache.
-         *
-         * If AQUILA_CACHE_STATS is defined, displays a small cache lookup stats
-         * to stdout.
          */
         ~Cache()
         {
-#ifdef AQUILA_CACHE_STATS
-            std::cout << "[Aquila::Cache] hits/lookups: " << s_cacheHits <<
-                "/" << s_cacheLookups << ", hit rate: " <<
-                100 * s_cacheHits / static_cast<double>(s_cacheLookups) << "%\n";
-#endif
+            for (unsigned int i = 0; i < shards.size(); ++i)
+                delete shards[i];
         }
 
         /**
@@ -85,38 +138,231 @@ namespace Aquila
          * If the value is in cache, it is returned immediately. In other case,
          * the generator function is called with the key as the argument and
          * its return value is stored in cache and returned to the caller.
+         * Exceptions thrown by the generator are passed to the caller and
+         * nothing is stored.
          *
          * @param key cache key
          * @return cache value
          */
         ValueType get(const KeyType& key)
         {
-#ifdef AQUILA_CACHE_STATS
-            s_cacheLookups++;
-#endif
-            if (m_map.find(key) != m_map.end())
+            Shard& shard = getShard(key);
+            {
+                boost::lock_guard<boost::mutex> lock(shard.mutex);
+                typename MapType::iterator it = shard.map.find(key);
+                if (it != shard.map.end())
+                {
+                    ++shard.hits;
+                    shard.lru.splice(shard.lru.begin(), shard.lru,
+                                     it->second.position);
+                    return it->second.value;
+                }
+                ++shard.misses;
+            }
+
+            ValueType value = generator(key);
+
+            boost::lock_guard<boost::mutex> lock(shard.mutex);
+            std::pair<typename MapType::iterator, bool> inserted =
+                shard.map.insert(std::make_pair(key, Entry(value)));
+            if (!inserted.second)
+                return inserted.first->second.value;
+
+            shard.lru.push_front(key);
+            inserted.first->second.position = shard.lru.begin();
+            evict(shard);
+            return value;
+        }
+
+        /**
+         * Removes all values from the cache.
+         */
+        void clear()
+        {
+            for (unsigned int i = 0; i < shards.size(); ++i)
+            {
+                boost::lock_guard<boost::mutex> lock(shards[i]->mutex);
+                shards[i]->map.clear();
+                shards[i]->lru.clear();
+            }
+        }
+
+        /**
+         * Removes values for which the predicate returns true.
+         *
+         * @param predicate function called for each stored value
+         * @return number of removed values
+         */
+        unsigned int removeIf(PredicateFunction predicate)
+        {
+            unsigned int removed = 0;
+            for (unsigned int i = 0; i < shards.size(); ++i)
+            {
+                Shard& shard = *shards[i];
+                boost::lock_guard<boost::mutex> lock(shard.mutex);
+                typename MapType::iterator it = shard.map.begin();
+                while (it != shard.map.end())
+                {
+                    if (predicate(it->second.value))
+                    {
+                        shard.lru.erase(it->second.position);
+                        shard.map.erase(it++);
+                        ++removed;
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+            }
+
+            return removed;
+        }
+
+        /**
+         * Sets the maximum number of stored values.
+         *
+         * The capacity is divided evenly between the shards. When it is
+         * lowered, least recently used values are evicted at once.
+         *
+         * @param capacity maximum number of values, 0 means unbounded
+         */
+        void setCapacity(std::size_t capacity)
+        {
+            const std::size_t count = shards.size();
+            for (unsigned int i = 0; i < count; ++i)
+            {
+                Shard& shard = *shards[i];
+                boost::lock_guard<boost::mutex> lock(shard.mutex);
+                shard.capacity = (capacity + count - 1) / count;
+                evict(shard);
+            }
+        }
+
+        /**
+         * Returns the maximum number of stored values.
+         *
+         * @return capacity rounded up to a multiple of shards count,
+         *         0 if unbounded
+         */
+        std::size_t getCapacity() const
+        {
+            boost::lock_guard<boost::mutex> lock(shards[0]->mutex);
+            return shards[0]->capacity * shards.size();
+        }
+
+        /**
+         * Returns counters of cache activity, summed over all shards.
+         *
+         * @return cache statistics
+         */
+        CacheStats getStats() const
+        {
+            CacheStats stats = {0, 0, 0, 0};
+            for (unsigned int i = 0; i < shards.size(); ++i)
             {
-#ifdef AQUILA_CACHE_STATS
-            s_cacheHits++;
-#endif
-                return m_map[key];
+                const Shard& shard = *shards[i];
+                boost::lock_guard<boost::mutex> lock(shard.mutex);
+                stats.hits += shard.hits;
+                stats.misses += shard.misses;
+                stats.evictions += shard.evictions;
+                stats.size += shard.map.size();
             }
 
-            ValueType result = generator(key);
-            m_map[key] = result;
-            return result;
+            return stats;
+        }
+
+        /**
+         * Sets hit, miss and eviction counters to zero.
+         */
+        void resetStats()
+        {
+            for (unsigned int i = 0; i < shards.size(); ++i)
+            {
+                boost::lock_guard<boost::mutex> lock(shards[i]->mutex);
+                shards[i]->hits = shards[i]->misses = shards[i]->evictions = 0;
+            }
         }
 
     private:
+        /**
+         * Keys ordered from the most to the least recently used.
+         */
+        typedef std::list<KeyType> LruListType;
+
+        /**
+         * A stored value with its position in the LRU list.
+         */
+        struct Entry
+        {
+            explicit Entry(const ValueType& v): value(v) {}
+
+            ValueType value;
+            typename LruListType::iterator position;
+        };
+
+        /**
+         * Internal representation of a shard as a key-value map.
+         */
+        typedef std::map<KeyType, Entry> MapType;
+
+        /**
+         * An independently locked part of the cache.
+         */
+        struct Shard
+        {
+            Shard(): capacity(0), hits(0), misses(0), evictions(0) {}
+
+            mutable boost::mutex mutex;
+            MapType map;
+            LruListType lru;
+            std::size_t capacity;
+            unsigned long hits, misses, evictions;
+        };
+
         /**
          * A pointer to generator function.
          */
         GeneratorFunction generator;
 
         /**
-         * Internal representation of the cache as a key-value map.
+         * Shards of the cache, selected by key hash.
+         */
+        std::vector<Shard*> shards;
+
+        /**
+         * Returns the shard holding a given key.
+         *
+         * @param key cache key
+         * @return reference to the shard
+         */
+        Shard& getShard(const KeyType& key)
+        {
+            return *shards[boost::hash<KeyType>()(key) % shards.size()];
+        }
+
+        /**
+         * Removes least recently used values above the shard capacity.
+         *
+         * The shard must be locked by the caller.
+         *
+         * @param shard the shard
          */
-        std::map<KeyType, ValueType> m_map;
+        void evict(Shard& shard)
+        {
+            if (0 == shard.capacity)
+                return;
+
+            while (shard.map.size() > shard.capacity)
+            {
+                shard.map.erase(shard.lru.back());
+                shard.lru.pop_back();
+                ++shard.evictions;
+            }
+        }
+
+        Cache(const Cache&);
+        Cache& operator=(const Cache&);
     };
 }
 
@@ -0,0 +1,292 @@
+/**
+ * @file Convolution.cpp
+ *
+ * FFT-based convolution and correlation - implementation.
+ *
+ * Filtering a signal of length N with a kernel of length M takes N*M
+ * operations when done directly. The overlap-save method computes it
+ * block by block with FFT, in O(N log M) time, so long FIR filters and
+ * matched filters can be run over whole recordings.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#include "Convolution.h"
+
+#include "Exceptions.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Aquila
+{
+    /**
+     * Creates the convolution object and computes the kernel spectrum.
+     *
+     * @param kernel filter impulse response (or correlation template)
+     * @param mode convolution or correlation
+     * @param fftLength FFT length, a power of 2 not less than kernel length;
+     *                  0 chooses the fastest one
+     * @throw Aquila::Exception when the kernel is empty or FFT length
+     *                          is invalid
+     */
+    Convolution::Convolution(const std::vector<double>& kernel,
+                             ConvolutionMode mode, unsigned int fftLength):
+        M(kernel.size()), L(fftLength)
+    {
+        if (0 == M)
+        {
+            throw Exception("Convolution kernel must not be empty");
+        }
+        if (0 == L)
+        {
+            L = getOptimalFftLength(M);
+        }
+        else if ((L & (L - 1)) != 0 || L < M)
+        {
+            throw Exception("FFT length must be a power of 2 not less than "
+                            "kernel length");
+        }
+
+        plan = FftPlan::get(L);
+        const unsigned int* reversed = plan->getBitReversal();
+
+        // correlation is a convolution with time-reversed kernel
+        kernelRe.assign(L, 0.0);
+        kernelIm.assign(L, 0.0);
+        for (unsigned int i = 0; i < L; ++i)
+        {
+            unsigned int k = reversed[i];
+            if (k < M)
+            {
+                kernelRe[i] = (CORRELATION == mode) ? kernel[M - 1 - k]
+                                                    : kernel[k];
+            }
+        }
+        plan->butterflies(&kernelRe[0], &kernelIm[0]);
+        for (unsigned int i = 0; i < L; ++i)
+        {
+            kernelRe[i] /= L;
+            kernelIm[i] /= L;
+        }
+
+        history.assign(M - 1 + 2 * getBlockLength(), 0.0);
+        re.resize(L);
+        im.resize(L);
+    }
+
+    /**
+     * Forgets previous input, as if the signal started anew.
+     */
+    void Convolution::reset()
+    {
+        std::fill(history.begin(), history.end(), 0.0);
+    }
+
+    /**
+     * Filters next block of the signal.
+     *
+     * @param input new input samples
+     * @param length number of new samples
+     * @param output array of length output samples
+     */
+    void Convolution::process(const double* input, unsigned int length,
+                              double* output)
+    {
+        processSamples(input, length, output);
+    }
+
+    /**
+     * Filters next block of integer samples, such as WaveFile channel data.
+     *
+     * @param input new input samples
+     * @param length number of new samples
+     * @param output array of length output samples
+     */
+    void Convolution::process(const int* input, unsigned int length,
+                              double* output)
+    {
+        processSamples(input, length, output);
+    }
+
+    /**
+     * Filters a whole channel of a recording.
+     *
+     * The channel is processed in blocks, without converting all of it
+     * to doubles first. Previous input is forgotten before filtering.
+     *
+     * @param channel channel data, see WaveFile::getDataVector()
+     * @param output filtered signal, resized to channel length
+     */
+    void Convolution::process(const std::vector<int>& channel,
+                              std::vector<double>& output)
+    {
+        reset();
+        output.resize(channel.size());
+        if (!channel.empty())
+            processSamples(&channel[0], channel.size(), &output[0]);
+    }
+
+    /**
+     * Calculates full linear convolution of two signals.
+     *
+     * @param x first signal
+     * @param h second signal (the kernel), must not be empty
+     * @param y output, resized to x.size() + h.size() - 1 samples
+     */
+    void Convolution::convolve(const std::vector<double>& x,
+                               const std::vector<double>& h,
+                               std::vector<double>& y)
+    {
+        Convolution convolution(h);
+        if (x.empty())
+        {
+            y.clear();
+            return;
+        }
+
+        // after the signal, zeros flush the remaining M-1 samples
+        const unsigned int N = x.size(), M = h.size();
+        y.resize(N + M - 1);
+        convolution.process(&x[0], N, &y[0]);
+        if (M > 1)
+        {
+            std::vector<double> zeros(M - 1, 0.0);
+            convolution.process(&zeros[0], M - 1, &y[N]);
+        }
+    }
+
+    /**
+     * Calculates full cross-correlation of two signals.
+     *
+     * Element r[l + M - 1] is the sum of x[n + l] y[n] over all n,
+     * for lags l from -(M-1) to N-1, where N and M are lengths of x and y.
+     *
+     * @param x first signal
+     * @param y second signal (the template), must not be empty
+     * @param r output, resized to x.size() + y.size() - 1 values
+     */
+    void Convolution::correlate(const std::vector<double>& x,
+                                const std::vector<double>& y,
+                                std::vector<double>& r)
+    {
+        std::vector<double> reversed(y.rbegin(), y.rend());
+        convolve(x, reversed, r);
+    }
+
+    /**
+     * Finds FFT length which gives the lowest cost per output sample.
+     *
+     * A single FFT of length L gives L-M+1 output samples, and costs
+     * about L*log2(L) operations. Very short FFTs produce few samples,
+     * very long ones are slow, the optimum is usually at several times M.
+     *
+     * @param kernelLength kernel length M
+     * @return power of 2 FFT length
+     */
+    unsigned int Convolution::getOptimalFftLength(unsigned int kernelLength)
+    {
+        unsigned int L = 2, log2L = 1;
+        while (L < kernelLength)
+        {
+            L <<= 1;
+            ++log2L;
+        }
+
+        unsigned int best = L;
+        double bestCost = -1.0;
+        for (; log2L <= 22; L <<= 1, ++log2L)
+        {
+            double cost = double(L) * log2L / (L - kernelLength + 1);
+            if (bestCost < 0 || cost < bestCost)
+            {
+                best = L;
+                bestCost = cost;
+            }
+        }
+
+        return best;
+    }
+
+    /**
+     * Filters input samples in pairs of blocks.
+     *
+     * @param input new input samples
+     * @param length number of new samples
+     * @param output array of length output samples
+     */
+    template <typename T>
+    void Convolution::processSamples(const T* input, unsigned int length,
+                                     double* output)
+    {
+        const unsigned int B = getBlockLength();
+        while (length > 0)
+        {
+            unsigned int n1 = std::min(B, length);
+            unsigned int n2 = std::min(B, length - n1);
+            std::copy(input, input + n1 + n2, history.begin() + (M - 1));
+            filterBlocks(n1, n2, output);
+
+            input += n1 + n2;
+            output += n1 + n2;
+            length -= n1 + n2;
+        }
+    }
+
+    /**
+     * Filters one or two blocks stored in history by overlap-save method.
+     *
+     * The first block (with M-1 preceding samples) is the real part
+     * of the transformed signal, the second one is its imaginary part.
+     * Both are zero-padded to FFT length. The first M-1 samples of
+     * the circular convolution are wrapped around and discarded.
+     *
+     * @param n1 number of new samples in the first block
+     * @param n2 number of new samples in the second block (may be 0)
+     * @param output array of n1+n2 output samples
+     */
+    void Convolution::filterBlocks(unsigned int n1, unsigned int n2,
+                                   double* output)
+    {
+        const unsigned int H = M - 1;
+        const unsigned int* reversed = plan->getBitReversal();
+        const double* first = &history[0];
+        const double* second = first + n1;
+        for (unsigned int i = 0; i < L; ++i)
+        {
+            unsigned int j = reversed[i];
+            re[i] = (j < H + n1) ? first[j] : 0.0;
+            im[i] = (j < H + n2) ? second[j] : 0.0;
+        }
+        plan->butterflies(&re[0], &im[0]);
+
+        for (unsigned int i = 0; i < L; ++i)
+        {
+            double r = re[i] * kernelRe[i] - im[i] * kernelIm[i];
+            im[i] = re[i] * kernelIm[i] + im[i] * kernelRe[i];
+            re[i] = r;
+        }
+
+        // inverse transform: bit-reversal and forward butterflies
+        // with swapped real and imaginary parts
+        for (unsigned int i = 0; i < L; ++i)
+        {
+            unsigned int j = reversed[i];
+            if (i < j)
+            {
+                std::swap(re[i], re[j]);
+                std::swap(im[i], im[j]);
+            }
+        }
+        plan->butterflies(&im[0], &re[0]);
+
+        std::copy(&re[H], &re[H] + n1, output);
+        std::copy(&im[H], &im[H] + n2, output + n1);
+
+        // keep M-1 last samples for the next blocks
+        std::copy(history.begin() + (n1 + n2),
+                  history.begin() + (n1 + n2 + H), history.begin());
+    }
+}
@@ -0,0 +1,132 @@
+/**
+ * @file Convolution.h
+ *
+ * FFT-based convolution and correlation - header.
+ *
+ * Filtering a signal of length N with a kernel of length M takes N*M
+ * operations when done directly. The overlap-save method computes it
+ * block by block with FFT, in O(N log M) time, so long FIR filters and
+ * matched filters can be run over whole recordings.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#ifndef CONVOLUTION_H
+#define CONVOLUTION_H
+
+#include "global.h"
+#include "AlignedAllocator.h"
+#include "FftPlan.h"
+#include <vector>
+
+namespace Aquila
+{
+    /**
+     * What the Convolution object computes.
+     */
+    enum ConvolutionMode { CONVOLUTION, CORRELATION };
+
+
+    /**
+     * A streaming FFT convolution (or correlation) with a fixed kernel.
+     *
+     * The signal is fed in blocks of any length by calls to process(),
+     * and the object keeps the last M-1 samples between the calls, so the
+     * output is the same as if the whole signal was filtered at once.
+     * Each output sample depends only on the current and past input
+     * samples:
+     *
+     * - in CONVOLUTION mode y[n] = sum h[k] x[n-k], k < M,
+     * - in CORRELATION mode y[n] = sum h[k] x[n-M+1+k], k < M, that is
+     *   the correlation of the kernel with M samples ending at n.
+     *
+     * Each FFT computes two blocks at once, one as the real part and the
+     * other as the imaginary part of the signal, as the kernel is real.
+     */
+    class AQUILA_EXPORT Convolution
+    {
+    public:
+        explicit Convolution(const std::vector<double>& kernel,
+                             ConvolutionMode mode = CONVOLUTION,
+                             unsigned int fftLength = 0);
+
+        /**
+         * Returns the kernel length.
+         *
+         * @return number of kernel samples
+         */
+        unsigned int getKernelLength() const { return M; }
+
+        /**
+         * Returns the FFT length used by the overlap-save method.
+         *
+         * @return FFT length, a power of 2
+         */
+        unsigned int getFftLength() const { return L; }
+
+        /**
+         * Returns number of new samples filtered by a single FFT.
+         *
+         * @return FFT length - kernel length + 1
+         */
+        unsigned int getBlockLength() const { return L - M + 1; }
+
+        void reset();
+
+        void process(const double* input, unsigned int length, double* output);
+        void process(const int* input, unsigned int length, double* output);
+        void process(const std::vector<int>& channel,
+                     std::vector<double>& output);
+
+        static void convolve(const std::vector<double>& x,
+                             const std::vector<double>& h,
+                             std::vector<double>& y);
+        static void correlate(const std::vector<double>& x,
+                              const std::vector<double>& y,
+                              std::vector<double>& r);
+
+        static unsigned int getOptimalFftLength(unsigned int kernelLength);
+
+    private:
+        /**
+         * Kernel length.
+         */
+        unsigned int M;
+
+        /**
+         * FFT length.
+         */
+        unsigned int L;
+
+        /**
+         * Shared plan of the FFT.
+         */
+        FftPlan::PointerType plan;
+
+        /**
+         * Kernel spectrum divided by L, real and imaginary parts.
+         */
+        alignedVectorType kernelRe, kernelIm;
+
+        /**
+         * Last M-1 input samples, followed by the samples of current blocks.
+         */
+        std::vector<double> history;
+
+        /**
+         * Work buffers for the transform.
+         */
+        alignedVectorType re, im;
+
+        template <typename T>
+        void processSamples(const T* input, unsigned int length,
+                            double* output);
+
+        void filterBlocks(unsigned int n1, unsigned int n2, double* output);
+    };
+}
+
+#endif // CONVOLUTION_H
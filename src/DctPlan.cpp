@@ -0,0 +1,176 @@
+/**
+ * @file DctPlan.cpp
+ *
+ * Precomputed DCT plans - implementation.
+ *
+ * A plan holds everything that depends only on the transform size:
+ * either the matrix of scaled cosines, used by the direct algorithm,
+ * or the twiddle factors of the FFT-based one. Plans are immutable once
+ * created and shared through a process-wide registry, so that the tables
+ * are not rebuilt for every Transform object.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#include "DctPlan.h"
+
+#include "Exceptions.h"
+#include "FftKernels.h"
+#include "PrecomputedTables.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Aquila
+{
+    /**
+     * DCT is computed by FFT when more coefficients than this number
+     * times FFT stages are requested.
+     */
+    static const unsigned int DCT_FFT_COST_FACTOR = 3;
+
+    /**
+     * Creates a plan for the registry.
+     *
+     * @param key transform length and number of coefficients
+     * @return shared pointer to new plan
+     */
+    static DctPlan::PointerType createPlan(const DctPlan::KeyType& key)
+    {
+        return DctPlan::PointerType(new DctPlan(key.first, key.second));
+    }
+
+    /**
+     * Checks if a plan is held only by the registry.
+     *
+     * @param plan registered plan
+     * @return true if nobody else uses the plan
+     */
+    static bool isUnused(const DctPlan::PointerType& plan)
+    {
+        return plan.unique();
+    }
+
+    /**
+     * Registry of all plans created so far, keyed by input and output length.
+     */
+    static DctPlan::CacheType s_plans(&createPlan);
+
+    /**
+     * Builds a plan for a given transform size.
+     *
+     * @param inputLength transform length N
+     * @param outputLength number of coefficients K
+     * @throw Aquila::Exception when any of the lengths is 0
+     */
+    DctPlan::DctPlan(unsigned int inputLength, unsigned int outputLength):
+        N(inputLength), K(outputLength), stride(0), fast(false)
+    {
+        if (0 == N || 0 == K)
+            throw Exception("DCT lengths must be greater than 0");
+
+        const unsigned int multiple = MATRIX_STRIDE_MULTIPLE;
+        stride = (N + multiple - 1) / multiple * multiple;
+        fast = isFastSize(N, K);
+
+        if (fast)
+        {
+            twiddles.resize(N);
+            for (unsigned int k = 0; k < N; ++k)
+            {
+                twiddles[k] = std::polar(1.0, -M_PI * k / (2.0 * N));
+            }
+            return;
+        }
+
+        const double* precomputed =
+            PrecomputedTables::findDctCosines(N, K, stride);
+        if (precomputed)
+        {
+            cosines.assign(precomputed, precomputed + K * stride);
+            return;
+        }
+
+        // DCT scaling factor
+        const double c0 = std::sqrt(1.0 / N);
+        const double cn = std::sqrt(2.0 / N);
+        cosines.assign(K * stride, 0.0);
+        for (unsigned int k = 0; k < K; ++k)
+        {
+            const double c = (0 == k) ? c0 : cn;
+            for (unsigned int n = 0; n < N; ++n)
+            {
+                // from the definition of DCT
+                cosines[k * stride + n] = c * std::cos((M_PI * (2*n+1) * k) /
+                                                       (2 * N));
+            }
+        }
+    }
+
+    /**
+     * Returns a shared plan of the given size.
+     *
+     * The plan is created on first request and then kept in the registry.
+     * This method can be safely called from many threads. When the
+     * registry is bounded, plans evicted from it live on as long as they
+     * are used.
+     *
+     * @param inputLength transform length N
+     * @param outputLength number of coefficients K
+     * @return shared pointer to immutable plan
+     * @throw Aquila::Exception when any of the lengths is 0
+     */
+    DctPlan::PointerType DctPlan::get(unsigned int inputLength,
+                                      unsigned int outputLength)
+    {
+        return s_plans.get(KeyType(inputLength, outputLength));
+    }
+
+    /**
+     * Removes plans which are not used outside the registry.
+     *
+     * Plans still held by Transform objects stay in the registry.
+     *
+     * @return number of removed plans
+     */
+    unsigned int DctPlan::releaseUnused()
+    {
+        return s_plans.removeIf(&isUnused);
+    }
+
+    /**
+     * Returns the registry, eg. to read its statistics or bound its size.
+     *
+     * @return reference to the plan cache
+     */
+    DctPlan::CacheType& DctPlan::getCache()
+    {
+        return s_plans;
+    }
+
+    /**
+     * Checks whether DCT of given size is faster when computed by FFT.
+     *
+     * The direct method takes N*K multiply-adds, FFT-based one takes
+     * a fixed amount of work per sample and per FFT stage. FFT gives only
+     * N coefficients, so more of them are always computed directly.
+     *
+     * @param inputLength transform length N
+     * @param outputLength number of coefficients K
+     * @return true if FFT-based algorithm should be used
+     */
+    bool DctPlan::isFastSize(unsigned int inputLength,
+                             unsigned int outputLength)
+    {
+        if (outputLength > inputLength)
+            return false;
+
+        unsigned int log2N = 0;
+        while ((1u << log2N) < inputLength)
+            ++log2N;
+
+        return outputLength > DCT_FFT_COST_FACTOR * (log2N + 1);
+    }
+}
@@ -0,0 +1,149 @@
+/**
+ * @file DctPlan.h
+ *
+ * Precomputed DCT plans - header.
+ *
+ * A plan holds everything that depends only on the transform size:
+ * either the matrix of scaled cosines, used by the direct algorithm,
+ * or the twiddle factors of the FFT-based one. Plans are immutable once
+ * created and shared through a process-wide registry, so that the tables
+ * are not rebuilt for every Transform object.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#ifndef DCTPLAN_H
+#define DCTPLAN_H
+
+#include "global.h"
+#include "AlignedAllocator.h"
+#include "Cache.h"
+#include <utility>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+namespace Aquila
+{
+    /**
+     * An immutable, precomputed orthonormal DCT of a given size.
+     *
+     * The size is made of the transform length N and the number of
+     * coefficients K. Short transforms, or just a few coefficients, are
+     * computed directly from a K x N cosine matrix, others through FFT.
+     *
+     * Plans should be obtained through DctPlan::get(). The registry keeps
+     * plans until they are released by releaseUnused().
+     */
+    class AQUILA_EXPORT DctPlan
+    {
+    public:
+        /**
+         * Shared pointer to a plan, as returned from the registry.
+         */
+        typedef boost::shared_ptr<const DctPlan> PointerType;
+
+        /**
+         * Registry key - input and output length.
+         */
+        typedef std::pair<unsigned int, unsigned int> KeyType;
+
+        /**
+         * Type of the plan registry.
+         */
+        typedef Cache<KeyType, PointerType> CacheType;
+
+        DctPlan(unsigned int inputLength, unsigned int outputLength);
+
+        static PointerType get(unsigned int inputLength,
+                               unsigned int outputLength);
+
+        static unsigned int releaseUnused();
+
+        static CacheType& getCache();
+
+        /**
+         * Returns the transform length.
+         *
+         * @return N - number of signal samples
+         */
+        unsigned int getInputLength() const { return N; }
+
+        /**
+         * Returns the number of coefficients.
+         *
+         * @return K - number of DCT coefficients
+         */
+        unsigned int getOutputLength() const { return K; }
+
+        /**
+         * Checks if the transform is computed through FFT.
+         *
+         * @return true when twiddles are available, false for cosines
+         */
+        bool isFast() const { return fast; }
+
+        /**
+         * Returns length of a cosine matrix row.
+         *
+         * @return N rounded up to a multiple of MATRIX_STRIDE_MULTIPLE
+         */
+        unsigned int getStride() const { return stride; }
+
+        /**
+         * Returns the matrix of the direct algorithm.
+         *
+         * Row k holds cosines of coefficient k, multiplied by the DCT
+         * scaling factor and padded with zeros to getStride() values.
+         *
+         * @return pointer to K matrix rows, or 0 for FFT-based plans
+         */
+        const double* getCosines() const
+        {
+            return cosines.empty() ? 0 : &cosines[0];
+        }
+
+        /**
+         * Returns twiddle factors exp(-j*pi*k/2N) of the FFT-based algorithm.
+         *
+         * @return pointer to N factors, or 0 for direct plans
+         */
+        const cplx* getTwiddles() const
+        {
+            return twiddles.empty() ? 0 : &twiddles[0];
+        }
+
+    private:
+        /**
+         * Transform length and number of coefficients.
+         */
+        unsigned int N, K;
+
+        /**
+         * Padded length of matrix rows.
+         */
+        unsigned int stride;
+
+        /**
+         * Whether the transform is computed through FFT.
+         */
+        bool fast;
+
+        /**
+         * Scaled cosines, K rows of stride values.
+         */
+        alignedVectorType cosines;
+
+        /**
+         * Twiddle factors of the FFT-based algorithm.
+         */
+        std::vector<cplx> twiddles;
+
+        static bool isFastSize(unsigned int inputLength,
+                               unsigned int outputLength);
+    };
+}
+
+#endif // DCTPLAN_H
@@ -0,0 +1,1238 @@
+/**
+ * @file FftKernels.cpp
+ *
+ * Vectorized FFT kernels with runtime dispatch - implementation.
+ *
+ * Kernels work on split complex data: real and imaginary parts are kept
+ * in two separate arrays, so that a SIMD register holds several real (or
+ * imaginary) parts and no shuffling is needed. Every kernel is compiled
+ * for a few instruction sets, and the best one supported by the processor
+ * is chosen at runtime, so that a single binary runs everywhere.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#include "FftKernels.h"
+
+#include <cstring>
+
+// target-specific functions need GCC 4.9 or Clang on x86
+#if !defined(AQUILA_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || (defined(__GNUC__) && \
+    (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define AQUILA_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace Aquila
+{
+    /**
+     * Radix-4 stage, plain C++ version.
+     *
+     * Each block of length 4m is made of four sub-transforms of bit-reversed
+     * data - A, B, C, D - which are transforms of every fourth sample
+     * starting from 0, 2, 1 and 3. They are combined as
+     * X[p + q*m] = A[p] + W^2p B[p] + W^p C[p] + W^3p D[p], q = 0..3.
+     *
+     * @param re real parts
+     * @param im imaginary parts
+     * @param N transform length
+     * @param m length of combined sub-transforms
+     * @param tw twiddle factors: m values each of Re W^p, Im W^p, Re W^2p,
+     *           Im W^2p, Re W^3p, Im W^3p
+     */
+    static void radix4Scalar(double* re, double* im, unsigned int N,
+                             unsigned int m, const double* tw)
+    {
+        const double *w1r = tw, *w1i = tw + m, *w2r = tw + 2*m,
+                     *w2i = tw + 3*m, *w3r = tw + 4*m, *w3i = tw + 5*m;
+
+        for (unsigned int block = 0; block < N; block += 4 * m)
+        {
+            double *ar = re + block, *br = ar + m, *cr = br + m, *dr = cr + m;
+            double *ai = im + block, *bi = ai + m, *ci = bi + m, *di = ci + m;
+
+            for (unsigned int p = 0; p < m; ++p)
+            {
+                double bR = br[p] * w2r[p] - bi[p] * w2i[p];
+                double bI = br[p] * w2i[p] + bi[p] * w2r[p];
+                double cR = cr[p] * w1r[p] - ci[p] * w1i[p];
+                double cI = cr[p] * w1i[p] + ci[p] * w1r[p];
+                double dR = dr[p] * w3r[p] - di[p] * w3i[p];
+                double dI = dr[p] * w3i[p] + di[p] * w3r[p];
+
+                double t0r = ar[p] + bR, t0i = ai[p] + bI;
+                double t1r = ar[p] - bR, t1i = ai[p] - bI;
+                double t2r = cR + dR, t2i = cI + dI;
+                double t3r = cR - dR, t3i = cI - dI;
+
+                ar[p] = t0r + t2r; ai[p] = t0i + t2i;
+                cr[p] = t0r - t2r; ci[p] = t0i - t2i;
+                // t1 -/+ j t3
+                br[p] = t1r + t3i; bi[p] = t1i - t3r;
+                dr[p] = t1r - t3i; di[p] = t1i + t3r;
+            }
+        }
+    }
+
+    /**
+     * Radix-4 stage with all twiddle factors equal to 1 (m = 1).
+     */
+    static void radix4Trivial(double* re, double* im, unsigned int N)
+    {
+        for (unsigned int i = 0; i < N; i += 4)
+        {
+            double t0r = re[i] + re[i+1], t0i = im[i] + im[i+1];
+            double t1r = re[i] - re[i+1], t1i = im[i] - im[i+1];
+            double t2r = re[i+2] + re[i+3], t2i = im[i+2] + im[i+3];
+            double t3r = re[i+2] - re[i+3], t3i = im[i+2] - im[i+3];
+
+            re[i] = t0r + t2r; im[i] = t0i + t2i;
+            re[i+2] = t0r - t2r; im[i+2] = t0i - t2i;
+            re[i+1] = t1r + t3i; im[i+1] = t1i - t3r;
+            re[i+3] = t1r - t3i; im[i+3] = t1i + t3r;
+        }
+    }
+
+    /**
+     * Radix-4 stage over a batch of interleaved transforms, plain C++.
+     *
+     * Value i of transform b is stored at index i*batch + b, so the inner
+     * loop runs over the batch with the same twiddle factor, which is loaded
+     * only once for all transforms.
+     *
+     * @param re real parts
+     * @param im imaginary parts
+     * @param N transform length
+     * @param m length of combined sub-transforms
+     * @param tw twiddle factors, as in radix4Scalar()
+     * @param batch number of interleaved transforms
+     */
+    static void radix4BatchScalar(double* re, double* im, unsigned int N,
+                                  unsigned int m, const double* tw,
+                                  unsigned int batch)
+    {
+        const unsigned int mb = m * batch;
+        for (unsigned int block = 0; block < N * batch; block += 4 * mb)
+        {
+            double *ar = re + block, *br = ar + mb, *cr = br + mb, *dr = cr + mb;
+            double *ai = im + block, *bi = ai + mb, *ci = bi + mb, *di = ci + mb;
+
+            for (unsigned int p = 0; p < m; ++p)
+            {
+                const double w1r = tw[p], w1i = tw[m + p], w2r = tw[2*m + p],
+                             w2i = tw[3*m + p], w3r = tw[4*m + p],
+                             w3i = tw[5*m + p];
+
+                for (unsigned int i = p * batch; i < (p + 1) * batch; ++i)
+                {
+                    double bR = br[i] * w2r - bi[i] * w2i;
+                    double bI = br[i] * w2i + bi[i] * w2r;
+                    double cR = cr[i] * w1r - ci[i] * w1i;
+                    double cI = cr[i] * w1i + ci[i] * w1r;
+                    double dR = dr[i] * w3r - di[i] * w3i;
+                    double dI = dr[i] * w3i + di[i] * w3r;
+
+                    double t0r = ar[i] + bR, t0i = ai[i] + bI;
+                    double t1r = ar[i] - bR, t1i = ai[i] - bI;
+                    double t2r = cR + dR, t2i = cI + dI;
+                    double t3r = cR - dR, t3i = cI - dI;
+
+                    ar[i] = t0r + t2r; ai[i] = t0i + t2i;
+                    cr[i] = t0r - t2r; ci[i] = t0i - t2i;
+                    br[i] = t1r + t3i; bi[i] = t1i - t3r;
+                    dr[i] = t1r - t3i; di[i] = t1i + t3r;
+                }
+            }
+        }
+    }
+
+    /**
+     * Matrix product, plain C++ version.
+     *
+     * Four partial sums break the dependency chain of a single sum.
+     *
+     * @param a matrix of rows x stride values, row by row
+     * @param rows number of matrix rows
+     * @param stride row length, a multiple of MATRIX_STRIDE_MULTIPLE
+     * @param x count vectors of stride values
+     * @param count number of vectors
+     * @param y count x rows products, vector by vector
+     */
+    static void matrixProductScalar(const double* a, unsigned int rows,
+                                    unsigned int stride, const double* x,
+                                    unsigned int count, double* y)
+    {
+        for (unsigned int n = 0; n < rows; ++n)
+        {
+            const double* row = a + n * stride;
+            for (unsigned int f = 0; f < count; ++f)
+            {
+                const double* v = x + f * stride;
+                double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+                for (unsigned int k = 0; k < stride; k += 4)
+                {
+                    s0 += row[k] * v[k];
+                    s1 += row[k + 1] * v[k + 1];
+                    s2 += row[k + 2] * v[k + 2];
+                    s3 += row[k + 3] * v[k + 3];
+                }
+                y[f * rows + n] = (s0 + s1) + (s2 + s3);
+            }
+        }
+    }
+
+    /**
+     * Preemphasis and windowing, plain C++ version.
+     *
+     * @param x count samples, preceded by one more sample
+     * @param count number of output values
+     * @param a preemphasis factor
+     * @param w count window values
+     * @param y count output values
+     */
+    template <typename T>
+    static void windowScalar(const T* x, unsigned int count, double a,
+                             const double* w, double* y)
+    {
+        const T* previous = x - 1;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            y[i] = (x[i] - a * previous[i]) * w[i];
+        }
+    }
+
+    /**
+     * Sum of squares of samples, plain C++ version.
+     *
+     * @param x count samples
+     * @param count number of samples
+     * @return sum of squared samples
+     */
+    static double squaresScalar(const int* x, unsigned int count)
+    {
+        double sum = 0.0;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            sum += static_cast<double>(x[i]) * x[i];
+        }
+        return sum;
+    }
+
+    /**
+     * Sum of squares of 16-bit samples, plain C++ version.
+     *
+     * Squares of 16-bit samples are summed exactly as 64-bit integers.
+     *
+     * @param x count samples
+     * @param count number of samples
+     * @return sum of squared samples
+     */
+    static double squares16Scalar(const boost::int16_t* x, unsigned int count)
+    {
+        boost::uint64_t sum = 0;
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            sum += static_cast<boost::uint32_t>(x[i] * x[i]);
+        }
+        return static_cast<double>(sum);
+    }
+
+#ifdef AQUILA_X86_SIMD
+    /**
+     * Radix-4 stage, SSE2 version (2 doubles at once, m must be even).
+     */
+    __attribute__((target("sse2")))
+    static void radix4Sse2(double* re, double* im, unsigned int N,
+                           unsigned int m, const double* tw)
+    {
+        const double *w1r = tw, *w1i = tw + m, *w2r = tw + 2*m,
+                     *w2i = tw + 3*m, *w3r = tw + 4*m, *w3i = tw + 5*m;
+
+        for (unsigned int block = 0; block < N; block += 4 * m)
+        {
+            double *ar = re + block, *br = ar + m, *cr = br + m, *dr = cr + m;
+            double *ai = im + block, *bi = ai + m, *ci = bi + m, *di = ci + m;
+
+            for (unsigned int p = 0; p < m; p += 2)
+            {
+                __m128d Br = _mm_loadu_pd(br + p), Bi = _mm_loadu_pd(bi + p);
+                __m128d Cr = _mm_loadu_pd(cr + p), Ci = _mm_loadu_pd(ci + p);
+                __m128d Dr = _mm_loadu_pd(dr + p), Di = _mm_loadu_pd(di + p);
+                __m128d W1r = _mm_loadu_pd(w1r + p), W1i = _mm_loadu_pd(w1i + p);
+                __m128d W2r = _mm_loadu_pd(w2r + p), W2i = _mm_loadu_pd(w2i + p);
+                __m128d W3r = _mm_loadu_pd(w3r + p), W3i = _mm_loadu_pd(w3i + p);
+
+                __m128d bR = _mm_sub_pd(_mm_mul_pd(Br, W2r), _mm_mul_pd(Bi, W2i));
+                __m128d bI = _mm_add_pd(_mm_mul_pd(Br, W2i), _mm_mul_pd(Bi, W2r));
+                __m128d cR = _mm_sub_pd(_mm_mul_pd(Cr, W1r), _mm_mul_pd(Ci, W1i));
+                __m128d cI = _mm_add_pd(_mm_mul_pd(Cr, W1i), _mm_mul_pd(Ci, W1r));
+                __m128d dR = _mm_sub_pd(_mm_mul_pd(Dr, W3r), _mm_mul_pd(Di, W3i));
+                __m128d dI = _mm_add_pd(_mm_mul_pd(Dr, W3i), _mm_mul_pd(Di, W3r));
+
+                __m128d Ar = _mm_loadu_pd(ar + p), Ai = _mm_loadu_pd(ai + p);
+                __m128d t0r = _mm_add_pd(Ar, bR), t0i = _mm_add_pd(Ai, bI);
+                __m128d t1r = _mm_sub_pd(Ar, bR), t1i = _mm_sub_pd(Ai, bI);
+                __m128d t2r = _mm_add_pd(cR, dR), t2i = _mm_add_pd(cI, dI);
+                __m128d t3r = _mm_sub_pd(cR, dR), t3i = _mm_sub_pd(cI, dI);
+
+                _mm_storeu_pd(ar + p, _mm_add_pd(t0r, t2r));
+                _mm_storeu_pd(ai + p, _mm_add_pd(t0i, t2i));
+                _mm_storeu_pd(cr + p, _mm_sub_pd(t0r, t2r));
+                _mm_storeu_pd(ci + p, _mm_sub_pd(t0i, t2i));
+                _mm_storeu_pd(br + p, _mm_add_pd(t1r, t3i));
+                _mm_storeu_pd(bi + p, _mm_sub_pd(t1i, t3r));
+                _mm_storeu_pd(dr + p, _mm_sub_pd(t1r, t3i));
+                _mm_storeu_pd(di + p, _mm_add_pd(t1i, t3r));
+            }
+        }
+    }
+
+    /**
+     * Radix-4 stage, AVX2 + FMA version (4 doubles at once, m % 4 == 0).
+     */
+    __attribute__((target("avx2,fma")))
+    static void radix4Avx2(double* re, double* im, unsigned int N,
+                           unsigned int m, const double* tw)
+    {
+        const double *w1r = tw, *w1i = tw + m, *w2r = tw + 2*m,
+                     *w2i = tw + 3*m, *w3r = tw + 4*m, *w3i = tw + 5*m;
+
+        for (unsigned int block = 0; block < N; block += 4 * m)
+        {
+            double *ar = re + block, *br = ar + m, *cr = br + m, *dr = cr + m;
+            double *ai = im + block, *bi = ai + m, *ci = bi + m, *di = ci + m;
+
+            for (unsigned int p = 0; p < m; p += 4)
+            {
+                __m256d Br = _mm256_loadu_pd(br + p), Bi = _mm256_loadu_pd(bi + p);
+                __m256d Cr = _mm256_loadu_pd(cr + p), Ci = _mm256_loadu_pd(ci + p);
+                __m256d Dr = _mm256_loadu_pd(dr + p), Di = _mm256_loadu_pd(di + p);
+                __m256d W1r = _mm256_loadu_pd(w1r + p), W1i = _mm256_loadu_pd(w1i + p);
+                __m256d W2r = _mm256_loadu_pd(w2r + p), W2i = _mm256_loadu_pd(w2i + p);
+                __m256d W3r = _mm256_loadu_pd(w3r + p), W3i = _mm256_loadu_pd(w3i + p);
+
+                __m256d bR = _mm256_fmsub_pd(Br, W2r, _mm256_mul_pd(Bi, W2i));
+                __m256d bI = _mm256_fmadd_pd(Br, W2i, _mm256_mul_pd(Bi, W2r));
+                __m256d cR = _mm256_fmsub_pd(Cr, W1r, _mm256_mul_pd(Ci, W1i));
+                __m256d cI = _mm256_fmadd_pd(Cr, W1i, _mm256_mul_pd(Ci, W1r));
+                __m256d dR = _mm256_fmsub_pd(Dr, W3r, _mm256_mul_pd(Di, W3i));
+                __m256d dI = _mm256_fmadd_pd(Dr, W3i, _mm256_mul_pd(Di, W3r));
+
+                __m256d Ar = _mm256_loadu_pd(ar + p), Ai = _mm256_loadu_pd(ai + p);
+                __m256d t0r = _mm256_add_pd(Ar, bR), t0i = _mm256_add_pd(Ai, bI);
+                __m256d t1r = _mm256_sub_pd(Ar, bR), t1i = _mm256_sub_pd(Ai, bI);
+                __m256d t2r = _mm256_add_pd(cR, dR), t2i = _mm256_add_pd(cI, dI);
+                __m256d t3r = _mm256_sub_pd(cR, dR), t3i = _mm256_sub_pd(cI, dI);
+
+                _mm256_storeu_pd(ar + p, _mm256_add_pd(t0r, t2r));
+                _mm256_storeu_pd(ai + p, _mm256_add_pd(t0i, t2i));
+                _mm256_storeu_pd(cr + p, _mm256_sub_pd(t0r, t2r));
+                _mm256_storeu_pd(ci + p, _mm256_sub_pd(t0i, t2i));
+                _mm256_storeu_pd(br + p, _mm256_add_pd(t1r, t3i));
+                _mm256_storeu_pd(bi + p, _mm256_sub_pd(t1i, t3r));
+                _mm256_storeu_pd(dr + p, _mm256_sub_pd(t1r, t3i));
+                _mm256_storeu_pd(di + p, _mm256_add_pd(t1i, t3r));
+            }
+        }
+    }
+
+    /**
+     * Radix-4 stage, AVX-512 version (8 doubles at once, m % 8 == 0).
+     */
+    __attribute__((target("avx512f")))
+    static void radix4Avx512(double* re, double* im, unsigned int N,
+                             unsigned int m, const double* tw)
+    {
+        const double *w1r = tw, *w1i = tw + m, *w2r = tw + 2*m,
+                     *w2i = tw + 3*m, *w3r = tw + 4*m, *w3i = tw + 5*m;
+
+        for (unsigned int block = 0; block < N; block += 4 * m)
+        {
+            double *ar = re + block, *br = ar + m, *cr = br + m, *dr = cr + m;
+            double *ai = im + block, *bi = ai + m, *ci = bi + m, *di = ci + m;
+
+            for (unsigned int p = 0; p < m; p += 8)
+            {
+                __m512d Br = _mm512_loadu_pd(br + p), Bi = _mm512_loadu_pd(bi + p);
+                __m512d Cr = _mm512_loadu_pd(cr + p), Ci = _mm512_loadu_pd(ci + p);
+                __m512d Dr = _mm512_loadu_pd(dr + p), Di = _mm512_loadu_pd(di + p);
+                __m512d W1r = _mm512_loadu_pd(w1r + p), W1i = _mm512_loadu_pd(w1i + p);
+                __m512d W2r = _mm512_loadu_pd(w2r + p), W2i = _mm512_loadu_pd(w2i + p);
+                __m512d W3r = _mm512_loadu_pd(w3r + p), W3i = _mm512_loadu_pd(w3i + p);
+
+                __m512d bR = _mm512_fmsub_pd(Br, W2r, _mm512_mul_pd(Bi, W2i));
+                __m512d bI = _mm512_fmadd_pd(Br, W2i, _mm512_mul_pd(Bi, W2r));
+                __m512d cR = _mm512_fmsub_pd(Cr, W1r, _mm512_mul_pd(Ci, W1i));
+                __m512d cI = _mm512_fmadd_pd(Cr, W1i, _mm512_mul_pd(Ci, W1r));
+                __m512d dR = _mm512_fmsub_pd(Dr, W3r, _mm512_mul_pd(Di, W3i));
+                __m512d dI = _mm512_fmadd_pd(Dr, W3i, _mm512_mul_pd(Di, W3r));
+
+                __m512d Ar = _mm512_loadu_pd(ar + p), Ai = _mm512_loadu_pd(ai + p);
+                __m512d t0r = _mm512_add_pd(Ar, bR), t0i = _mm512_add_pd(Ai, bI);
+                __m512d t1r = _mm512_sub_pd(Ar, bR), t1i = _mm512_sub_pd(Ai, bI);
+                __m512d t2r = _mm512_add_pd(cR, dR), t2i = _mm512_add_pd(cI, dI);
+                __m512d t3r = _mm512_sub_pd(cR, dR), t3i = _mm512_sub_pd(cI, dI);
+
+                _mm512_storeu_pd(ar + p, _mm512_add_pd(t0r, t2r));
+                _mm512_storeu_pd(ai + p, _mm512_add_pd(t0i, t2i));
+                _mm512_storeu_pd(cr + p, _mm512_sub_pd(t0r, t2r));
+                _mm512_storeu_pd(ci + p, _mm512_sub_pd(t0i, t2i));
+                _mm512_storeu_pd(br + p, _mm512_add_pd(t1r, t3i));
+                _mm512_storeu_pd(bi + p, _mm512_sub_pd(t1i, t3r));
+                _mm512_storeu_pd(dr + p, _mm512_sub_pd(t1r, t3i));
+                _mm512_storeu_pd(di + p, _mm512_add_pd(t1i, t3r));
+            }
+        }
+    }
+
+    /**
+     * Radix-4 batch stage, SSE2 version (batch must be even).
+     */
+    __attribute__((target("sse2")))
+    static void radix4BatchSse2(double* re, double* im, unsigned int N,
+                                unsigned int m, const double* tw,
+                                unsigned int batch)
+    {
+        const unsigned int mb = m * batch;
+        for (unsigned int block = 0; block < N * batch; block += 4 * mb)
+        {
+            double *ar = re + block, *br = ar + mb, *cr = br + mb, *dr = cr + mb;
+            double *ai = im + block, *bi = ai + mb, *ci = bi + mb, *di = ci + mb;
+
+            for (unsigned int p = 0; p < m; ++p)
+            {
+                __m128d W1r = _mm_set1_pd(tw[p]), W1i = _mm_set1_pd(tw[m + p]);
+                __m128d W2r = _mm_set1_pd(tw[2*m + p]), W2i = _mm_set1_pd(tw[3*m + p]);
+                __m128d W3r = _mm_set1_pd(tw[4*m + p]), W3i = _mm_set1_pd(tw[5*m + p]);
+
+                for (unsigned int i = p * batch; i < (p + 1) * batch; i += 2)
+                {
+                    __m128d Br = _mm_loadu_pd(br + i), Bi = _mm_loadu_pd(bi + i);
+                    __m128d Cr = _mm_loadu_pd(cr + i), Ci = _mm_loadu_pd(ci + i);
+                    __m128d Dr = _mm_loadu_pd(dr + i), Di = _mm_loadu_pd(di + i);
+
+                    __m128d bR = _mm_sub_pd(_mm_mul_pd(Br, W2r), _mm_mul_pd(Bi, W2i));
+                    __m128d bI = _mm_add_pd(_mm_mul_pd(Br, W2i), _mm_mul_pd(Bi, W2r));
+                    __m128d cR = _mm_sub_pd(_mm_mul_pd(Cr, W1r), _mm_mul_pd(Ci, W1i));
+                    __m128d cI = _mm_add_pd(_mm_mul_pd(Cr, W1i), _mm_mul_pd(Ci, W1r));
+                    __m128d dR = _mm_sub_pd(_mm_mul_pd(Dr, W3r), _mm_mul_pd(Di, W3i));
+                    __m128d dI = _mm_add_pd(_mm_mul_pd(Dr, W3i), _mm_mul_pd(Di, W3r));
+
+                    __m128d Ar = _mm_loadu_pd(ar + i), Ai = _mm_loadu_pd(ai + i);
+                    __m128d t0r = _mm_add_pd(Ar, bR), t0i = _mm_add_pd(Ai, bI);
+                    __m128d t1r = _mm_sub_pd(Ar, bR), t1i = _mm_sub_pd(Ai, bI);
+                    __m128d t2r = _mm_add_pd(cR, dR), t2i = _mm_add_pd(cI, dI);
+                    __m128d t3r = _mm_sub_pd(cR, dR), t3i = _mm_sub_pd(cI, dI);
+
+                    _mm_storeu_pd(ar + i, _mm_add_pd(t0r, t2r));
+                    _mm_storeu_pd(ai + i, _mm_add_pd(t0i, t2i));
+                    _mm_storeu_pd(cr + i, _mm_sub_pd(t0r, t2r));
+                    _mm_storeu_pd(ci + i, _mm_sub_pd(t0i, t2i));
+                    _mm_storeu_pd(br + i, _mm_add_pd(t1r, t3i));
+                    _mm_storeu_pd(bi + i, _mm_sub_pd(t1i, t3r));
+                    _mm_storeu_pd(dr + i, _mm_sub_pd(t1r, t3i));
+                    _mm_storeu_pd(di + i, _mm_add_pd(t1i, t3r));
+                }
+            }
+        }
+    }
+
+    /**
+     * Radix-4 batch stage, AVX2 + FMA version (batch % 4 == 0).
+     */
+    __attribute__((target("avx2,fma")))
+    static void radix4BatchAvx2(double* re, double* im, unsigned int N,
+                                unsigned int m, const double* tw,
+                                unsigned int batch)
+    {
+        const unsigned int mb = m * batch;
+        for (unsigned int block = 0; block < N * batch; block += 4 * mb)
+        {
+            double *ar = re + block, *br = ar + mb, *cr = br + mb, *dr = cr + mb;
+            double *ai = im + block, *bi = ai + mb, *ci = bi + mb, *di = ci + mb;
+
+            for (unsigned int p = 0; p < m; ++p)
+            {
+                __m256d W1r = _mm256_set1_pd(tw[p]), W1i = _mm256_set1_pd(tw[m + p]);
+                __m256d W2r = _mm256_set1_pd(tw[2*m + p]), W2i = _mm256_set1_pd(tw[3*m + p]);
+                __m256d W3r = _mm256_set1_pd(tw[4*m + p]), W3i = _mm256_set1_pd(tw[5*m + p]);
+
+                for (unsigned int i = p * batch; i < (p + 1) * batch; i += 4)
+                {
+                    __m256d Br = _mm256_loadu_pd(br + i), Bi = _mm256_loadu_pd(bi + i);
+                    __m256d Cr = _mm256_loadu_pd(cr + i), Ci = _mm256_loadu_pd(ci + i);
+                    __m256d Dr = _mm256_loadu_pd(dr + i), Di = _mm256_loadu_pd(di + i);
+
+                    __m256d bR = _mm256_fmsub_pd(Br, W2r, _mm256_mul_pd(Bi, W2i));
+                    __m256d bI = _mm256_fmadd_pd(Br, W2i, _mm256_mul_pd(Bi, W2r));
+                    __m256d cR = _mm256_fmsub_pd(Cr, W1r, _mm256_mul_pd(Ci, W1i));
+                    __m256d cI = _mm256_fmadd_pd(Cr, W1i, _mm256_mul_pd(Ci, W1r));
+                    __m256d dR = _mm256_fmsub_pd(Dr, W3r, _mm256_mul_pd(Di, W3i));
+                    __m256d dI = _mm256_fmadd_pd(Dr, W3i, _mm256_mul_pd(Di, W3r));
+
+                    __m256d Ar = _mm256_loadu_pd(ar + i), Ai = _mm256_loadu_pd(ai + i);
+                    __m256d t0r = _mm256_add_pd(Ar, bR), t0i = _mm256_add_pd(Ai, bI);
+                    __m256d t1r = _mm256_sub_pd(Ar, bR), t1i = _mm256_sub_pd(Ai, bI);
+                    __m256d t2r = _mm256_add_pd(cR, dR), t2i = _mm256_add_pd(cI, dI);
+                    __m256d t3r = _mm256_sub_pd(cR, dR), t3i = _mm256_sub_pd(cI, dI);
+
+                    _mm256_storeu_pd(ar + i, _mm256_add_pd(t0r, t2r));
+                    _mm256_storeu_pd(ai + i, _mm256_add_pd(t0i, t2i));
+                    _mm256_storeu_pd(cr + i, _mm256_sub_pd(t0r, t2r));
+                    _mm256_storeu_pd(ci + i, _mm256_sub_pd(t0i, t2i));
+                    _mm256_storeu_pd(br + i, _mm256_add_pd(t1r, t3i));
+                    _mm256_storeu_pd(bi + i, _mm256_sub_pd(t1i, t3r));
+                    _mm256_storeu_pd(dr + i, _mm256_sub_pd(t1r, t3i));
+                    _mm256_storeu_pd(di + i, _mm256_add_pd(t1i, t3r));
+                }
+            }
+        }
+    }
+
+    /**
+     * Radix-4 batch stage, AVX-512 version (batch % 8 == 0).
+     */
+    __attribute__((target("avx512f")))
+    static void radix4BatchAvx512(double* re, double* im, unsigned int N,
+                                  unsigned int m, const double* tw,
+                                  unsigned int batch)
+    {
+        const unsigned int mb = m * batch;
+        for (unsigned int block = 0; block < N * batch; block += 4 * mb)
+        {
+            double *ar = re + block, *br = ar + mb, *cr = br + mb, *dr = cr + mb;
+            double *ai = im + block, *bi = ai + mb, *ci = bi + mb, *di = ci + mb;
+
+            for (unsigned int p = 0; p < m; ++p)
+            {
+                __m512d W1r = _mm512_set1_pd(tw[p]), W1i = _mm512_set1_pd(tw[m + p]);
+                __m512d W2r = _mm512_set1_pd(tw[2*m + p]), W2i = _mm512_set1_pd(tw[3*m + p]);
+                __m512d W3r = _mm512_set1_pd(tw[4*m + p]), W3i = _mm512_set1_pd(tw[5*m + p]);
+
+                for (unsigned int i = p * batch; i < (p + 1) * batch; i += 8)
+                {
+                    __m512d Br = _mm512_loadu_pd(br + i), Bi = _mm512_loadu_pd(bi + i);
+                    __m512d Cr = _mm512_loadu_pd(cr + i), Ci = _mm512_loadu_pd(ci + i);
+                    __m512d Dr = _mm512_loadu_pd(dr + i), Di = _mm512_loadu_pd(di + i);
+
+                    __m512d bR = _mm512_fmsub_pd(Br, W2r, _mm512_mul_pd(Bi, W2i));
+                    __m512d bI = _mm512_fmadd_pd(Br, W2i, _mm512_mul_pd(Bi, W2r));
+                    __m512d cR = _mm512_fmsub_pd(Cr, W1r, _mm512_mul_pd(Ci, W1i));
+                    __m512d cI = _mm512_fmadd_pd(Cr, W1i, _mm512_mul_pd(Ci, W1r));
+                    __m512d dR = _mm512_fmsub_pd(Dr, W3r, _mm512_mul_pd(Di, W3i));
+                    __m512d dI = _mm512_fmadd_pd(Dr, W3i, _mm512_mul_pd(Di, W3r));
+
+                    __m512d Ar = _mm512_loadu_pd(ar + i), Ai = _mm512_loadu_pd(ai + i);
+                    __m512d t0r = _mm512_add_pd(Ar, bR), t0i = _mm512_add_pd(Ai, bI);
+                    __m512d t1r = _mm512_sub_pd(Ar, bR), t1i = _mm512_sub_pd(Ai, bI);
+                    __m512d t2r = _mm512_add_pd(cR, dR), t2i = _mm512_add_pd(cI, dI);
+                    __m512d t3r = _mm512_sub_pd(cR, dR), t3i = _mm512_sub_pd(cI, dI);
+
+                    _mm512_storeu_pd(ar + i, _mm512_add_pd(t0r, t2r));
+                    _mm512_storeu_pd(ai + i, _mm512_add_pd(t0i, t2i));
+                    _mm512_storeu_pd(cr + i, _mm512_sub_pd(t0r, t2r));
+                    _mm512_storeu_pd(ci + i, _mm512_sub_pd(t0i, t2i));
+                    _mm512_storeu_pd(br + i, _mm512_add_pd(t1r, t3i));
+                    _mm512_storeu_pd(bi + i, _mm512_sub_pd(t1i, t3r));
+                    _mm512_storeu_pd(dr + i, _mm512_sub_pd(t1r, t3i));
+                    _mm512_storeu_pd(di + i, _mm512_add_pd(t1i, t3r));
+                }
+            }
+        }
+    }
+    /**
+     * Matrix product, SSE2 version.
+     */
+    __attribute__((target("sse2")))
+    static void matrixProductSse2(const double* a, unsigned int rows,
+                                  unsigned int stride, const double* x,
+                                  unsigned int count, double* y)
+    {
+        for (unsigned int n = 0; n < rows; ++n)
+        {
+            const double* row = a + n * stride;
+            for (unsigned int f = 0; f < count; ++f)
+            {
+                const double* v = x + f * stride;
+                __m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+                for (unsigned int k = 0; k < stride; k += 4)
+                {
+                    s0 = _mm_add_pd(s0, _mm_mul_pd(_mm_loadu_pd(row + k),
+                                                   _mm_loadu_pd(v + k)));
+                    s1 = _mm_add_pd(s1, _mm_mul_pd(_mm_loadu_pd(row + k + 2),
+                                                   _mm_loadu_pd(v + k + 2)));
+                }
+                s0 = _mm_add_pd(s0, s1);
+                s0 = _mm_add_sd(s0, _mm_unpackhi_pd(s0, s0));
+                y[f * rows + n] = _mm_cvtsd_f64(s0);
+            }
+        }
+    }
+
+    /**
+     * Matrix product, AVX2 + FMA version.
+     */
+    __attribute__((target("avx2,fma")))
+    static void matrixProductAvx2(const double* a, unsigned int rows,
+                                  unsigned int stride, const double* x,
+                                  unsigned int count, double* y)
+    {
+        for (unsigned int n = 0; n < rows; ++n)
+        {
+            const double* row = a + n * stride;
+            for (unsigned int f = 0; f < count; ++f)
+            {
+                const double* v = x + f * stride;
+                __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+                for (unsigned int k = 0; k < stride; k += 8)
+                {
+                    s0 = _mm256_fmadd_pd(_mm256_loadu_pd(row + k),
+                                         _mm256_loadu_pd(v + k), s0);
+                    s1 = _mm256_fmadd_pd(_mm256_loadu_pd(row + k + 4),
+                                         _mm256_loadu_pd(v + k + 4), s1);
+                }
+                s0 = _mm256_add_pd(s0, s1);
+                __m128d s = _mm_add_pd(_mm256_castpd256_pd128(s0),
+                                       _mm256_extractf128_pd(s0, 1));
+                s = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+                y[f * rows + n] = _mm_cvtsd_f64(s);
+            }
+        }
+    }
+
+    /**
+     * Matrix product, AVX-512 version.
+     */
+    __attribute__((target("avx512f")))
+    static void matrixProductAvx512(const double* a, unsigned int rows,
+                                    unsigned int stride, const double* x,
+                                    unsigned int count, double* y)
+    {
+        for (unsigned int n = 0; n < rows; ++n)
+        {
+            const double* row = a + n * stride;
+            for (unsigned int f = 0; f < count; ++f)
+            {
+                const double* v = x + f * stride;
+                __m512d s = _mm512_setzero_pd();
+                for (unsigned int k = 0; k < stride; k += 8)
+                {
+                    s = _mm512_fmadd_pd(_mm512_loadu_pd(row + k),
+                                        _mm512_loadu_pd(v + k), s);
+                }
+                // masked extracts, as the plain ones trip -Wmaybe-uninitialized
+                __m256d h = _mm256_add_pd(
+                    _mm512_maskz_extractf64x4_pd(0xf, s, 0),
+                    _mm512_maskz_extractf64x4_pd(0xf, s, 1));
+                __m128d q = _mm_add_pd(_mm256_castpd256_pd128(h),
+                                       _mm256_extractf128_pd(h, 1));
+                q = _mm_add_sd(q, _mm_unpackhi_pd(q, q));
+                y[f * rows + n] = _mm_cvtsd_f64(q);
+            }
+        }
+    }
+    /**
+     * Preemphasis and windowing, SSE2 version.
+     */
+    __attribute__((target("sse2")))
+    static void windowSse2(const int* x, unsigned int count, double a,
+                           const double* w, double* y)
+    {
+        const __m128d A = _mm_set1_pd(a);
+        unsigned int i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128d current = _mm_cvtepi32_pd(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(x + i)));
+            __m128d previous = _mm_cvtepi32_pd(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(x + i - 1)));
+            __m128d filtered = _mm_sub_pd(current, _mm_mul_pd(A, previous));
+            _mm_storeu_pd(y + i, _mm_mul_pd(filtered, _mm_loadu_pd(w + i)));
+        }
+        windowScalar(x + i, count - i, a, w + i, y + i);
+    }
+
+    /**
+     * Preemphasis and windowing, AVX2 + FMA version.
+     */
+    __attribute__((target("avx2,fma")))
+    static void windowAvx2(const int* x, unsigned int count, double a,
+                           const double* w, double* y)
+    {
+        const __m256d A = _mm256_set1_pd(a);
+        unsigned int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256d current = _mm256_cvtepi32_pd(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i)));
+            __m256d previous = _mm256_cvtepi32_pd(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i - 1)));
+            __m256d filtered = _mm256_fnmadd_pd(A, previous, current);
+            _mm256_storeu_pd(y + i,
+                             _mm256_mul_pd(filtered, _mm256_loadu_pd(w + i)));
+        }
+        windowScalar(x + i, count - i, a, w + i, y + i);
+    }
+
+    /**
+     * Preemphasis and windowing, AVX-512 version.
+     */
+    __attribute__((target("avx512f")))
+    static void windowAvx512(const int* x, unsigned int count, double a,
+                             const double* w, double* y)
+    {
+        const __m512d A = _mm512_set1_pd(a);
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            // masked conversions, as the plain ones trip -Wmaybe-uninitialized
+            const __m256i* p = reinterpret_cast<const __m256i*>(x + i);
+            const __m256i* q = reinterpret_cast<const __m256i*>(x + i - 1);
+            __m512d current = _mm512_maskz_cvtepi32_pd(0xff,
+                                                       _mm256_loadu_si256(p));
+            __m512d previous = _mm512_maskz_cvtepi32_pd(0xff,
+                                                        _mm256_loadu_si256(q));
+            __m512d filtered = _mm512_fnmadd_pd(A, previous, current);
+            _mm512_storeu_pd(y + i,
+                             _mm512_mul_pd(filtered, _mm512_loadu_pd(w + i)));
+        }
+        windowScalar(x + i, count - i, a, w + i, y + i);
+    }
+
+    /**
+     * Preemphasis and windowing of 16-bit samples, SSE2 version.
+     */
+    __attribute__((target("sse2")))
+    static void window16Sse2(const boost::int16_t* x, unsigned int count,
+                             double a, const double* w, double* y)
+    {
+        const __m128d A = _mm_set1_pd(a);
+        unsigned int i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            // two 16-bit samples are sign-extended to 32 bits by unpacking
+            // them to upper halves and shifting back
+            boost::int32_t pair[2];
+            std::memcpy(pair, x + i - 1, 2 * sizeof(boost::int16_t));
+            std::memcpy(pair + 1, x + i, 2 * sizeof(boost::int16_t));
+            __m128i p = _mm_cvtsi32_si128(pair[0]);
+            __m128i c = _mm_cvtsi32_si128(pair[1]);
+            __m128d current = _mm_cvtepi32_pd(
+                _mm_srai_epi32(_mm_unpacklo_epi16(c, c), 16));
+            __m128d previous = _mm_cvtepi32_pd(
+                _mm_srai_epi32(_mm_unpacklo_epi16(p, p), 16));
+            __m128d filtered = _mm_sub_pd(current, _mm_mul_pd(A, previous));
+            _mm_storeu_pd(y + i, _mm_mul_pd(filtered, _mm_loadu_pd(w + i)));
+        }
+        windowScalar(x + i, count - i, a, w + i, y + i);
+    }
+
+    /**
+     * Preemphasis and windowing of 16-bit samples, AVX2 + FMA version.
+     */
+    __attribute__((target("avx2,fma")))
+    static void window16Avx2(const boost::int16_t* x, unsigned int count,
+                             double a, const double* w, double* y)
+    {
+        const __m256d A = _mm256_set1_pd(a);
+        unsigned int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256d current = _mm256_cvtepi32_pd(_mm_cvtepi16_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(x + i))));
+            __m256d previous = _mm256_cvtepi32_pd(_mm_cvtepi16_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(x + i - 1))));
+            __m256d filtered = _mm256_fnmadd_pd(A, previous, current);
+            _mm256_storeu_pd(y + i,
+                             _mm256_mul_pd(filtered, _mm256_loadu_pd(w + i)));
+        }
+        windowScalar(x + i, count - i, a, w + i, y + i);
+    }
+
+    /**
+     * Preemphasis and windowing of 16-bit samples, AVX-512 version.
+     */
+    __attribute__((target("avx512f")))
+    static void window16Avx512(const boost::int16_t* x, unsigned int count,
+                               double a, const double* w, double* y)
+    {
+        const __m512d A = _mm512_set1_pd(a);
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i* p = reinterpret_cast<const __m128i*>(x + i);
+            const __m128i* q = reinterpret_cast<const __m128i*>(x + i - 1);
+            __m512d current = _mm512_maskz_cvtepi32_pd(0xff,
+                _mm256_cvtepi16_epi32(_mm_loadu_si128(p)));
+            __m512d previous = _mm512_maskz_cvtepi32_pd(0xff,
+                _mm256_cvtepi16_epi32(_mm_loadu_si128(q)));
+            __m512d filtered = _mm512_fnmadd_pd(A, previous, current);
+            _mm512_storeu_pd(y + i,
+                             _mm512_mul_pd(filtered, _mm512_loadu_pd(w + i)));
+        }
+        windowScalar(x + i, count - i, a, w + i, y + i);
+    }
+
+    /**
+     * Sum of squares of samples, SSE2 version.
+     */
+    __attribute__((target("sse2")))
+    static double squaresSse2(const int* x, unsigned int count)
+    {
+        __m128d sum0 = _mm_setzero_pd(), sum1 = _mm_setzero_pd();
+        unsigned int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+            __m128d lo = _mm_cvtepi32_pd(v);
+            __m128d hi = _mm_cvtepi32_pd(_mm_unpackhi_epi64(v, v));
+            sum0 = _mm_add_pd(sum0, _mm_mul_pd(lo, lo));
+            sum1 = _mm_add_pd(sum1, _mm_mul_pd(hi, hi));
+        }
+        double lanes[2];
+        _mm_storeu_pd(lanes, _mm_add_pd(sum0, sum1));
+        return lanes[0] + lanes[1] + squaresScalar(x + i, count - i);
+    }
+
+    /**
+     * Sum of squares of samples, AVX2 + FMA version.
+     */
+    __attribute__((target("avx2,fma")))
+    static double squaresAvx2(const int* x, unsigned int count)
+    {
+        __m256d sum0 = _mm256_setzero_pd(), sum1 = _mm256_setzero_pd();
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256d lo = _mm256_cvtepi32_pd(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i)));
+            __m256d hi = _mm256_cvtepi32_pd(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i + 4)));
+            sum0 = _mm256_fmadd_pd(lo, lo, sum0);
+            sum1 = _mm256_fmadd_pd(hi, hi, sum1);
+        }
+        double lanes[4];
+        _mm256_storeu_pd(lanes, _mm256_add_pd(sum0, sum1));
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) +
+            squaresScalar(x + i, count - i);
+    }
+
+    /**
+     * Sum of squares of samples, AVX-512 version.
+     */
+    __attribute__((target("avx512f")))
+    static double squaresAvx512(const int* x, unsigned int count)
+    {
+        __m512d sum0 = _mm512_setzero_pd(), sum1 = _mm512_setzero_pd();
+        unsigned int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            const __m256i* p = reinterpret_cast<const __m256i*>(x + i);
+            __m512d lo = _mm512_maskz_cvtepi32_pd(0xff, _mm256_loadu_si256(p));
+            __m512d hi = _mm512_maskz_cvtepi32_pd(0xff,
+                                                  _mm256_loadu_si256(p + 1));
+            sum0 = _mm512_fmadd_pd(lo, lo, sum0);
+            sum1 = _mm512_fmadd_pd(hi, hi, sum1);
+        }
+        double lanes[8];
+        _mm512_storeu_pd(lanes, _mm512_add_pd(sum0, sum1));
+        return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+            ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7])) +
+            squaresScalar(x + i, count - i);
+    }
+
+    /**
+     * Sum of squares of 16-bit samples, SSE2 version.
+     *
+     * Pairs of squares are summed by a multiply-add into 32-bit lanes,
+     * which are unsigned (two squares of -32768 do not fit in int32), and
+     * accumulated in 64-bit lanes, so the sum is exact.
+     */
+    __attribute__((target("sse2")))
+    static double squares16Sse2(const boost::int16_t* x, unsigned int count)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i sum = _mm_setzero_si128();
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+            __m128i pairs = _mm_madd_epi16(v, v);
+            sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(pairs, zero));
+            sum = _mm_add_epi64(sum, _mm_unpackhi_epi32(pairs, zero));
+        }
+        boost::uint64_t lanes[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), sum);
+        return static_cast<double>(lanes[0] + lanes[1]) +
+            squares16Scalar(x + i, count - i);
+    }
+
+    /**
+     * Sum of squares of 16-bit samples, AVX2 version, see squares16Sse2().
+     */
+    __attribute__((target("avx2")))
+    static double squares16Avx2(const boost::int16_t* x, unsigned int count)
+    {
+        __m256i sum = _mm256_setzero_si256();
+        unsigned int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m256i v = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(x + i));
+            __m256i pairs = _mm256_madd_epi16(v, v);
+            sum = _mm256_add_epi64(sum, _mm256_cvtepu32_epi64(
+                _mm256_castsi256_si128(pairs)));
+            sum = _mm256_add_epi64(sum, _mm256_cvtepu32_epi64(
+                _mm256_extracti128_si256(pairs, 1)));
+        }
+        boost::uint64_t lanes[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), sum);
+        return static_cast<double>(lanes[0] + lanes[1] + lanes[2] + lanes[3]) +
+            squares16Scalar(x + i, count - i);
+    }
+#endif // AQUILA_X86_SIMD
+
+    FftKernels::Radix4Function FftKernels::radix4Function = &radix4Scalar;
+    FftKernels::Radix4BatchFunction FftKernels::radix4BatchFunction =
+        &radix4BatchScalar;
+    FftKernels::MatrixFunction FftKernels::matrixFunction = &matrixProductScalar;
+    FftKernels::WindowFunction FftKernels::windowFunction =
+        &windowScalar<int>;
+    FftKernels::Window16Function FftKernels::window16Function =
+        &windowScalar<boost::int16_t>;
+    FftKernels::SquaresFunction FftKernels::squaresFunction = &squaresScalar;
+    FftKernels::Squares16Function FftKernels::squares16Function =
+        &squares16Scalar;
+    unsigned int FftKernels::vectorLength = 1;
+    SimdLevel FftKernels::currentLevel = SIMD_NONE;
+    bool FftKernels::initialized = FftKernels::initialize();
+
+    /**
+     * Detects the best instruction set supported by the processor (and OS).
+     *
+     * @return one of SimdLevel values
+     */
+    SimdLevel FftKernels::getSupportedLevel()
+    {
+#ifdef AQUILA_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return SIMD_AVX512;
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return SIMD_AVX2;
+        if (__builtin_cpu_supports("sse2"))
+            return SIMD_SSE2;
+#endif
+        return SIMD_NONE;
+    }
+
+    /**
+     * Returns the instruction set currently used by the kernels.
+     *
+     * @return one of SimdLevel values
+     */
+    SimdLevel FftKernels::getLevel()
+    {
+        return currentLevel;
+    }
+
+    /**
+     * Selects kernels for a given instruction set.
+     *
+     * Levels not supported by the processor are lowered to the best
+     * supported one. This is mainly useful to compare results and speed
+     * with the scalar path; it should not be called while any transform
+     * is running.
+     *
+     * @param level requested instruction set
+     */
+    void FftKernels::setLevel(SimdLevel level)
+    {
+        SimdLevel supported = getSupportedLevel();
+        if (level > supported)
+            level = supported;
+
+        currentLevel = level;
+        radix4Function = &radix4Scalar;
+        radix4BatchFunction = &radix4BatchScalar;
+        matrixFunction = &matrixProductScalar;
+        windowFunction = &windowScalar<int>;
+        window16Function = &windowScalar<boost::int16_t>;
+        squaresFunction = &squaresScalar;
+        squares16Function = &squares16Scalar;
+        vectorLength = 1;
+#ifdef AQUILA_X86_SIMD
+        switch (level)
+        {
+        case SIMD_AVX512:
+            radix4Function = &radix4Avx512;
+            radix4BatchFunction = &radix4BatchAvx512;
+            matrixFunction = &matrixProductAvx512;
+            windowFunction = &windowAvx512;
+            window16Function = &window16Avx512;
+            squaresFunction = &squaresAvx512;
+            // 16-bit multiply-add needs AVX-512BW, AVX2 is used instead
+            squares16Function = &squares16Avx2;
+            vectorLength = 8;
+            break;
+        case SIMD_AVX2:
+            radix4Function = &radix4Avx2;
+            radix4BatchFunction = &radix4BatchAvx2;
+            matrixFunction = &matrixProductAvx2;
+            windowFunction = &windowAvx2;
+            window16Function = &window16Avx2;
+            squaresFunction = &squaresAvx2;
+            squares16Function = &squares16Avx2;
+            vectorLength = 4;
+            break;
+        case SIMD_SSE2:
+            radix4Function = &radix4Sse2;
+            radix4BatchFunction = &radix4BatchSse2;
+            matrixFunction = &matrixProductSse2;
+            windowFunction = &windowSse2;
+            window16Function = &window16Sse2;
+            squaresFunction = &squaresSse2;
+            squares16Function = &squares16Sse2;
+            vectorLength = 2;
+            break;
+        default:
+            break;
+        }
+#endif
+    }
+
+    /**
+     * Selects the best kernels supported by the processor.
+     *
+     * @return always true
+     */
+    bool FftKernels::initialize()
+    {
+        setLevel(getSupportedLevel());
+        return true;
+    }
+
+    /**
+     * Calculates a radix-2 stage with trivial twiddle factors (m = 1).
+     *
+     * @param re real parts
+     * @param im imaginary parts
+     * @param N transform length
+     */
+    void FftKernels::radix2Stage(double* re, double* im, unsigned int N)
+    {
+        for (unsigned int i = 0; i < N; i += 2)
+        {
+            double tr = re[i + 1], ti = im[i + 1];
+            re[i + 1] = re[i] - tr;
+            im[i + 1] = im[i] - ti;
+            re[i] += tr;
+            im[i] += ti;
+        }
+    }
+
+    /**
+     * Calculates a radix-4 stage using the best available kernel.
+     *
+     * Stages shorter than the vector length are computed by scalar code.
+     *
+     * @param re real parts
+     * @param im imaginary parts
+     * @param N transform length
+     * @param m length of combined sub-transforms
+     * @param twiddles 6*m twiddle factors of the stage
+     */
+    void FftKernels::radix4Stage(double* re, double* im, unsigned int N,
+                                 unsigned int m, const double* twiddles)
+    {
+        if (1 == m)
+            radix4Trivial(re, im, N);
+        else if (m < vectorLength)
+            radix4Scalar(re, im, N, m, twiddles);
+        else
+            radix4Function(re, im, N, m, twiddles);
+    }
+
+    /**
+     * Calculates a radix-2 stage (m = 1) over a batch of transforms.
+     *
+     * Value i of transform b is stored at index i*batch + b.
+     *
+     * @param re real parts
+     * @param im imaginary parts
+     * @param N transform length
+     * @param batch number of interleaved transforms
+     */
+    void FftKernels::radix2StageBatch(double* re, double* im, unsigned int N,
+                                      unsigned int batch)
+    {
+        for (unsigned int block = 0; block < N * batch; block += 2 * batch)
+        {
+            double *ar = re + block, *br = ar + batch;
+            double *ai = im + block, *bi = ai + batch;
+            for (unsigned int i = 0; i < batch; ++i)
+            {
+                double tr = br[i], ti = bi[i];
+                br[i] = ar[i] - tr;
+                bi[i] = ai[i] - ti;
+                ar[i] += tr;
+                ai[i] += ti;
+            }
+        }
+    }
+
+    /**
+     * Calculates a radix-4 stage over a batch of transforms.
+     *
+     * All transforms share the same twiddle factors, so vector registers
+     * are filled with values of different transforms, even in the first
+     * stages, where a single transform has too few independent butterflies.
+     * Batches which are not a multiple of the vector length are computed
+     * by scalar code.
+     *
+     * @param re real parts
+     * @param im imaginary parts
+     * @param N transform length
+     * @param m length of combined sub-transforms
+     * @param twiddles 6*m twiddle factors of the stage
+     * @param batch number of interleaved transforms
+     */
+    void FftKernels::radix4StageBatch(double* re, double* im, unsigned int N,
+                                      unsigned int m, const double* twiddles,
+                                      unsigned int batch)
+    {
+        if (batch % vectorLength)
+            radix4BatchScalar(re, im, N, m, twiddles, batch);
+        else
+            radix4BatchFunction(re, im, N, m, twiddles, batch);
+    }
+
+    /**
+     * Multiplies a matrix by a block of vectors using the best kernel.
+     *
+     * Computes y[f*rows + n] as the dot product of matrix row n and
+     * vector f. Rows and vectors are padded with zeros to the stride.
+     *
+     * @param matrix rows x stride values, row by row
+     * @param rows number of matrix rows
+     * @param stride row length, a multiple of MATRIX_STRIDE_MULTIPLE
+     * @param x count vectors of stride values, one after another
+     * @param count number of vectors
+     * @param y count x rows products
+     */
+    void FftKernels::matrixProduct(const double* matrix, unsigned int rows,
+                                   unsigned int stride, const double* x,
+                                   unsigned int count, double* y)
+    {
+        matrixFunction(matrix, rows, stride, x, count, y);
+    }
+
+    /**
+     * Runs a preemphasis and windowing kernel over a frame.
+     *
+     * @param function kernel
+     * @param samples frame samples
+     * @param length number of samples
+     * @param preemphasis preemphasis factor
+     * @param window length window values
+     * @param output output buffer
+     * @param outputLength output length, zero padded
+     */
+    template <typename T, typename Function>
+    static void windowFrameWith(Function function, const T* samples,
+                                unsigned int length, double preemphasis,
+                                const double* window, double* output,
+                                unsigned int outputLength)
+    {
+        if (length > outputLength)
+            length = outputLength;
+        if (length > 0)
+        {
+            output[0] = samples[0];
+            function(samples + 1, length - 1, preemphasis, window + 1,
+                     output + 1);
+        }
+        for (unsigned int n = length; n < outputLength; ++n)
+        {
+            output[n] = 0.0;
+        }
+    }
+
+    /**
+     * Prepares a signal frame for FFT using the best kernel.
+     *
+     * In a single pass, samples are converted to doubles, filtered by
+     * preemphasis y[n] = x[n] - a*x[n-1] and multiplied by the window.
+     * The first sample has no predecessor, so it is copied as is. The
+     * rest of the output is filled with zeros.
+     *
+     * @param samples frame samples
+     * @param length number of samples
+     * @param preemphasis preemphasis factor
+     * @param window length window values
+     * @param output output buffer
+     * @param outputLength output length, zero padded (if less than
+     *                     length, only that many samples are used)
+     */
+    void FftKernels::windowFrame(const int* samples, unsigned int length,
+                                 double preemphasis, const double* window,
+                                 double* output, unsigned int outputLength)
+    {
+        windowFrameWith(windowFunction, samples, length, preemphasis, window,
+                        output, outputLength);
+    }
+
+    /**
+     * Prepares a frame of 16-bit samples for FFT using the best kernel.
+     *
+     * Samples are read in their native width, see
+     * windowFrame(const int*, unsigned int, double, const double*, double*,
+     * unsigned int).
+     *
+     * @param samples frame samples
+     * @param length number of samples
+     * @param preemphasis preemphasis factor
+     * @param window length window values
+     * @param output output buffer
+     * @param outputLength output length, zero padded
+     */
+    void FftKernels::windowFrame(const boost::int16_t* samples,
+                                 unsigned int length, double preemphasis,
+                                 const double* window, double* output,
+                                 unsigned int outputLength)
+    {
+        windowFrameWith(window16Function, samples, length, preemphasis,
+                        window, output, outputLength);
+    }
+
+    /**
+     * Calculates sum of squares of samples using the best kernel.
+     *
+     * @param samples frame samples
+     * @param length number of samples
+     * @return sum of squared samples
+     */
+    double FftKernels::sumOfSquares(const int* samples, unsigned int length)
+    {
+        return squaresFunction(samples, length);
+    }
+
+    /**
+     * Calculates sum of squares of 16-bit samples using the best kernel.
+     *
+     * The sum is computed exactly, in integers.
+     *
+     * @param samples frame samples
+     * @param length number of samples
+     * @return sum of squared samples
+     */
+    double FftKernels::sumOfSquares(const boost::int16_t* samples,
+                                    unsigned int length)
+    {
+        return squares16Function(samples, length);
+    }
+}
@@ -0,0 +1,189 @@
+/**
+ * @file FftKernels.h
+ *
+ * Vectorized FFT kernels with runtime dispatch - header.
+ *
+ * Kernels work on split complex data: real and imaginary parts are kept
+ * in two separate arrays, so that a SIMD register holds several real (or
+ * imaginary) parts and no shuffling is needed. Every kernel is compiled
+ * for a few instruction sets, and the best one supported by the processor
+ * is chosen at runtime, so that a single binary runs everywhere.
+ *
+ * Vectorized kernels give the same results as the scalar ones up to
+ * rounding, as they compute the same operations in the same order, except
+ * that AVX2 and AVX-512 kernels use fused multiply-add. The difference
+ * is at most a few units in the last place per stage; relative to the
+ * spectrum peak it stays below 1e-14 for all lengths up to 2^20.
+ *
+ * The same dispatch is used by the matrix product which computes DCT
+ * and by the kernel preparing signal frames for FFT.
+ *
+ * SIMD can be disabled at compile time by defining AQUILA_NO_SIMD.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#ifndef FFTKERNELS_H
+#define FFTKERNELS_H
+
+#include "global.h"
+#include <boost/cstdint.hpp>
+
+namespace Aquila
+{
+    /**
+     * Instruction sets the kernels are compiled for.
+     */
+    enum SimdLevel { SIMD_NONE, SIMD_SSE2, SIMD_AVX2, SIMD_AVX512 };
+
+    /**
+     * Rows of matrices passed to FftKernels::matrixProduct() are padded
+     * to a multiple of this number of values.
+     */
+    const unsigned int MATRIX_STRIDE_MULTIPLE = 8;
+
+
+    /**
+     * A collection of FFT kernels, dispatched by instruction set.
+     */
+    class AQUILA_EXPORT FftKernels
+    {
+    public:
+        static SimdLevel getSupportedLevel();
+
+        static SimdLevel getLevel();
+
+        static void setLevel(SimdLevel level);
+
+        static void radix2Stage(double* re, double* im, unsigned int N);
+
+        static void radix4Stage(double* re, double* im, unsigned int N,
+                                unsigned int m, const double* twiddles);
+
+        static void radix2StageBatch(double* re, double* im, unsigned int N,
+                                     unsigned int batch);
+
+        static void radix4StageBatch(double* re, double* im, unsigned int N,
+                                     unsigned int m, const double* twiddles,
+                                     unsigned int batch);
+
+        static void matrixProduct(const double* matrix, unsigned int rows,
+                                  unsigned int stride, const double* x,
+                                  unsigned int count, double* y);
+
+        static void windowFrame(const int* samples, unsigned int length,
+                                double preemphasis, const double* window,
+                                double* output, unsigned int outputLength);
+
+        static void windowFrame(const boost::int16_t* samples,
+                                unsigned int length, double preemphasis,
+                                const double* window, double* output,
+                                unsigned int outputLength);
+
+        static double sumOfSquares(const int* samples, unsigned int length);
+
+        static double sumOfSquares(const boost::int16_t* samples,
+                                   unsigned int length);
+
+    private:
+        /**
+         * Signature of a radix-4 stage kernel.
+         */
+        typedef void (*Radix4Function)(double*, double*, unsigned int,
+                                       unsigned int, const double*);
+
+        /**
+         * Currently used radix-4 kernel.
+         */
+        static Radix4Function radix4Function;
+
+        /**
+         * Signature of a radix-4 stage kernel over a batch of transforms.
+         */
+        typedef void (*Radix4BatchFunction)(double*, double*, unsigned int,
+                                            unsigned int, const double*,
+                                            unsigned int);
+
+        /**
+         * Currently used batch radix-4 kernel.
+         */
+        static Radix4BatchFunction radix4BatchFunction;
+
+        /**
+         * Signature of a matrix product kernel.
+         */
+        typedef void (*MatrixFunction)(const double*, unsigned int,
+                                       unsigned int, const double*,
+                                       unsigned int, double*);
+
+        /**
+         * Currently used matrix product kernel.
+         */
+        static MatrixFunction matrixFunction;
+
+        /**
+         * Signature of a preemphasis and windowing kernel.
+         */
+        typedef void (*WindowFunction)(const int*, unsigned int, double,
+                                       const double*, double*);
+
+        /**
+         * Currently used preemphasis and windowing kernel.
+         */
+        static WindowFunction windowFunction;
+
+        /**
+         * Signature of a preemphasis and windowing kernel of 16-bit samples.
+         */
+        typedef void (*Window16Function)(const boost::int16_t*, unsigned int,
+                                         double, const double*, double*);
+
+        /**
+         * Currently used 16-bit preemphasis and windowing kernel.
+         */
+        static Window16Function window16Function;
+
+        /**
+         * Signature of a sum of squares kernel.
+         */
+        typedef double (*SquaresFunction)(const int*, unsigned int);
+
+        /**
+         * Currently used sum of squares kernel.
+         */
+        static SquaresFunction squaresFunction;
+
+        /**
+         * Signature of a sum of squares kernel of 16-bit samples.
+         */
+        typedef double (*Squares16Function)(const boost::int16_t*,
+                                            unsigned int);
+
+        /**
+         * Currently used 16-bit sum of squares kernel.
+         */
+        static Squares16Function squares16Function;
+
+        /**
+         * Number of doubles processed at once by the current kernel.
+         */
+        static unsigned int vectorLength;
+
+        /**
+         * Currently used instruction set.
+         */
+        static SimdLevel currentLevel;
+
+        /**
+         * Set when the best kernels are selected, at library load time.
+         */
+        static bool initialized;
+
+        static bool initialize();
+    };
+}
+
+#endif // FFTKERNELS_H
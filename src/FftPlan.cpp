@@ -0,0 +1,557 @@
+/**
+ * @file FftPlan.cpp
+ *
+ * Precomputed FFT plans - implementation.
+ *
+ * A plan holds everything that depends only on the transform length:
+ * the bit-reversal permutation and twiddle factors for all stages.
+ * Plans are immutable once created, so a single plan can be shared by any
+ * number of Transform objects, also across threads.
+ *
+ * Lengths which are powers of 2 use radix-4 kernel. Other lengths are
+ * split into factors 2, 3, 4 and 5 (mixed-radix algorithm), and those
+ * with a larger prime factor are computed by Bluestein's algorithm,
+ * as a convolution using power-of-2 transforms.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#include "FftPlan.h"
+
+#include "Exceptions.h"
+#include "FftKernels.h"
+#include <cmath>
+
+namespace Aquila
+{
+    /**
+     * Creates a plan for the registry.
+     *
+     * @param length transform length
+     * @return shared pointer to new plan
+     */
+    static FftPlan::PointerType createPlan(const unsigned int& length)
+    {
+        return FftPlan::PointerType(new FftPlan(length));
+    }
+
+    /**
+     * Checks if a plan is held only by the registry.
+     *
+     * @param plan registered plan
+     * @return true if nobody else uses the plan
+     */
+    static bool isUnused(const FftPlan::PointerType& plan)
+    {
+        return plan.unique();
+    }
+
+    /**
+     * Registry of all plans created so far, keyed by length.
+     */
+    static FftPlan::CacheType s_plans(&createPlan);
+
+    /**
+     * Multiplies two complex numbers.
+     *
+     * Written out in real arithmetic, because std::complex multiplication
+     * takes a slow path to handle infinities and NaNs.
+     */
+    static inline cplx multiply(const cplx& a, const cplx& b)
+    {
+        return cplx(a.real() * b.real() - a.imag() * b.imag(),
+                    a.real() * b.imag() + a.imag() * b.real());
+    }
+
+    /**
+     * Checks if a number has no prime factors other than 2, 3 and 5.
+     */
+    static bool isSmooth(unsigned int n)
+    {
+        static const unsigned int primes[] = {2, 3, 5};
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            while (n % primes[i] == 0)
+                n /= primes[i];
+        }
+        return 1 == n;
+    }
+
+    /**
+     * Chooses the algorithm and precomputes all its tables.
+     *
+     * @param length transform length
+     * @throw Aquila::Exception when length is 0
+     */
+    FftPlan::FftPlan(unsigned int length):
+        N(length), algorithm(FFT_RADIX_4), numStages(0)
+    {
+        if (0 == N)
+        {
+            throw Exception("FFT length must be greater than 0");
+        }
+
+        if ((N & (N - 1)) == 0)
+        {
+            while ((1u << numStages) < N)
+                ++numStages;
+
+            // bit-reversal permutation
+            bitReversal.resize(N);
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                unsigned int reversed = 0;
+                for (unsigned int b = 0; b < numStages; ++b)
+                {
+                    if (i & (1u << b))
+                        reversed |= 1u << (numStages - 1 - b);
+                }
+                bitReversal[i] = reversed;
+            }
+
+            // twiddle factors for radix-4 stages, in the order they are used;
+            // the first radix-4 stage has m = 2 when log2(N) is odd
+            twiddles.reserve(2 * N);
+            for (unsigned int m = (numStages & 1) ? 2 : 1; 4 * m <= N; m <<= 2)
+            {
+                const double step = -2.0 * M_PI / (4.0 * m);
+                for (unsigned int q = 1; q <= 3; ++q)
+                {
+                    for (unsigned int p = 0; p < m; ++p)
+                        twiddles.push_back(std::cos(step * q * p));
+                    for (unsigned int p = 0; p < m; ++p)
+                        twiddles.push_back(std::sin(step * q * p));
+                }
+            }
+        }
+        else
+        {
+            // factorize the length, larger radices first
+            static const unsigned int radices[] = {4, 2, 3, 5};
+            unsigned int rest = N;
+            for (unsigned int i = 0; i < 4; ++i)
+            {
+                while (rest % radices[i] == 0 && rest > 1)
+                {
+                    rest /= radices[i];
+                    factors.push_back(radices[i]);
+                    factors.push_back(rest);
+                }
+            }
+
+            if (1 == rest)
+            {
+                algorithm = FFT_MIXED_RADIX;
+                roots.resize(N);
+                for (unsigned int k = 0; k < N; ++k)
+                {
+                    roots[k] = std::polar(1.0, -2.0 * M_PI * k / double(N));
+                }
+            }
+            else
+            {
+                // X[k] = c[k] * sum(x[n] c[n] c*[k-n]), c[n] = exp(-j pi n^2/N)
+                // the sum is a convolution, computed through FFT of length
+                // M >= 2N-1, so that circular wrap-around does not matter
+                algorithm = FFT_BLUESTEIN;
+                factors.clear();
+                unsigned int M = 1;
+                while (M < 2 * N - 1)
+                    M <<= 1;
+                convolutionPlan = get(M);
+
+                chirp.resize(N);
+                for (unsigned int n = 0; n < N; ++n)
+                {
+                    // n^2 mod 2N keeps the phase argument small and exact
+                    unsigned long long n2 = static_cast<unsigned long long>(n) * n;
+                    n2 %= 2ULL * N;
+                    chirp[n] = std::polar(1.0, -M_PI * n2 / double(N));
+                }
+
+                chirpSpectrum.assign(M, cplx(0.0, 0.0));
+                chirpSpectrum[0] = std::conj(chirp[0]);
+                for (unsigned int n = 1; n < N; ++n)
+                {
+                    chirpSpectrum[n] = chirpSpectrum[M - n] = std::conj(chirp[n]);
+                }
+                convolutionPlan->transform(&chirpSpectrum[0]);
+                for (unsigned int i = 0; i < M; ++i)
+                {
+                    chirpSpectrum[i] /= M;
+                }
+            }
+        }
+
+        // twiddle factors for splitting a real transform of length 2N
+        realTwiddles.resize(N);
+        for (unsigned int k = 0; k < N; ++k)
+        {
+            realTwiddles[k] = std::polar(1.0, -M_PI * k / double(N));
+        }
+    }
+
+    /**
+     * Returns a shared plan of the given length.
+     *
+     * The plan is created on first request and then kept in the registry.
+     * This method can be safely called from many threads; plans are built
+     * without holding any lock, as they may need other plans. When the
+     * registry is bounded, plans evicted from it live on as long as they
+     * are used.
+     *
+     * @param length transform length
+     * @return shared pointer to immutable plan
+     * @throw Aquila::Exception when length is 0
+     */
+    FftPlan::PointerType FftPlan::get(unsigned int length)
+    {
+        return s_plans.get(length);
+    }
+
+    /**
+     * Removes plans which are not used outside the registry.
+     *
+     * Plans still held by Transform (or other) objects stay in the
+     * registry, as well as sub-plans of those plans.
+     *
+     * @return number of removed plans
+     */
+    unsigned int FftPlan::releaseUnused()
+    {
+        // plans of Bluestein's algorithm hold their power of 2 plans,
+        // which become unused only when the outer plan is removed
+        unsigned int released = 0, removed = 0;
+        do
+        {
+            removed = s_plans.removeIf(&isUnused);
+            released += removed;
+        }
+        while (removed > 0);
+
+        return released;
+    }
+
+    /**
+     * Returns the registry, eg. to read its statistics or bound its size.
+     *
+     * @return reference to the plan cache
+     */
+    FftPlan::CacheType& FftPlan::getCache()
+    {
+        return s_plans;
+    }
+
+    /**
+     * Returns the smallest length not less than given, which has a fast plan.
+     *
+     * Fast lengths have no prime factors other than 2, 3 and 5. When padding
+     * frames for the real-input FFT, the length should also be even.
+     *
+     * @param minLength minimum length, eg. number of samples in a frame
+     * @param even whether the length must be even
+     * @return fast transform length
+     */
+    unsigned int FftPlan::getFastLength(unsigned int minLength, bool even)
+    {
+        unsigned int n = (minLength > 1) ? minLength : 1;
+        while (!isSmooth(n) || (even && (n & 1)))
+            ++n;
+
+        return n;
+    }
+
+    /**
+     * Calculates unscaled complex FFT in place.
+     *
+     * @param data N complex values, replaced by their spectrum
+     */
+    void FftPlan::transform(cplx* data) const
+    {
+        std::vector<cplx> input(data, data + N);
+        transform(&input[0], data);
+    }
+
+    /**
+     * Calculates unscaled complex FFT of input into a separate output array.
+     *
+     * @param in N complex input values
+     * @param out N complex output values (must not overlap the input)
+     */
+    void FftPlan::transform(const cplx* in, cplx* out) const
+    {
+        switch (algorithm)
+        {
+        case FFT_RADIX_4:
+        {
+            alignedVectorType re(N), im(N);
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                re[i] = in[bitReversal[i]].real();
+                im[i] = in[bitReversal[i]].imag();
+            }
+            butterflies(&re[0], &im[0]);
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                out[i] = cplx(re[i], im[i]);
+            }
+            break;
+        }
+        case FFT_MIXED_RADIX:
+            mixedRadix(out, in, 1, &factors[0]);
+            break;
+        case FFT_BLUESTEIN:
+            bluestein(in, out);
+            break;
+        }
+    }
+
+    /**
+     * Calculates unscaled inverse FFT of input into a separate output array.
+     *
+     * Swapping real and imaginary parts of both input and output turns
+     * the forward transform into the inverse one, so the same kernels are
+     * used in both directions. The result is not divided by N.
+     *
+     * @param in N complex spectrum values
+     * @param out N complex output values (must not overlap the input)
+     */
+    void FftPlan::inverseTransform(const cplx* in, cplx* out) const
+    {
+        if (FFT_RADIX_4 == algorithm)
+        {
+            alignedVectorType re(N), im(N);
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                re[i] = in[bitReversal[i]].imag();
+                im[i] = in[bitReversal[i]].real();
+            }
+            butterflies(&re[0], &im[0]);
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                out[i] = cplx(im[i], re[i]);
+            }
+            return;
+        }
+
+        std::vector<cplx> swapped(N);
+        for (unsigned int i = 0; i < N; ++i)
+        {
+            swapped[i] = cplx(in[i].imag(), in[i].real());
+        }
+        transform(&swapped[0], out);
+        for (unsigned int i = 0; i < N; ++i)
+        {
+            out[i] = cplx(out[i].imag(), out[i].real());
+        }
+    }
+
+    /**
+     * Calculates FFT of split complex data already in bit-reversed order.
+     *
+     * The transform is computed by radix-4 stages, each replacing two
+     * radix-2 stages, so the data is traversed half as many times.
+     * A radix-2 stage is done first when log2(N) is odd; it needs no
+     * twiddle factors at all. Stages are computed by vectorized kernels,
+     * chosen at runtime (see FftKernels). Arrays aligned to SIMD_ALIGNMENT
+     * give the best performance.
+     *
+     * Available only for power of 2 lengths.
+     *
+     * @param re N real parts in bit-reversed order
+     * @param im N imaginary parts in bit-reversed order
+     */
+    void FftPlan::butterflies(double* re, double* im) const
+    {
+        if (N < 2)
+            return;
+
+        // m - length of the sub-transforms combined in the current stage
+        unsigned int m = 1;
+        if (numStages & 1)
+        {
+            FftKernels::radix2Stage(re, im, N);
+            m = 2;
+        }
+
+        const double* W = twiddles.empty() ? 0 : &twiddles[0];
+        for (; 4 * m <= N; W += 6 * m, m <<= 2)
+        {
+            FftKernels::radix4Stage(re, im, N, m, W);
+        }
+    }
+
+    /**
+     * Calculates FFTs of a batch of interleaved split complex signals.
+     *
+     * Value i of signal b is stored at index i*batch + b, and each signal
+     * is already in bit-reversed order. All signals are transformed
+     * together, stage by stage, so that twiddle factors are loaded once
+     * for the whole batch and vector registers hold values of different
+     * signals. This pays off for short transforms (up to a few thousand
+     * points), where a single transform cannot fill the vector units.
+     *
+     * Available only for power of 2 lengths.
+     *
+     * @param re N*batch real parts
+     * @param im N*batch imaginary parts
+     * @param batch number of signals
+     */
+    void FftPlan::butterflies(double* re, double* im, unsigned int batch) const
+    {
+        if (N < 2)
+            return;
+
+        unsigned int m = 1;
+        if (numStages & 1)
+        {
+            FftKernels::radix2StageBatch(re, im, N, batch);
+            m = 2;
+        }
+
+        const double* W = twiddles.empty() ? 0 : &twiddles[0];
+        for (; 4 * m <= N; W += 6 * m, m <<= 2)
+        {
+            FftKernels::radix4StageBatch(re, im, N, m, W, batch);
+        }
+    }
+
+    /**
+     * Calculates a decimation-in-time mixed-radix FFT step recursively.
+     *
+     * The input of length p*m is split into p interleaved subsequences,
+     * whose transforms (of length m) are computed first and written to
+     * consecutive blocks of the output. Then the blocks are combined by
+     * radix-p butterflies.
+     *
+     * @param out output array, p*m values
+     * @param in first input sample of this subsequence
+     * @param inStride distance between samples of this subsequence
+     * @param factor pointer to (p, m) pair in the factorization
+     */
+    void FftPlan::mixedRadix(cplx* out, const cplx* in, unsigned int inStride,
+                             const unsigned int* factor) const
+    {
+        const unsigned int p = factor[0], m = factor[1];
+        if (1 == m)
+        {
+            for (unsigned int q = 0; q < p; ++q)
+                out[q] = in[q * inStride];
+        }
+        else
+        {
+            for (unsigned int q = 0; q < p; ++q)
+                mixedRadix(out + q * m, in + q * inStride, inStride * p,
+                           factor + 2);
+        }
+
+        // the whole step has length N/inStride, so its twiddle factors
+        // are every inStride-th root of unity of order N
+        const cplx* W = &roots[0];
+        const unsigned int s = inStride;
+        switch (p)
+        {
+        case 2:
+            for (unsigned int k = 0; k < m; ++k)
+            {
+                cplx t = multiply(out[k + m], W[k * s]);
+                out[k + m] = out[k] - t;
+                out[k] += t;
+            }
+            break;
+        case 3:
+        {
+            // y1,2 = a - (b+c)/2 -/+ j sin(2pi/3) (b-c)
+            const double s3 = std::sin(2.0 * M_PI / 3.0);
+            for (unsigned int k = 0; k < m; ++k)
+            {
+                cplx a = out[k];
+                cplx b = multiply(out[k + m], W[k * s]);
+                cplx c = multiply(out[k + 2*m], W[2 * k * s]);
+                cplx sum = b + c, h = a - 0.5 * sum, t = s3 * (b - c);
+                out[k] = a + sum;
+                out[k + m] = cplx(h.real() + t.imag(), h.imag() - t.real());
+                out[k + 2*m] = cplx(h.real() - t.imag(), h.imag() + t.real());
+            }
+            break;
+        }
+        case 4:
+            for (unsigned int k = 0; k < m; ++k)
+            {
+                cplx a = out[k];
+                cplx b = multiply(out[k + m], W[k * s]);
+                cplx c = multiply(out[k + 2*m], W[2 * k * s]);
+                cplx d = multiply(out[k + 3*m], W[3 * k * s]);
+                cplx t0 = a + c, t1 = a - c, t2 = b + d, t3 = b - d;
+                out[k] = t0 + t2;
+                out[k + 2*m] = t0 - t2;
+                // t1 -/+ j t3
+                out[k + m] = cplx(t1.real() + t3.imag(), t1.imag() - t3.real());
+                out[k + 3*m] = cplx(t1.real() - t3.imag(), t1.imag() + t3.real());
+            }
+            break;
+        case 5:
+        {
+            // y1,4 = a + c1 (b+e) + c2 (c+d) -/+ j (s1 (b-e) + s2 (c-d))
+            // y2,3 = a + c2 (b+e) + c1 (c+d) -/+ j (s2 (b-e) - s1 (c-d))
+            const double c1 = std::cos(2.0 * M_PI / 5.0);
+            const double c2 = std::cos(4.0 * M_PI / 5.0);
+            const double s1 = std::sin(2.0 * M_PI / 5.0);
+            const double s2 = std::sin(4.0 * M_PI / 5.0);
+            for (unsigned int k = 0; k < m; ++k)
+            {
+                cplx a = out[k];
+                cplx b = multiply(out[k + m], W[k * s]);
+                cplx c = multiply(out[k + 2*m], W[2 * k * s]);
+                cplx d = multiply(out[k + 3*m], W[3 * k * s]);
+                cplx e = multiply(out[k + 4*m], W[4 * k * s]);
+                cplx sum1 = b + e, diff1 = b - e, sum2 = c + d, diff2 = c - d;
+                cplx base1 = a + c1 * sum1 + c2 * sum2;
+                cplx base2 = a + c2 * sum1 + c1 * sum2;
+                cplx r1 = s1 * diff1 + s2 * diff2;
+                cplx r2 = s2 * diff1 - s1 * diff2;
+                out[k] = a + sum1 + sum2;
+                out[k + m] = cplx(base1.real() + r1.imag(), base1.imag() - r1.real());
+                out[k + 4*m] = cplx(base1.real() - r1.imag(), base1.imag() + r1.real());
+                out[k + 2*m] = cplx(base2.real() + r2.imag(), base2.imag() - r2.real());
+                out[k + 3*m] = cplx(base2.real() - r2.imag(), base2.imag() + r2.real());
+            }
+            break;
+        }
+        }
+    }
+
+    /**
+     * Calculates FFT of any length using Bluestein's algorithm.
+     *
+     * The inverse transform needed for the convolution is computed
+     * by the forward one, as IFFT(Y) = conj(FFT(conj(Y))) / M.
+     *
+     * @param in N complex input values
+     * @param out N complex output values
+     */
+    void FftPlan::bluestein(const cplx* in, cplx* out) const
+    {
+        const unsigned int M = convolutionPlan->getLength();
+        std::vector<cplx> buffer(M);
+        for (unsigned int n = 0; n < N; ++n)
+        {
+            buffer[n] = multiply(in[n], chirp[n]);
+        }
+
+        convolutionPlan->transform(&buffer[0]);
+        for (unsigned int i = 0; i < M; ++i)
+        {
+            buffer[i] = std::conj(multiply(buffer[i], chirpSpectrum[i]));
+        }
+        convolutionPlan->transform(&buffer[0]);
+
+        for (unsigned int k = 0; k < N; ++k)
+        {
+            out[k] = multiply(std::conj(buffer[k]), chirp[k]);
+        }
+    }
+}
@@ -0,0 +1,192 @@
+/**
+ * @file FftPlan.h
+ *
+ * Precomputed FFT plans - header.
+ *
+ * A plan holds everything that depends only on the transform length:
+ * the bit-reversal permutation and twiddle factors for all stages.
+ * Plans are immutable once created, so a single plan can be shared by any
+ * number of Transform objects, also across threads.
+ *
+ * Lengths which are powers of 2 use radix-4 kernel. Other lengths are
+ * split into factors 2, 3, 4 and 5 (mixed-radix algorithm), and those
+ * with a larger prime factor are computed by Bluestein's algorithm,
+ * as a convolution using power-of-2 transforms.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#ifndef FFTPLAN_H
+#define FFTPLAN_H
+
+#include "global.h"
+#include "AlignedAllocator.h"
+#include "Cache.h"
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+namespace Aquila
+{
+    /**
+     * Possible FFT algorithms, chosen by the plan according to its length.
+     */
+    enum FftAlgorithm { FFT_RADIX_4, FFT_MIXED_RADIX, FFT_BLUESTEIN };
+
+
+    /**
+     * An immutable, precomputed FFT of a given length.
+     *
+     * Plans should be obtained through FftPlan::get(), which keeps
+     * a process-wide registry of plans keyed by the transform length.
+     * The registry is thread-safe and its plans are never rebuilt, so
+     * per-file setup cost is paid only once per process. Plans which
+     * are no longer needed can be dropped by releaseUnused(), and the
+     * registry can be bounded through getCache().
+     */
+    class AQUILA_EXPORT FftPlan
+    {
+    public:
+        /**
+         * Shared pointer to a plan, as returned from the registry.
+         */
+        typedef boost::shared_ptr<const FftPlan> PointerType;
+
+        /**
+         * Type of the plan registry, keyed by transform length.
+         */
+        typedef Cache<unsigned int, PointerType> CacheType;
+
+        explicit FftPlan(unsigned int length);
+
+        static PointerType get(unsigned int length);
+
+        static unsigned int releaseUnused();
+
+        static CacheType& getCache();
+
+        static unsigned int getFastLength(unsigned int minLength,
+                                          bool even = true);
+
+        /**
+         * Returns the transform length.
+         *
+         * @return number of complex points
+         */
+        unsigned int getLength() const { return N; }
+
+        /**
+         * Returns the algorithm used by this plan.
+         *
+         * @return one of FftAlgorithm values
+         */
+        FftAlgorithm getAlgorithm() const { return algorithm; }
+
+        /**
+         * Checks if the length is a power of 2.
+         *
+         * Only such plans provide bit-reversal table and butterflies().
+         *
+         * @return true for radix-4 plans
+         */
+        bool isPowerOf2() const { return FFT_RADIX_4 == algorithm; }
+
+        /**
+         * Returns the bit-reversal permutation table.
+         *
+         * Element i is the input index which goes to i-th position.
+         * Available only for power of 2 lengths.
+         *
+         * @return pointer to array of N indices
+         */
+        const unsigned int* getBitReversal() const { return &bitReversal[0]; }
+
+        /**
+         * Returns twiddle factors needed to split a packed real transform.
+         *
+         * A real signal of length 2N can be transformed as N complex points;
+         * splitting the result needs W_2N^k = exp(-j*pi*k/N), k < N.
+         *
+         * @return pointer to array of N complex factors
+         */
+        const cplx* getRealFftTwiddles() const { return &realTwiddles[0]; }
+
+        void transform(cplx* data) const;
+
+        void transform(const cplx* in, cplx* out) const;
+
+        void inverseTransform(const cplx* in, cplx* out) const;
+
+        void butterflies(double* re, double* im) const;
+
+        void butterflies(double* re, double* im, unsigned int batch) const;
+
+    private:
+        /**
+         * Transform length.
+         */
+        unsigned int N;
+
+        /**
+         * Algorithm chosen for the length.
+         */
+        FftAlgorithm algorithm;
+
+        /**
+         * Number of radix-2 stages, log2(N) (only for powers of 2).
+         */
+        unsigned int numStages;
+
+        /**
+         * Bit-reversal permutation.
+         */
+        std::vector<unsigned int> bitReversal;
+
+        /**
+         * Twiddle factors of all radix-4 stages, in split format.
+         *
+         * For each stage combining sub-transforms of length m, there are
+         * six arrays of m values: real and imaginary parts of W^p, W^2p
+         * and W^3p (W = W_4m), p < m.
+         */
+        alignedVectorType twiddles;
+
+        /**
+         * Twiddle factors for real-input transform of length 2N.
+         */
+        std::vector<cplx> realTwiddles;
+
+        /**
+         * Mixed-radix factorization as (radix, remaining length) pairs.
+         */
+        std::vector<unsigned int> factors;
+
+        /**
+         * Roots of unity W_N^k, k < N, used by mixed-radix butterflies.
+         */
+        std::vector<cplx> roots;
+
+        /**
+         * Bluestein chirp exp(-j*pi*n^2/N), n < N.
+         */
+        std::vector<cplx> chirp;
+
+        /**
+         * Transform of the Bluestein convolution kernel, divided by its length.
+         */
+        std::vector<cplx> chirpSpectrum;
+
+        /**
+         * Power of 2 plan computing the Bluestein convolution.
+         */
+        PointerType convolutionPlan;
+
+        void mixedRadix(cplx* out, const cplx* in, unsigned int inStride,
+                        const unsigned int* factor) const;
+        void bluestein(const cplx* in, cplx* out) const;
+    };
+}
+
+#endif // FFTPLAN_H
@@ -4,7 +4,8 @@
  * Handling signal frames - header.
  *
  * The Frame class wraps a signal frame (short fragment of a signal).
- * Frame samples are accessed by STL-compatible iterators.
+ * Frame samples are accessed by STL-compatible iterators, by index or as
+ * a span.
  *
  * @author Zbigniew Siciarz
  * @date 2007-2010
@@ -16,6 +17,8 @@
 #define FRAME_H
 
 #include "global.h"
+#include "SampleSpan.h"
+#include <cstddef>
 #include <iterator>
 #include <vector>
 
@@ -33,11 +36,16 @@ namespace Aquila
 	    /**
          * Iterator class enabling frame data access.
 	     *
-         * It is a forward iterator with a range from the first sample in the
-         * frame to "one past last" sample.
+         * The range is from the first sample in the frame to "one past
+         * last" sample. Samples are read by value through the frame span,
+         * so that frames of any sample format can be iterated; there is no
+         * sample object to refer to, so this is an input iterator. It can
+         * still be moved and compared like a random access one. Use
+         * getSamples() for a pointer to contiguous integer samples.
 	     */
         class AQUILA_EXPORT iterator :
-                std::iterator<std::forward_iterator_tag, int>
+                public std::iterator<std::input_iterator_tag, int,
+                                     std::ptrdiff_t, void, int>
 	    {
 	    public:
             /**
@@ -46,40 +54,140 @@ namespace Aquila
              * @param fr pointer to a frame on which the iterator will work
              * @param index sample index (in the global data source!)
              */
-            explicit iterator(const Frame* fr, unsigned int index = 0):
+            explicit iterator(const Frame* fr, sampleIndexType index = 0):
                 frame(fr), idx(index)
             {
             }
 
             /**
-             * Deletes an iterator - a no-op.
+             * Compares two iterators for equality.
+             *
+             * Iterators are equal only when they belong to the same frame
+             * and point to the same sample in the source.
+             */
+            bool operator==(const iterator& other) const
+                { return frame == other.frame && idx == other.idx; }
+
+            /**
+             * Compares two iterators for inequality.
+             */
+            bool operator!=(const iterator& other) const
+                { return !operator==(other); }
+
+            /**
+             * Checks whether the iterator points before another one.
+             */
+            bool operator<(const iterator& other) const
+                { return idx < other.idx; }
+            bool operator>(const iterator& other) const
+                { return idx > other.idx; }
+            bool operator<=(const iterator& other) const
+                { return idx <= other.idx; }
+            bool operator>=(const iterator& other) const
+                { return idx >= other.idx; }
+
+            /**
+             * Moves the iterator one sample to the right.
+             */
+            iterator& operator++() { ++idx; return *this; }
+            iterator operator++(int)
+                { iterator tmp(*this); ++idx; return tmp; }
+
+            /**
+             * Moves the iterator one sample to the left.
              */
-            ~iterator() {}
+            iterator& operator--() { --idx; return *this; }
+            iterator operator--(int)
+                { iterator tmp(*this); --idx; return tmp; }
 
-	        iterator& operator=(const iterator& other);
-	        bool operator==(const iterator& other) const;
-	        bool operator!=(const iterator& other) const;
-	        iterator& operator++();
-	        iterator operator++(int);
-	        const int& operator*() const;
+            /**
+             * Moves the iterator by n samples.
+             */
+            iterator& operator+=(std::ptrdiff_t n) { idx += n; return *this; }
+            iterator& operator-=(std::ptrdiff_t n) { idx -= n; return *this; }
+            iterator operator+(std::ptrdiff_t n) const
+                { return iterator(frame, idx + n); }
+            iterator operator-(std::ptrdiff_t n) const
+                { return iterator(frame, idx - n); }
+            friend iterator operator+(std::ptrdiff_t n, const iterator& it)
+                { return it + n; }
+
+            /**
+             * Returns the distance between two iterators of a frame.
+             */
+            std::ptrdiff_t operator-(const iterator& other) const
+            {
+                return static_cast<std::ptrdiff_t>(idx) -
+                    static_cast<std::ptrdiff_t>(other.idx);
+            }
 
-	        unsigned int getPosition() const;
+            /**
+             * Dereferences the iterator.
+             *
+             * @return signal sample value (a copy, not a reference)
+             */
+            int operator*() const
+                { return frame->samples[idx - frame->_begin]; }
+
+            /**
+             * Returns a sample n positions after the iterator.
+             */
+            int operator[](std::ptrdiff_t n) const { return *(*this + n); }
+
+            /**
+             * Returns the distance between iterator and the beginning of
+             * the frame.
+             *
+             * @return number of samples between beginning and current
+             * position
+             */
+            unsigned int getPosition() const
+                { return static_cast<unsigned int>(idx - frame->_begin); }
 
 	    private:
             const Frame* frame;
-	        unsigned int idx;
+	        sampleIndexType idx;
 	    };
 
 
-		Frame(const std::vector<int>& source, unsigned int indexBegin,
-		        unsigned int indexEnd);
+        /**
+         * Creates the frame object - sets signal source and frame boundaries.
+         *
+         * Frame should not change original data, so the source is a const
+         * reference. Samples can be of any type listed in SampleTraits.
+         *
+         * @param source const reference to signal source
+         * @param indexBegin position of the first frame sample in the source
+         * @param indexEnd position one past the last frame sample
+         */
+        template <typename T>
+        Frame(const std::vector<T>& source, sampleIndexType indexBegin,
+              sampleIndexType indexEnd):
+            _begin(indexBegin), _end(indexEnd),
+            samples(SampleSpan::of(
+                source.empty() ? 0 : &source[0] + indexBegin,
+                indexEnd - indexBegin))
+        {
+        }
+
+        Frame(const SampleSpan& source, sampleIndexType indexBegin,
+              sampleIndexType indexEnd);
 
         /**
          * Returns the frame length.
          *
          * @return frame length as a number of samples
          */
-        unsigned int getLength() const { return _end - _begin; }
+        unsigned int getLength() const
+            { return static_cast<unsigned int>(_end - _begin); }
+
+        /**
+         * Returns position of the frame in the signal source.
+         *
+         * @return index of the first frame sample in the source
+         * @since 2.6.0
+         */
+        sampleIndexType getBegin() const { return _begin; }
 
         /**
          * Returns an iterator pointing to the first sample in the frame.
@@ -89,18 +197,51 @@ namespace Aquila
         /**
          * Returns an iterator pointing to the "one past last" sample.
          */
-        iterator end() const { return iterator(this, _end + 1); }
+        iterator end() const { return iterator(this, _end); }
+
+        /**
+         * Returns a frame sample.
+         *
+         * @param i sample index within the frame, less than getLength()
+         * @return sample value
+         * @since 2.6.0
+         */
+        int operator[](unsigned int i) const { return samples[i]; }
+
+        /**
+         * Returns a pointer to the first sample in the frame.
+         *
+         * Available only for frames of contiguous integer samples, such as
+         * channel vectors; other frames should be read through getSpan().
+         *
+         * @return pointer to getLength() samples, or 0
+         * @since 2.6.0
+         */
+        const int* getSamples() const
+        {
+            return (SAMPLE_INT32 == samples.format && 1 == samples.stride) ?
+                static_cast<const int*>(samples.data) : 0;
+        }
+
+        /**
+         * Returns a view of the frame samples.
+         *
+         * @return span of getLength() samples
+         * @since 2.6.0
+         */
+        const SampleSpan& getSpan() const { return samples; }
 
 	private:
         /**
-         * First and last sample of this frame in the data array/vector.
+         * First and "one past last" sample of this frame in the data
+         * array/vector.
          */
-        unsigned int _begin, _end;
+        sampleIndexType _begin, _end;
 
         /**
-         * A const reference to signal source (audio channel).
+         * View of the frame samples in signal source (audio channel).
          */
-        const std::vector<int>& sourceChannel;
+        SampleSpan samples;
 	};
 }
 
@@ -0,0 +1,161 @@
+/**
+ * @file FrameReader.cpp
+ *
+ * Streaming frame division - implementation.
+ *
+ * FrameReader divides a recording read by WaveReader into frames,
+ * block after block, keeping only the samples of the current block
+ * of frames in memory.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#include "FrameReader.h"
+
+#include "Exceptions.h"
+#include "SampleSpan.h"
+#include <algorithm>
+
+namespace Aquila
+{
+    /**
+     * Prepares frame division of a recording.
+     *
+     * @param waveReader source of the samples, must outlive the frame reader
+     * @param frameLengthMs frame length in milliseconds
+     * @param frameOverlap overlap between adjacent frames
+     * @param sourceChannel which channel to divide into frames
+     * @param framesPerBlock maximum number of frames returned at once
+     * @throw Aquila::Exception channel not in the recording or frames
+     * which do not advance
+     */
+    FrameReader::FrameReader(WaveReader& waveReader, unsigned int frameLengthMs,
+                             double frameOverlap, unsigned int sourceChannel,
+                             unsigned int framesPerBlock):
+        reader(waveReader), channel(sourceChannel), samplesPerFrame(0),
+        samplesPerNonOverlap(0), framesCount(0), blockFrames(framesPerBlock),
+        firstFrame(0), framesRead(0), paddingType(PADDING_POWER_OF_2),
+        bufferStart(0)
+    {
+        if (channel >= reader.getChannelsNum())
+        {
+            throw Exception("Recording has no such channel!");
+        }
+        outputs.assign(reader.getChannelsNum(), static_cast<int*>(0));
+
+        const WaveHeader& hdr = reader.getHeader();
+        unsigned int bytesPerFrame = static_cast<unsigned int>(
+                hdr.BytesPerSec * frameLengthMs / 1000.0);
+        samplesPerFrame = bytesPerFrame / hdr.BytesPerSamp;
+        samplesPerNonOverlap = static_cast<unsigned int>(
+                samplesPerFrame * (1 - frameOverlap));
+        if (0 == samplesPerNonOverlap)
+        {
+            throw Exception("Frames do not advance, check frame length "
+                            "and overlap!");
+        }
+
+        // the same frames as in WaveFile::divideFrames(), where a frame
+        // must end before the end of the channel
+        const sampleIndexType size = reader.getSamplesCount();
+        if (size > samplesPerFrame)
+        {
+            framesCount = static_cast<unsigned int>(std::min(
+                size / samplesPerNonOverlap,
+                (size - samplesPerFrame - 1) / samplesPerNonOverlap + 1));
+        }
+
+        frameObjects.reserve(blockFrames);
+        frames.reserve(blockFrames);
+        rewind();
+    }
+
+    /**
+     * Reads next block of frames.
+     *
+     * Only the samples not read with previous blocks are read from the
+     * source, so the reader must not be used by anyone else in between.
+     *
+     * @return number of frames in the block, 0 after the last block
+     * @throw Aquila::Exception when the recording ends prematurely
+     */
+    unsigned int FrameReader::readFrames()
+    {
+        firstFrame = framesRead;
+        frameObjects.clear();
+        frames.clear();
+        if (framesRead >= framesCount)
+            return 0;
+
+        const unsigned int count = std::min(blockFrames,
+                                            framesCount - framesRead);
+        const sampleIndexType begin =
+            static_cast<sampleIndexType>(framesRead) * samplesPerNonOverlap;
+        const sampleIndexType end = begin +
+            static_cast<sampleIndexType>(count - 1) * samplesPerNonOverlap +
+            samplesPerFrame;
+
+        // move samples shared with the previous block to the front
+        const sampleIndexType bufferEnd = bufferStart + buffer.size();
+        if (begin < bufferEnd)
+        {
+            buffer.erase(buffer.begin(),
+                         buffer.begin() + (begin - bufferStart));
+        }
+        else
+        {
+            buffer.clear();
+            if (begin > bufferEnd)
+                reader.seek(begin);
+        }
+        bufferStart = begin;
+
+        const unsigned int kept = buffer.size();
+        const unsigned int blockSize = static_cast<unsigned int>(end - begin);
+        const unsigned int needed = blockSize - kept;
+        buffer.resize(blockSize);
+        if (needed > 0)
+        {
+            // other channels are skipped by the reader
+            outputs[channel] = &buffer[kept];
+            sampleIndexType done = reader.read(&outputs[0], needed);
+            if (done < needed)
+            {
+                throw Exception("Unexpected end of file " +
+                                reader.getFilename());
+            }
+        }
+
+        SampleSpan span(&buffer[0], SAMPLE_INT32, buffer.size());
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            unsigned int frameBegin = i * samplesPerNonOverlap;
+            frameObjects.push_back(Frame(span, frameBegin,
+                                         frameBegin + samplesPerFrame));
+        }
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            frames.push_back(&frameObjects[i]);
+        }
+
+        framesRead += count;
+        return count;
+    }
+
+    /**
+     * Goes back to the first frame.
+     */
+    void FrameReader::rewind()
+    {
+        reader.seek(0);
+        buffer.clear();
+        bufferStart = 0;
+        firstFrame = 0;
+        framesRead = 0;
+        frameObjects.clear();
+        frames.clear();
+    }
+}
@@ -0,0 +1,196 @@
+/**
+ * @file FrameReader.h
+ *
+ * Streaming frame division - header.
+ *
+ * FrameReader divides a recording read by WaveReader into frames,
+ * block after block, keeping only the samples of the current block
+ * of frames in memory.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#ifndef FRAMEREADER_H
+#define FRAMEREADER_H
+
+#include "global.h"
+#include "Frame.h"
+#include "WaveFile.h"
+#include "WaveReader.h"
+#include <string>
+#include <vector>
+
+namespace Aquila
+{
+    /**
+     * Default number of frames in a block returned by readFrames().
+     */
+    const unsigned int DEFAULT_FRAMES_PER_BLOCK = 256;
+
+    /**
+     * Frames of a recording, read block by block.
+     *
+     * Frames are the same as those of a WaveFile with equal frame length
+     * and overlap. Samples shared by the last frames of a block and the
+     * first frames of the next one are kept between blocks.
+     */
+    class AQUILA_EXPORT FrameReader
+    {
+    public:
+        FrameReader(WaveReader& waveReader, unsigned int frameLengthMs,
+                    double frameOverlap = 0.66,
+                    unsigned int sourceChannel = LEFT_CHANNEL,
+                    unsigned int framesPerBlock = DEFAULT_FRAMES_PER_BLOCK);
+
+        unsigned int readFrames();
+
+        void rewind();
+
+        /**
+         * Returns frames of the current block.
+         *
+         * Frames view an internal buffer and are valid until next call
+         * to readFrames() or rewind(). Sample indices of frame iterators
+         * are relative to the block.
+         *
+         * @return pointers to frames read by the last readFrames()
+         */
+        const std::vector<Frame*>& getFrames() const { return frames; }
+
+        /**
+         * Returns number of the first frame of the current block.
+         *
+         * @return frame number in the whole recording
+         */
+        unsigned int getFirstFrame() const { return firstFrame; }
+
+        /**
+         * Returns number of frames in the recording.
+         *
+         * @return total number of frames in all blocks
+         */
+        unsigned int getFramesCount() const { return framesCount; }
+
+        /**
+         * Returns number of samples in a single frame.
+         *
+         * @return samples per frame
+         */
+        unsigned int getSamplesPerFrame() const { return samplesPerFrame; }
+
+        /**
+         * Returns frame length (in samples) after zero padding (ZP).
+         *
+         * @return padded frame length, depending on zero padding type
+         */
+        unsigned int getSamplesPerFrameZP() const
+        {
+            return WaveFile::getZeroPaddedLength(samplesPerFrame, paddingType);
+        }
+
+        /**
+         * Sets the way of choosing zero padded frame length.
+         *
+         * @param type zero padding type
+         */
+        void setZeroPadding(ZeroPaddingType type) { paddingType = type; }
+
+        /**
+         * Returns the way of choosing zero padded frame length.
+         *
+         * @return zero padding type
+         */
+        ZeroPaddingType getZeroPadding() const { return paddingType; }
+
+        /**
+         * Returns signal sample frequency.
+         *
+         * @return sample frequency in Hz
+         */
+        unsigned int getSampleFrequency() const
+            { return reader.getSampleFrequency(); }
+
+        /**
+         * Returns the filename.
+         *
+         * @return full path to the file being read
+         */
+        std::string getFilename() const { return reader.getFilename(); }
+
+    private:
+        /**
+         * Source of the samples.
+         */
+        WaveReader& reader;
+
+        /**
+         * Which channel is divided into frames.
+         */
+        unsigned int channel;
+
+        /**
+         * Number of samples per frame.
+         */
+        unsigned int samplesPerFrame;
+
+        /**
+         * Distance between beginnings of adjacent frames, in samples.
+         */
+        unsigned int samplesPerNonOverlap;
+
+        /**
+         * Total number of frames.
+         */
+        unsigned int framesCount;
+
+        /**
+         * Maximum number of frames in a block.
+         */
+        unsigned int blockFrames;
+
+        /**
+         * Number of the first frame of the current block.
+         */
+        unsigned int firstFrame;
+
+        /**
+         * Number of frames read so far.
+         */
+        unsigned int framesRead;
+
+        /**
+         * How the zero padded length is chosen.
+         */
+        ZeroPaddingType paddingType;
+
+        /**
+         * Samples of the current block.
+         */
+        std::vector<int> buffer;
+
+        /**
+         * Channel arrays passed to the reader, null except for the channel
+         * divided into frames.
+         */
+        std::vector<int*> outputs;
+
+        /**
+         * Number of the first buffered sample in the recording.
+         */
+        sampleIndexType bufferStart;
+
+        /**
+         * Frames of the current block and pointers to them.
+         */
+        std::vector<Frame> frameObjects;
+        std::vector<Frame*> frames;
+
+        FrameReader(const FrameReader&);
+        FrameReader& operator=(const FrameReader&);
+    };
+}
+
+#endif // FRAMEREADER_H
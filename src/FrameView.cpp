@@ -0,0 +1,43 @@
+/**
+ * @file FrameView.cpp
+ *
+ * Arithmetic frame division - implementation.
+ *
+ * FrameView describes the frames of a signal by their length and the
+ * distance between them, and creates Frame objects only on demand.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#include "FrameView.h"
+
+#include <algorithm>
+
+namespace Aquila
+{
+    /**
+     * Creates a view of frames of a signal source.
+     *
+     * Frames which would not end before the end of the source are left
+     * out, as in WaveFile frame division. A hop of 0 gives no frames.
+     *
+     * @param source view of the whole signal source
+     * @param frameLength number of samples per frame
+     * @param frameHop distance between beginnings of adjacent frames
+     */
+    FrameView::FrameView(const SampleSpan& source, unsigned int frameLength,
+                         unsigned int frameHop):
+        source(source), samplesPerFrame(frameLength), hop(frameHop),
+        framesCount(0)
+    {
+        const sampleIndexType size = source.length;
+        if (hop > 0 && size > samplesPerFrame)
+        {
+            framesCount = static_cast<unsigned int>(std::min(
+                size / hop, (size - samplesPerFrame - 1) / hop + 1));
+        }
+    }
+}
@@ -0,0 +1,117 @@
+/**
+ * @file FrameView.h
+ *
+ * Arithmetic frame division - header.
+ *
+ * FrameView describes the frames of a signal by their length and the
+ * distance between them, and creates Frame objects only on demand.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#ifndef FRAMEVIEW_H
+#define FRAMEVIEW_H
+
+#include "global.h"
+#include "Frame.h"
+#include "SampleSpan.h"
+
+namespace Aquila
+{
+    /**
+     * Frames of a signal source, computed from frame numbers.
+     *
+     * Frame i begins at sample i * hop and has a fixed number of samples;
+     * a frame must end before the end of the source. The view takes
+     * constant memory, regardless of the number of frames, and is cheap
+     * to copy. It is valid as long as the viewed samples are.
+     */
+    class AQUILA_EXPORT FrameView
+    {
+    public:
+        /**
+         * Creates a view without frames.
+         */
+        FrameView():
+            samplesPerFrame(0), hop(0), framesCount(0)
+        {
+        }
+
+        FrameView(const SampleSpan& source, unsigned int frameLength,
+                  unsigned int frameHop);
+
+        /**
+         * Returns a frame.
+         *
+         * @param i frame number, less than getFramesCount()
+         * @return frame viewing the source
+         */
+        Frame getFrame(unsigned int i) const
+        {
+            const sampleIndexType begin = static_cast<sampleIndexType>(i) * hop;
+            return Frame(source, begin, begin + samplesPerFrame);
+        }
+
+        /**
+         * Returns a frame.
+         *
+         * @param i frame number, less than getFramesCount()
+         * @return frame viewing the source
+         */
+        Frame operator[](unsigned int i) const { return getFrame(i); }
+
+        /**
+         * Returns number of frames.
+         *
+         * @return frame count
+         */
+        unsigned int getFramesCount() const { return framesCount; }
+
+        /**
+         * Returns number of samples in a single frame.
+         *
+         * @return samples per frame
+         */
+        unsigned int getSamplesPerFrame() const { return samplesPerFrame; }
+
+        /**
+         * Returns distance between beginnings of adjacent frames.
+         *
+         * @return hop size in samples
+         */
+        unsigned int getHop() const { return hop; }
+
+        /**
+         * Returns the divided signal source.
+         *
+         * @return view of the source samples
+         */
+        const SampleSpan& getSource() const { return source; }
+
+    private:
+        /**
+         * Samples divided into frames.
+         */
+        SampleSpan source;
+
+        /**
+         * Number of samples per frame.
+         */
+        unsigned int samplesPerFrame;
+
+        /**
+         * Distance between beginnings of adjacent frames, in samples.
+         */
+        unsigned int hop;
+
+        /**
+         * Number of frames.
+         */
+        unsigned int framesCount;
+    };
+}
+
+#endif // FRAMEVIEW_H
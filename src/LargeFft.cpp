@@ -0,0 +1,264 @@
+/**
+ * @file LargeFft.cpp
+ *
+ * Cache-blocked, multithreaded FFT of large signals - implementation.
+ *
+ * Transforms of a few million points do not fit in processor caches,
+ * and the long strides of the last radix-4 stages make every access
+ * a cache miss. The six-step algorithm splits an FFT of length N = N1*N2
+ * into N2 transforms of length N1, a multiplication by twiddle factors,
+ * N1 transforms of length N2 and a transposition. Each small transform
+ * fits in cache, and they are independent, so they run in parallel.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#include "LargeFft.h"
+
+#include "Exceptions.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace Aquila
+{
+    /**
+     * Number of adjacent columns transformed together.
+     */
+    static const unsigned int COLUMN_PANEL = 8;
+
+    /**
+     * Number of rows transformed by a single part of the row pass.
+     */
+    static const unsigned int ROW_BLOCK = 8;
+
+    /**
+     * Size of square tiles used in the transposition.
+     */
+    static const unsigned int TILE = 32;
+
+    /**
+     * One pass of the six-step algorithm, run by the thread pool.
+     */
+    class LargeFftTask : public ParallelTask
+    {
+    public:
+        /**
+         * Passes of the algorithm.
+         */
+        enum Pass { COLUMNS, ROWS, TRANSPOSE };
+
+        LargeFftTask(const LargeFft& fft, Pass pass, double* re, double* im,
+                     cplx* out, std::vector<alignedVectorType>& buffers):
+            fft(fft), pass(pass), re(re), im(im), out(out), buffers(buffers)
+        {
+        }
+
+        /**
+         * Runs a part of the pass, using buffers of the given thread.
+         */
+        void run(unsigned int index, unsigned int thread)
+        {
+            double* bufferRe = &buffers[2 * thread][0];
+            double* bufferIm = &buffers[2 * thread + 1][0];
+            switch (pass)
+            {
+            case COLUMNS:
+                fft.transformColumns(index, re, im, bufferRe, bufferIm);
+                break;
+            case ROWS:
+                fft.transformRows(index, re, im, bufferRe, bufferIm);
+                break;
+            case TRANSPOSE:
+                fft.transpose(index, re, im, out);
+                break;
+            }
+        }
+
+    private:
+        const LargeFft& fft;
+        Pass pass;
+        double* re;
+        double* im;
+        cplx* out;
+        std::vector<alignedVectorType>& buffers;
+    };
+
+    /**
+     * Splits the length and prepares sub-transform plans and twiddles.
+     *
+     * @param length transform length, a power of 2 not less than 1024
+     * @param pool threads running the sub-transforms
+     * @throw Aquila::Exception when length is not supported
+     */
+    LargeFft::LargeFft(unsigned int length, ThreadPool& pool):
+        N(length), N1(1), N2(1), shift(0), mask(0), pool(pool)
+    {
+        if (N < 1024 || (N & (N - 1)) != 0)
+        {
+            throw Exception("Large FFT length must be a power of 2 "
+                            "not less than 1024");
+        }
+
+        unsigned int log2N = 0;
+        while ((1u << log2N) < N)
+            ++log2N;
+
+        // columns are not longer than rows, so the column panels are small
+        N1 = 1u << (log2N / 2);
+        N2 = N / N1;
+        columnPlan = FftPlan::get(N1);
+        rowPlan = FftPlan::get(N2);
+
+        // W_N^m for any m < N is a product of two table values
+        shift = (log2N + 1) / 2;
+        mask = (1u << shift) - 1;
+        fineRoots.resize(1u << shift);
+        for (unsigned int m = 0; m < fineRoots.size(); ++m)
+        {
+            fineRoots[m] = std::polar(1.0, -2.0 * M_PI * m / double(N));
+        }
+        coarseRoots.resize(N >> shift);
+        for (unsigned int m = 0; m < coarseRoots.size(); ++m)
+        {
+            coarseRoots[m] = std::polar(1.0, -2.0 * M_PI * (m << shift) /
+                                        double(N));
+        }
+    }
+
+    /**
+     * Calculates unscaled FFT of split complex data.
+     *
+     * @param re N real parts in natural order, overwritten
+     * @param im N imaginary parts in natural order, overwritten
+     * @param out N complex spectrum values
+     */
+    void LargeFft::transform(double* re, double* im, cplx* out) const
+    {
+        const unsigned int threads = pool.getThreadsCount();
+        std::vector<alignedVectorType> buffers(2 * threads);
+        for (unsigned int i = 0; i < buffers.size(); ++i)
+        {
+            buffers[i].resize(std::max(N1 * COLUMN_PANEL, N2));
+        }
+
+        LargeFftTask columns(*this, LargeFftTask::COLUMNS, re, im, out,
+                             buffers);
+        pool.run(columns, N2 / COLUMN_PANEL);
+
+        LargeFftTask rows(*this, LargeFftTask::ROWS, re, im, out, buffers);
+        pool.run(rows, N1 / ROW_BLOCK);
+
+        LargeFftTask transposition(*this, LargeFftTask::TRANSPOSE, re, im, out,
+                                   buffers);
+        pool.run(transposition, N2 / TILE);
+    }
+
+    /**
+     * Transforms a panel of adjacent columns and applies twiddle factors.
+     *
+     * The panel is gathered in bit-reversed row order into a buffer,
+     * where the columns are interleaved, so they are computed as a batch.
+     * Element (k1, n2) of the result is multiplied by W_N^(n2*k1).
+     *
+     * @param panel panel number
+     * @param re real parts of the whole signal
+     * @param im imaginary parts of the whole signal
+     * @param bufferRe work buffer of N1 * COLUMN_PANEL values
+     * @param bufferIm work buffer of N1 * COLUMN_PANEL values
+     */
+    void LargeFft::transformColumns(unsigned int panel, double* re, double* im,
+                                    double* bufferRe, double* bufferIm) const
+    {
+        const unsigned int P = COLUMN_PANEL, first = panel * P;
+        const unsigned int* reversed = columnPlan->getBitReversal();
+        for (unsigned int i = 0; i < N1; ++i)
+        {
+            std::size_t offset = std::size_t(reversed[i]) * N2 + first;
+            std::copy(re + offset, re + offset + P, bufferRe + i * P);
+            std::copy(im + offset, im + offset + P, bufferIm + i * P);
+        }
+
+        columnPlan->butterflies(bufferRe, bufferIm, P);
+
+        for (unsigned int k1 = 0; k1 < N1; ++k1)
+        {
+            double* rowRe = re + std::size_t(k1) * N2 + first;
+            double* rowIm = im + std::size_t(k1) * N2 + first;
+            for (unsigned int b = 0; b < P; ++b)
+            {
+                unsigned int m = (first + b) * k1;
+                const cplx& c = coarseRoots[m >> shift];
+                const cplx& f = fineRoots[m & mask];
+                double wr = c.real() * f.real() - c.imag() * f.imag();
+                double wi = c.real() * f.imag() + c.imag() * f.real();
+                double xr = bufferRe[k1 * P + b], xi = bufferIm[k1 * P + b];
+                rowRe[b] = xr * wr - xi * wi;
+                rowIm[b] = xr * wi + xi * wr;
+            }
+        }
+    }
+
+    /**
+     * Transforms a block of adjacent rows in place.
+     *
+     * @param block block number
+     * @param re real parts of the whole signal
+     * @param im imaginary parts of the whole signal
+     * @param bufferRe work buffer of N2 values
+     * @param bufferIm work buffer of N2 values
+     */
+    void LargeFft::transformRows(unsigned int block, double* re, double* im,
+                                 double* bufferRe, double* bufferIm) const
+    {
+        const unsigned int* reversed = rowPlan->getBitReversal();
+        for (unsigned int k1 = block * ROW_BLOCK; k1 < (block + 1) * ROW_BLOCK;
+             ++k1)
+        {
+            double* rowRe = re + std::size_t(k1) * N2;
+            double* rowIm = im + std::size_t(k1) * N2;
+            for (unsigned int i = 0; i < N2; ++i)
+            {
+                bufferRe[i] = rowRe[reversed[i]];
+                bufferIm[i] = rowIm[reversed[i]];
+            }
+
+            rowPlan->butterflies(bufferRe, bufferIm);
+
+            std::copy(bufferRe, bufferRe + N2, rowRe);
+            std::copy(bufferIm, bufferIm + N2, rowIm);
+        }
+    }
+
+    /**
+     * Writes a block of output values, X[k1 + N1*k2] = Y(k1, k2).
+     *
+     * The block covers TILE output rows (values of k2), and is copied
+     * in square tiles, so both sides are accessed in cache-sized pieces.
+     *
+     * @param block block number
+     * @param re real parts of the transformed matrix
+     * @param im imaginary parts of the transformed matrix
+     * @param out output spectrum
+     */
+    void LargeFft::transpose(unsigned int block, const double* re,
+                             const double* im, cplx* out) const
+    {
+        const unsigned int firstK2 = block * TILE;
+        for (unsigned int tile = 0; tile < N1; tile += TILE)
+        {
+            for (unsigned int k2 = firstK2; k2 < firstK2 + TILE; ++k2)
+            {
+                cplx* outRow = out + std::size_t(k2) * N1;
+                for (unsigned int k1 = tile; k1 < tile + TILE; ++k1)
+                {
+                    std::size_t i = std::size_t(k1) * N2 + k2;
+                    outRow[k1] = cplx(re[i], im[i]);
+                }
+            }
+        }
+    }
+}
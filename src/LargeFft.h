@@ -0,0 +1,96 @@
+/**
+ * @file LargeFft.h
+ *
+ * Cache-blocked, multithreaded FFT of large signals - header.
+ *
+ * Transforms of a few million points do not fit in processor caches,
+ * and the long strides of the last radix-4 stages make every access
+ * a cache miss. The six-step algorithm splits an FFT of length N = N1*N2
+ * into N2 transforms of length N1, a multiplication by twiddle factors,
+ * N1 transforms of length N2 and a transposition. Each small transform
+ * fits in cache, and they are independent, so they run in parallel.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#ifndef LARGEFFT_H
+#define LARGEFFT_H
+
+#include "global.h"
+#include "FftPlan.h"
+#include "ThreadPool.h"
+#include <vector>
+
+namespace Aquila
+{
+    /**
+     * Power of 2 transforms from this length on use LargeFft.
+     */
+    const unsigned int LARGE_FFT_MIN_LENGTH = 1u << 16;
+
+
+    /**
+     * Six-step FFT of a large power of 2 length.
+     *
+     * The signal is seen as a matrix of N1 rows and N2 columns, stored
+     * row by row. Columns are transformed in panels of a few adjacent
+     * columns, which are read row by row, so the memory is accessed
+     * sequentially. Rows are then transformed in place, and the result
+     * is transposed to the output.
+     *
+     * The object does not build the full tables of an FftPlan of length
+     * N, only small plans of lengths N1 and N2 and O(sqrt(N)) twiddles.
+     */
+    class AQUILA_EXPORT LargeFft
+    {
+    public:
+        explicit LargeFft(unsigned int length,
+                          ThreadPool& pool = ThreadPool::getDefault());
+
+        /**
+         * Returns the transform length.
+         *
+         * @return number of complex points
+         */
+        unsigned int getLength() const { return N; }
+
+        void transform(double* re, double* im, cplx* out) const;
+
+    private:
+        friend class LargeFftTask;
+
+        /**
+         * Transform length and its factors: column and row length.
+         */
+        unsigned int N, N1, N2;
+
+        /**
+         * Plans of column and row transforms.
+         */
+        FftPlan::PointerType columnPlan, rowPlan;
+
+        /**
+         * Twiddle factors, W_N^m is the product of coarseRoots[m >> shift]
+         * and fineRoots[m & mask].
+         */
+        std::vector<cplx> coarseRoots, fineRoots;
+        unsigned int shift, mask;
+
+        /**
+         * Threads running the sub-transforms.
+         */
+        ThreadPool& pool;
+
+        void transformColumns(unsigned int panel, double* re, double* im,
+                              double* bufferRe, double* bufferIm) const;
+        void transformRows(unsigned int block, double* re, double* im,
+                           double* bufferRe, double* bufferIm) const;
+        void transpose(unsigned int block, const double* re,
+                       const double* im, cplx* out) const;
+    };
+}
+
+#endif // LARGEFFT_H
@@ -0,0 +1,65 @@
+/**
+ * @file MappedFile.cpp
+ *
+ * Read-only memory-mapped files - implementation.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#include "MappedFile.h"
+
+#include "Exceptions.h"
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace Aquila
+{
+    /**
+     * Portable file mapping objects, hidden from the header.
+     */
+    struct MappedFile::Mapping
+    {
+        explicit Mapping(const std::string& filename):
+            file(filename.c_str(), boost::interprocess::read_only),
+            region(file, boost::interprocess::read_only)
+        {
+        }
+
+        boost::interprocess::file_mapping file;
+        boost::interprocess::mapped_region region;
+    };
+
+    /**
+     * Maps the whole file into memory.
+     *
+     * @param filename full path to the file
+     * @throw Aquila::Exception when the file cannot be mapped
+     */
+    MappedFile::MappedFile(const std::string& filename):
+        mapping(0), data(0), size(0)
+    {
+        try
+        {
+            mapping = new Mapping(filename);
+        }
+        catch (const boost::interprocess::interprocess_exception& e)
+        {
+            throw Exception("Cannot map file " + filename + ": " + e.what());
+        }
+
+        data = static_cast<const char*>(mapping->region.get_address());
+        size = mapping->region.get_size();
+    }
+
+    /**
+     * Unmaps the file.
+     */
+    MappedFile::~MappedFile()
+    {
+        delete mapping;
+    }
+}
@@ -0,0 +1,65 @@
+/**
+ * @file MappedFile.h
+ *
+ * Read-only memory-mapped files - header.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include "global.h"
+#include <cstddef>
+#include <string>
+
+namespace Aquila
+{
+    /**
+     * A whole file mapped read-only into memory.
+     *
+     * File contents are read by the operating system on first access,
+     * page by page, and are never copied to the process heap.
+     */
+    class AQUILA_EXPORT MappedFile
+    {
+    public:
+        explicit MappedFile(const std::string& filename);
+        ~MappedFile();
+
+        /**
+         * Returns the mapped contents.
+         *
+         * @return pointer to getSize() bytes
+         */
+        const char* getData() const { return data; }
+
+        /**
+         * Returns the file size.
+         *
+         * @return number of bytes
+         */
+        std::size_t getSize() const { return size; }
+
+    private:
+        /**
+         * Operating system objects of the mapping.
+         */
+        struct Mapping;
+        Mapping* mapping;
+
+        /**
+         * Mapped contents and their size.
+         */
+        const char* data;
+        std::size_t size;
+
+        MappedFile(const MappedFile&);
+        MappedFile& operator=(const MappedFile&);
+    };
+}
+
+#endif // MAPPEDFILE_H
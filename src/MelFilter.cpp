@@ -11,6 +11,7 @@
 
 #include "MelFilter.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace Aquila
@@ -134,4 +135,19 @@ namespace Aquila
             filterSpectrum[k] = value;
         }
     }
+
+    /**
+     * Fills the filter spectrum with precomputed values.
+     *
+     * @param begin first nonzero spectrum bin
+     * @param count number of values
+     * @param values nonzero part of the spectrum
+     * @param N spectrum size
+     */
+    void MelFilter::setFilterSpectrum(unsigned int begin, unsigned int count,
+                                      const double* values, unsigned int N)
+    {
+        filterSpectrum.assign(N, 0.0);
+        std::copy(values, values + count, filterSpectrum.begin() + begin);
+    }
 }
@@ -89,6 +89,9 @@ namespace Aquila
 
         void generateFilterSpectrum(double minFreq, double centerFreq,
                                     double maxFreq, unsigned int N);
+
+        void setFilterSpectrum(unsigned int begin, unsigned int count,
+                               const double* values, unsigned int N);
     };
 }
 
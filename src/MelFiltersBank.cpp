@@ -10,12 +10,36 @@
  */
 
 #include "MelFiltersBank.h"
+#include "PrecomputedTables.h"
 
 namespace Aquila
 {
+    /**
+     * Creates a bank for the cache.
+     *
+     * @param key bank parameters
+     * @return shared pointer to new bank
+     */
+    static MelFiltersBank::PointerType createBank(
+        const MelFiltersBank::KeyType& key)
+    {
+        if (key.isHfcc)
+            return MelFiltersBank::PointerType(
+                new MelFiltersBank(key.sampleFrequency, key.N, true));
+        return MelFiltersBank::PointerType(
+            new MelFiltersBank(key.sampleFrequency, key.melFilterWidth, key.N));
+    }
+
+    /**
+     * Cache of filter banks used by feature extractors.
+     */
+    static MelFiltersBank::CacheType s_banks(&createBank);
+
     /**
      * Creates all the filters in the bank.
      *
+     * Filters compiled into the library are used when available.
+     *
      * @param sampleFrequency sample frequency in Hz
      * @param melFilterWidth filter width in Mel frequency scale
      * @param N spectrum size of each filter
@@ -25,11 +49,24 @@ namespace Aquila
                                    unsigned int N):
         sampleFreq(sampleFrequency), N_(N)
     {
+        const PrecomputedMelBank* bank =
+            PrecomputedTables::findMelBank(sampleFrequency, melFilterWidth, N);
+        const double* values = bank ? bank->values : 0;
+
         filters.reserve(MELFILTERS);
         for (unsigned int i = 0; i < MELFILTERS; ++i)
         {
             filters.push_back(new MelFilter(sampleFrequency));
-            filters[i]->createFilter(i, melFilterWidth, N);
+            if (bank)
+            {
+                filters[i]->setFilterSpectrum(bank->begins[i], bank->lengths[i],
+                                              values, N);
+                values += bank->lengths[i];
+            }
+            else
+            {
+                filters[i]->createFilter(i, melFilterWidth, N);
+            }
         }
     }
 
@@ -108,7 +145,10 @@ namespace Aquila
      *
      * The output vector must be initialized and its size must be MELFILTERS.
      *
-     * @param frameSpectrum frame spectrum
+     * Only the first N/2 bins of the spectrum are used, so it is enough
+     * to pass the half spectrum calculated by Transform::rfft().
+     *
+     * @param frameSpectrum frame spectrum (full or N/2+1 bins)
      * @param N spectrum size
      * @param filtersOutput results vector
      */
@@ -123,9 +163,46 @@ namespace Aquila
             frameAbsSpectrum.push_back(std::abs(frameSpectrum[i]));
         }
 
+        applyAll(frameAbsSpectrum, N, filtersOutput);
+    }
+
+    /**
+     * Processes magnitude of frame spectrum through all filters.
+     *
+     * Magnitude spectrum can be calculated directly by Transform::rfft()
+     * with MAGNITUDE_ABS, which avoids storing complex spectrum at all.
+     *
+     * @param frameAbsSpectrum magnitude of frame spectrum
+     * @param N spectrum size
+     * @param filtersOutput results vector
+     */
+    void MelFiltersBank::applyAll(const std::vector<double>& frameAbsSpectrum,
+                                  unsigned int N,
+                                  std::vector<double>& filtersOutput) const
+    {
+        applyAll(frameAbsSpectrum, N, filtersOutput, 0);
+    }
+
+    /**
+     * Processes magnitude of frame spectrum through selected filters.
+     *
+     * The selection is combined with filters enabled in the bank itself,
+     * so that a shared bank can serve different selections.
+     *
+     * @param frameAbsSpectrum magnitude of frame spectrum
+     * @param N spectrum size
+     * @param filtersOutput results vector
+     * @param enabledFilters MELFILTERS flags, or 0 to use all filters
+     * @since 2.6.0
+     */
+    void MelFiltersBank::applyAll(const std::vector<double>& frameAbsSpectrum,
+                                  unsigned int N,
+                                  std::vector<double>& filtersOutput,
+                                  const bool enabledFilters[]) const
+    {
         for (unsigned int i = 0; i < MELFILTERS; ++i)
         {
-            if (filters[i]->isEnabled())
+            if (filters[i]->isEnabled() && (!enabledFilters || enabledFilters[i]))
                 filtersOutput[i] = filters[i]->apply(frameAbsSpectrum, N);
             else
                 filtersOutput[i] = 0.0;
@@ -145,5 +222,49 @@ namespace Aquila
         for (unsigned int i = 0; i < MELFILTERS; ++i)
             filters[i]->setEnabled(enabledFilters[i]);
     }
-}
 
+    /**
+     * Returns a shared bank of Mel filters.
+     *
+     * The bank is created on first request and then cached. This method
+     * can be safely called from many threads.
+     *
+     * @param sampleFrequency sample frequency in Hz
+     * @param melFilterWidth filter width in Mel frequency scale
+     * @param N spectrum size of each filter
+     * @return shared pointer to immutable bank
+     * @since 2.6.0
+     */
+    MelFiltersBank::PointerType MelFiltersBank::getMel(
+        double sampleFrequency, unsigned short melFilterWidth, unsigned int N)
+    {
+        KeyType key = {sampleFrequency, N, melFilterWidth, false};
+        return s_banks.get(key);
+    }
+
+    /**
+     * Returns a shared bank of filters tweaked for HFCC calculation.
+     *
+     * @param sampleFrequency sample frequency in Hz
+     * @param N spectrum size of each filter
+     * @return shared pointer to immutable bank
+     * @since 2.6.0
+     */
+    MelFiltersBank::PointerType MelFiltersBank::getHfcc(
+        double sampleFrequency, unsigned int N)
+    {
+        KeyType key = {sampleFrequency, N, 0, true};
+        return s_banks.get(key);
+    }
+
+    /**
+     * Returns the bank cache, eg. to read its statistics or bound its size.
+     *
+     * @return reference to the bank cache
+     * @since 2.6.0
+     */
+    MelFiltersBank::CacheType& MelFiltersBank::getCache()
+    {
+        return s_banks;
+    }
+}
@@ -13,17 +13,65 @@
 #define MELFILTERSBANK_H
 
 #include "global.h"
+#include "Cache.h"
 #include "MelFilter.h"
 #include <vector>
+#include <boost/functional/hash.hpp>
+#include <boost/shared_ptr.hpp>
 
 namespace Aquila
 {
     /**
      * A wrapper class for a vector of triangular filters.
+     *
+     * Banks depend only on sample frequency and spectrum size, so feature
+     * extractors share immutable banks through getMel() and getHfcc().
      */
     class AQUILA_EXPORT MelFiltersBank
     {
     public:
+        /**
+         * Shared pointer to a bank, as returned from the cache.
+         */
+        typedef boost::shared_ptr<const MelFiltersBank> PointerType;
+
+        /**
+         * Cache key - bank parameters.
+         */
+        struct KeyType
+        {
+            double sampleFrequency;
+            unsigned int N;
+            unsigned short melFilterWidth;
+            bool isHfcc;
+
+            bool operator<(const KeyType& other) const
+            {
+                if (sampleFrequency != other.sampleFrequency)
+                    return sampleFrequency < other.sampleFrequency;
+                if (N != other.N)
+                    return N < other.N;
+                if (melFilterWidth != other.melFilterWidth)
+                    return melFilterWidth < other.melFilterWidth;
+                return isHfcc < other.isHfcc;
+            }
+
+            friend std::size_t hash_value(const KeyType& key)
+            {
+                std::size_t seed = 0;
+                boost::hash_combine(seed, key.sampleFrequency);
+                boost::hash_combine(seed, key.N);
+                boost::hash_combine(seed, key.melFilterWidth);
+                boost::hash_combine(seed, key.isHfcc);
+                return seed;
+            }
+        };
+
+        /**
+         * Type of the bank cache.
+         */
+        typedef Cache<KeyType, PointerType> CacheType;
+
         MelFiltersBank(double sampleFrequency, unsigned short melFilterWidth,
                        unsigned int N);
         MelFiltersBank(double sampleFrequency, unsigned int N,
@@ -32,9 +80,22 @@ namespace Aquila
 
         void applyAll(spectrumType& frameSpectrum, unsigned int N,
                       std::vector<double>& filtersOutput) const;
+        void applyAll(const std::vector<double>& frameAbsSpectrum,
+                      unsigned int N,
+                      std::vector<double>& filtersOutput) const;
+        void applyAll(const std::vector<double>& frameAbsSpectrum,
+                      unsigned int N, std::vector<double>& filtersOutput,
+                      const bool enabledFilters[]) const;
 
         void setEnabledFilters(bool enabledFilters[]);
 
+        static PointerType getMel(double sampleFrequency,
+                                  unsigned short melFilterWidth,
+                                  unsigned int N);
+        static PointerType getHfcc(double sampleFrequency, unsigned int N);
+
+        static CacheType& getCache();
+
         /**
          * Returns sample frequency of all filters.
          *
@@ -64,6 +125,9 @@ namespace Aquila
          * Filter spectrum size (equal to zero-padded length of signal frame).
          */
         unsigned int N_;
+
+        MelFiltersBank(const MelFiltersBank&);
+        MelFiltersBank& operator=(const MelFiltersBank&);
     };
 }
 
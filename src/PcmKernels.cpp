@@ -0,0 +1,1307 @@
+/**
+ * @file PcmKernels.cpp
+ *
+ * Vectorized PCM decoding kernels - implementation.
+ *
+ * Kernels convert interleaved PCM data of a .wav file into channel
+ * samples: they deinterleave stereo data, widen samples to int and
+ * optionally mix both channels down to one. Every kernel is compiled for
+ * a few instruction sets and the version matching FftKernels::getLevel()
+ * is used, so FftKernels::setLevel() controls these kernels too.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#include "PcmKernels.h"
+
+#include "FftKernels.h"
+#include "SampleSpan.h"
+
+// the same conditions as in FftKernels.cpp
+#if !defined(AQUILA_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || (defined(__GNUC__) && \
+    (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define AQUILA_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace Aquila
+{
+    /**
+     * Splits 16-bit stereo samples into channels, plain C++ version.
+     */
+    template <typename T>
+    static void deinterleave16Scalar(const boost::int16_t* in,
+                                     unsigned int count, T* left, T* right)
+    {
+        if (left)
+        {
+            for (unsigned int i = 0; i < count; ++i)
+                left[i] = in[2*i];
+        }
+        if (right)
+        {
+            for (unsigned int i = 0; i < count; ++i)
+                right[i] = in[2*i+1];
+        }
+    }
+
+    /**
+     * Mixes 16-bit stereo samples down to mono, plain C++ version.
+     */
+    template <typename T>
+    static void downmix16Scalar(const boost::int16_t* in, unsigned int count,
+                                T* out)
+    {
+        for (unsigned int i = 0; i < count; ++i)
+            out[i] = static_cast<T>((in[2*i] + in[2*i+1]) >> 1);
+    }
+
+    /**
+     * Widens 16-bit mono samples, plain C++ version.
+     */
+    static void widen16Scalar(const boost::int16_t* in, unsigned int count,
+                              int* out)
+    {
+        for (unsigned int i = 0; i < count; ++i)
+            out[i] = in[i];
+    }
+
+    /**
+     * Splits unsigned 8-bit stereo samples into channels, plain C++ version.
+     */
+    static void deinterleave8Scalar(const boost::uint8_t* in,
+                                    unsigned int count, int* left, int* right)
+    {
+        if (left)
+        {
+            for (unsigned int i = 0; i < count; ++i)
+                left[i] = in[2*i] - 128;
+        }
+        if (right)
+        {
+            for (unsigned int i = 0; i < count; ++i)
+                right[i] = in[2*i+1] - 128;
+        }
+    }
+
+    /**
+     * Mixes unsigned 8-bit stereo samples down to mono, plain C++ version.
+     */
+    static void downmix8Scalar(const boost::uint8_t* in, unsigned int count,
+                               int* out)
+    {
+        for (unsigned int i = 0; i < count; ++i)
+            out[i] = (in[2*i] + in[2*i+1] - 256) >> 1;
+    }
+
+    /**
+     * Widens unsigned 8-bit mono samples, plain C++ version.
+     */
+    static void widen8Scalar(const boost::uint8_t* in, unsigned int count,
+                             int* out)
+    {
+        for (unsigned int i = 0; i < count; ++i)
+            out[i] = in[i] - 128;
+    }
+
+    /**
+     * Reads a packed little-endian 24-bit sample.
+     */
+    static inline int unpack24(const boost::uint8_t* p)
+    {
+        return static_cast<boost::int8_t>(p[2]) * 65536 + (p[1] << 8) + p[0];
+    }
+
+    /**
+     * Splits 24-bit stereo samples into channels, plain C++ version.
+     */
+    static void deinterleave24Scalar(const boost::uint8_t* in,
+                                     unsigned int count, int* left, int* right)
+    {
+        if (left)
+        {
+            for (unsigned int i = 0; i < count; ++i)
+                left[i] = unpack24(in + 6*i);
+        }
+        if (right)
+        {
+            for (unsigned int i = 0; i < count; ++i)
+                right[i] = unpack24(in + 6*i + 3);
+        }
+    }
+
+    /**
+     * Mixes 24-bit stereo samples down to mono, plain C++ version.
+     */
+    static void downmix24Scalar(const boost::uint8_t* in, unsigned int count,
+                                int* out)
+    {
+        for (unsigned int i = 0; i < count; ++i)
+            out[i] = (unpack24(in + 6*i) + unpack24(in + 6*i + 3)) >> 1;
+    }
+
+    /**
+     * Widens 24-bit mono samples, plain C++ version.
+     */
+    static void widen24Scalar(const boost::uint8_t* in, unsigned int count,
+                              int* out)
+    {
+        for (unsigned int i = 0; i < count; ++i)
+            out[i] = unpack24(in + 3*i);
+    }
+
+    /**
+     * Limits of floating point values converted to int, the same as in
+     * SampleSpan::roundSample().
+     */
+    const float FLOAT_TO_INT_MIN = -2147483648.0f;
+    const float FLOAT_TO_INT_MAX = 2147483520.0f;
+
+    /**
+     * Stores a floating point sample.
+     */
+    static inline void storeScaled(float value, float& out)
+    {
+        out = value;
+    }
+
+    /**
+     * Saturates a floating point sample and stores it rounded.
+     */
+    static inline void storeScaled(float value, int& out)
+    {
+        out = SampleSpan::roundSample(value);
+    }
+
+    /**
+     * Splits floating point stereo samples into channels, plain C++ version.
+     */
+    template <typename T>
+    static void deinterleaveFloatScalar(const float* in, unsigned int count,
+                                        float scale, T* left, T* right)
+    {
+        if (left)
+        {
+            for (unsigned int i = 0; i < count; ++i)
+                storeScaled(in[2*i] * scale, left[i]);
+        }
+        if (right)
+        {
+            for (unsigned int i = 0; i < count; ++i)
+                storeScaled(in[2*i+1] * scale, right[i]);
+        }
+    }
+
+    /**
+     * Mixes floating point stereo samples down to mono, plain C++ version.
+     */
+    template <typename T>
+    static void downmixFloatScalar(const float* in, unsigned int count,
+                                   float scale, T* out)
+    {
+        for (unsigned int i = 0; i < count; ++i)
+            storeScaled((in[2*i] * scale + in[2*i+1] * scale) * 0.5f, out[i]);
+    }
+
+    /**
+     * Scales floating point mono samples, plain C++ version.
+     */
+    template <typename T>
+    static void scaleFloatScalar(const float* in, unsigned int count,
+                                 float scale, T* out)
+    {
+        for (unsigned int i = 0; i < count; ++i)
+            storeScaled(in[i] * scale, out[i]);
+    }
+
+#ifdef AQUILA_X86_SIMD
+    /**
+     * Splits 16-bit stereo samples into int channels, SSE2 version.
+     *
+     * A 32-bit lane holds a sample pair, the left sample in its lower half.
+     */
+    __attribute__((target("sse2")))
+    static void deinterleave16Sse2(const boost::int16_t* in,
+                                   unsigned int count, int* left, int* right)
+    {
+        unsigned int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i v = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(in + 2*i));
+            if (left)
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(left + i),
+                                 _mm_srai_epi32(_mm_slli_epi32(v, 16), 16));
+            if (right)
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(right + i),
+                                 _mm_srai_epi32(v, 16));
+        }
+        deinterleave16Scalar(in + 2*i, count - i, left ? left + i : 0,
+                             right ? right + i : 0);
+    }
+
+    /**
+     * Splits 16-bit stereo samples into 16-bit channels, SSE2 version.
+     */
+    __attribute__((target("sse2")))
+    static void deinterleave16NativeSse2(const boost::int16_t* in,
+                                         unsigned int count,
+                                         boost::int16_t* left,
+                                         boost::int16_t* right)
+    {
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i a = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(in + 2*i));
+            __m128i b = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(in + 2*i + 8));
+            if (left)
+            {
+                __m128i la = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+                __m128i lb = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(left + i),
+                                 _mm_packs_epi32(la, lb));
+            }
+            if (right)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(right + i),
+                                 _mm_packs_epi32(_mm_srai_epi32(a, 16),
+                                                 _mm_srai_epi32(b, 16)));
+            }
+        }
+        deinterleave16Scalar(in + 2*i, count - i, left ? left + i : 0,
+                             right ? right + i : 0);
+    }
+
+    /**
+     * Mixes 16-bit stereo samples down to int mono, SSE2 version.
+     */
+    __attribute__((target("sse2")))
+    static void downmix16Sse2(const boost::int16_t* in, unsigned int count,
+                              int* out)
+    {
+        unsigned int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i v = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(in + 2*i));
+            __m128i sum = _mm_add_epi32(
+                _mm_srai_epi32(_mm_slli_epi32(v, 16), 16),
+                _mm_srai_epi32(v, 16));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                             _mm_srai_epi32(sum, 1));
+        }
+        downmix16Scalar(in + 2*i, count - i, out + i);
+    }
+
+    /**
+     * Mixes 16-bit stereo samples down to 16-bit mono, SSE2 version.
+     */
+    __attribute__((target("sse2")))
+    static void downmix16NativeSse2(const boost::int16_t* in,
+                                    unsigned int count, boost::int16_t* out)
+    {
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i a = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(in + 2*i));
+            __m128i b = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(in + 2*i + 8));
+            __m128i sa = _mm_add_epi32(
+                _mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                _mm_srai_epi32(a, 16));
+            __m128i sb = _mm_add_epi32(
+                _mm_srai_epi32(_mm_slli_epi32(b, 16), 16),
+                _mm_srai_epi32(b, 16));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                             _mm_packs_epi32(_mm_srai_epi32(sa, 1),
+                                             _mm_srai_epi32(sb, 1)));
+        }
+        downmix16Scalar(in + 2*i, count - i, out + i);
+    }
+
+    /**
+     * Widens 16-bit mono samples, SSE2 version.
+     */
+    __attribute__((target("sse2")))
+    static void widen16Sse2(const boost::int16_t* in, unsigned int count,
+                            int* out)
+    {
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i v = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(in + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                             _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4),
+                             _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+        }
+        widen16Scalar(in + i, count - i, out + i);
+    }
+
+    /**
+     * Sign-extends 16-bit lanes and stores them as 8 ints, SSE2 version.
+     */
+    __attribute__((target("sse2")))
+    static inline void store16As32Sse2(__m128i v, int* out)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+                         _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4),
+                         _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+    }
+
+    /**
+     * Splits unsigned 8-bit stereo samples into channels, SSE2 version.
+     *
+     * A 16-bit lane holds a sample pair, the left sample in its lower byte.
+     */
+    __attribute__((target("sse2")))
+    static void deinterleave8Sse2(const boost::uint8_t* in,
+                                  unsigned int count, int* left, int* right)
+    {
+        const __m128i lowBytes = _mm_set1_epi16(0xFF);
+        const __m128i middle = _mm_set1_epi16(128);
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i v = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(in + 2*i));
+            if (left)
+                store16As32Sse2(_mm_sub_epi16(_mm_and_si128(v, lowBytes),
+                                              middle), left + i);
+            if (right)
+                store16As32Sse2(_mm_sub_epi16(_mm_srli_epi16(v, 8), middle),
+                                right + i);
+        }
+        deinterleave8Scalar(in + 2*i, count - i, left ? left + i : 0,
+                            right ? right + i : 0);
+    }
+
+    /**
+     * Mixes unsigned 8-bit stereo samples down to mono, SSE2 version.
+     */
+    __attribute__((target("sse2")))
+    static void downmix8Sse2(const boost::uint8_t* in, unsigned int count,
+                             int* out)
+    {
+        const __m128i lowBytes = _mm_set1_epi16(0xFF);
+        const __m128i offset = _mm_set1_epi16(256);
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i v = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(in + 2*i));
+            __m128i sum = _mm_add_epi16(_mm_and_si128(v, lowBytes),
+                                        _mm_srli_epi16(v, 8));
+            store16As32Sse2(_mm_srai_epi16(_mm_sub_epi16(sum, offset), 1),
+                            out + i);
+        }
+        downmix8Scalar(in + 2*i, count - i, out + i);
+    }
+
+    /**
+     * Widens unsigned 8-bit mono samples, SSE2 version.
+     */
+    __attribute__((target("sse2")))
+    static void widen8Sse2(const boost::uint8_t* in, unsigned int count,
+                           int* out)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i middle = _mm_set1_epi16(128);
+        unsigned int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i v = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(in + i));
+            store16As32Sse2(_mm_sub_epi16(_mm_unpacklo_epi8(v, zero), middle),
+                            out + i);
+            store16As32Sse2(_mm_sub_epi16(_mm_unpackhi_epi8(v, zero), middle),
+                            out + i + 8);
+        }
+        widen8Scalar(in + i, count - i, out + i);
+    }
+
+    /**
+     * Saturates floating point samples and rounds them, SSE2 version.
+     */
+    __attribute__((target("sse2")))
+    static inline __m128i roundSse2(__m128 x)
+    {
+        x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(FLOAT_TO_INT_MIN)),
+                       _mm_set1_ps(FLOAT_TO_INT_MAX));
+        __m128 half = _mm_or_ps(_mm_and_ps(x, _mm_set1_ps(-0.0f)),
+                                _mm_set1_ps(0.5f));
+        return _mm_cvttps_epi32(_mm_add_ps(x, half));
+    }
+
+    __attribute__((target("sse2")))
+    static inline void storeSse2(float* out, __m128 x)
+    {
+        _mm_storeu_ps(out, x);
+    }
+
+    __attribute__((target("sse2")))
+    static inline void storeSse2(int* out, __m128 x)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), roundSse2(x));
+    }
+
+    /**
+     * Splits floating point stereo samples into channels, SSE2 version.
+     */
+    template <typename T>
+    __attribute__((target("sse2")))
+    static void deinterleaveFloatSse2(const float* in, unsigned int count,
+                                      float scale, T* left, T* right)
+    {
+        const __m128 s = _mm_set1_ps(scale);
+        unsigned int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 a = _mm_loadu_ps(in + 2*i);
+            __m128 b = _mm_loadu_ps(in + 2*i + 4);
+            if (left)
+                storeSse2(left + i, _mm_mul_ps(_mm_shuffle_ps(a, b,
+                    _MM_SHUFFLE(2, 0, 2, 0)), s));
+            if (right)
+                storeSse2(right + i, _mm_mul_ps(_mm_shuffle_ps(a, b,
+                    _MM_SHUFFLE(3, 1, 3, 1)), s));
+        }
+        deinterleaveFloatScalar(in + 2*i, count - i, scale,
+                                left ? left + i : 0, right ? right + i : 0);
+    }
+
+    /**
+     * Mixes floating point stereo samples down to mono, SSE2 version.
+     */
+    template <typename T>
+    __attribute__((target("sse2")))
+    static void downmixFloatSse2(const float* in, unsigned int count,
+                                 float scale, T* out)
+    {
+        const __m128 s = _mm_set1_ps(scale);
+        const __m128 half = _mm_set1_ps(0.5f);
+        unsigned int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 a = _mm_loadu_ps(in + 2*i);
+            __m128 b = _mm_loadu_ps(in + 2*i + 4);
+            __m128 l = _mm_mul_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)),
+                                  s);
+            __m128 r = _mm_mul_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)),
+                                  s);
+            storeSse2(out + i, _mm_mul_ps(_mm_add_ps(l, r), half));
+        }
+        downmixFloatScalar(in + 2*i, count - i, scale, out + i);
+    }
+
+    /**
+     * Scales floating point mono samples, SSE2 version.
+     */
+    template <typename T>
+    __attribute__((target("sse2")))
+    static void scaleFloatSse2(const float* in, unsigned int count,
+                               float scale, T* out)
+    {
+        const __m128 s = _mm_set1_ps(scale);
+        unsigned int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            storeSse2(out + i, _mm_mul_ps(_mm_loadu_ps(in + i), s));
+        }
+        scaleFloatScalar(in + i, count - i, scale, out + i);
+    }
+
+    /**
+     * Splits 16-bit stereo samples into int channels, AVX2 version.
+     */
+    __attribute__((target("avx2")))
+    static void deinterleave16Avx2(const boost::int16_t* in,
+                                   unsigned int count, int* left, int* right)
+    {
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i v = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(in + 2*i));
+            if (left)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(left + i),
+                    _mm256_srai_epi32(_mm256_slli_epi32(v, 16), 16));
+            if (right)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(right + i),
+                                    _mm256_srai_epi32(v, 16));
+        }
+        deinterleave16Scalar(in + 2*i, count - i, left ? left + i : 0,
+                             right ? right + i : 0);
+    }
+
+    /**
+     * Splits 16-bit stereo samples into 16-bit channels, AVX2 version.
+     *
+     * Packing works within 128-bit lanes, so the 64-bit quarters of the
+     * result are put back in order.
+     */
+    __attribute__((target("avx2")))
+    static void deinterleave16NativeAvx2(const boost::int16_t* in,
+                                         unsigned int count,
+                                         boost::int16_t* left,
+                                         boost::int16_t* right)
+    {
+        unsigned int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m256i a = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(in + 2*i));
+            __m256i b = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(in + 2*i + 16));
+            if (left)
+            {
+                __m256i la = _mm256_srai_epi32(_mm256_slli_epi32(a, 16), 16);
+                __m256i lb = _mm256_srai_epi32(_mm256_slli_epi32(b, 16), 16);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(left + i),
+                    _mm256_permute4x64_epi64(_mm256_packs_epi32(la, lb),
+                                             0xD8));
+            }
+            if (right)
+            {
+                __m256i p = _mm256_packs_epi32(_mm256_srai_epi32(a, 16),
+                                               _mm256_srai_epi32(b, 16));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(right + i),
+                                    _mm256_permute4x64_epi64(p, 0xD8));
+            }
+        }
+        deinterleave16Scalar(in + 2*i, count - i, left ? left + i : 0,
+                             right ? right + i : 0);
+    }
+
+    /**
+     * Mixes 16-bit stereo samples down to int mono, AVX2 version.
+     */
+    __attribute__((target("avx2")))
+    static void downmix16Avx2(const boost::int16_t* in, unsigned int count,
+                              int* out)
+    {
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i v = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(in + 2*i));
+            __m256i sum = _mm256_add_epi32(
+                _mm256_srai_epi32(_mm256_slli_epi32(v, 16), 16),
+                _mm256_srai_epi32(v, 16));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                                _mm256_srai_epi32(sum, 1));
+        }
+        downmix16Scalar(in + 2*i, count - i, out + i);
+    }
+
+    /**
+     * Mixes 16-bit stereo samples down to 16-bit mono, AVX2 version.
+     */
+    __attribute__((target("avx2")))
+    static void downmix16NativeAvx2(const boost::int16_t* in,
+                                    unsigned int count, boost::int16_t* out)
+    {
+        unsigned int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m256i a = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(in + 2*i));
+            __m256i b = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(in + 2*i + 16));
+            __m256i sa = _mm256_add_epi32(
+                _mm256_srai_epi32(_mm256_slli_epi32(a, 16), 16),
+                _mm256_srai_epi32(a, 16));
+            __m256i sb = _mm256_add_epi32(
+                _mm256_srai_epi32(_mm256_slli_epi32(b, 16), 16),
+                _mm256_srai_epi32(b, 16));
+            __m256i p = _mm256_packs_epi32(_mm256_srai_epi32(sa, 1),
+                                           _mm256_srai_epi32(sb, 1));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                                _mm256_permute4x64_epi64(p, 0xD8));
+        }
+        downmix16Scalar(in + 2*i, count - i, out + i);
+    }
+
+    /**
+     * Widens 16-bit mono samples, AVX2 version.
+     */
+    __attribute__((target("avx2")))
+    static void widen16Avx2(const boost::int16_t* in, unsigned int count,
+                            int* out)
+    {
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i v = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(in + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                                _mm256_cvtepi16_epi32(v));
+        }
+        widen16Scalar(in + i, count - i, out + i);
+    }
+
+    /**
+     * Splits unsigned 8-bit stereo samples into channels, AVX2 version.
+     */
+    __attribute__((target("avx2")))
+    static void deinterleave8Avx2(const boost::uint8_t* in,
+                                  unsigned int count, int* left, int* right)
+    {
+        const __m128i lowBytes = _mm_set1_epi16(0xFF);
+        const __m128i middle = _mm_set1_epi16(128);
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i v = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(in + 2*i));
+            if (left)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(left + i),
+                    _mm256_cvtepi16_epi32(_mm_sub_epi16(
+                        _mm_and_si128(v, lowBytes), middle)));
+            if (right)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(right + i),
+                    _mm256_cvtepi16_epi32(_mm_sub_epi16(
+                        _mm_srli_epi16(v, 8), middle)));
+        }
+        deinterleave8Scalar(in + 2*i, count - i, left ? left + i : 0,
+                            right ? right + i : 0);
+    }
+
+    /**
+     * Mixes unsigned 8-bit stereo samples down to mono, AVX2 version.
+     */
+    __attribute__((target("avx2")))
+    static void downmix8Avx2(const boost::uint8_t* in, unsigned int count,
+                             int* out)
+    {
+        const __m128i lowBytes = _mm_set1_epi16(0xFF);
+        const __m128i offset = _mm_set1_epi16(256);
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i v = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(in + 2*i));
+            __m128i sum = _mm_add_epi16(_mm_and_si128(v, lowBytes),
+                                        _mm_srli_epi16(v, 8));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                _mm256_cvtepi16_epi32(_mm_srai_epi16(
+                    _mm_sub_epi16(sum, offset), 1)));
+        }
+        downmix8Scalar(in + 2*i, count - i, out + i);
+    }
+
+    /**
+     * Widens unsigned 8-bit mono samples, AVX2 version.
+     */
+    __attribute__((target("avx2")))
+    static void widen8Avx2(const boost::uint8_t* in, unsigned int count,
+                           int* out)
+    {
+        const __m256i middle = _mm256_set1_epi32(128);
+        unsigned int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            __m128i v = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(in + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                _mm256_sub_epi32(_mm256_cvtepu8_epi32(v), middle));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 8),
+                _mm256_sub_epi32(_mm256_cvtepu8_epi32(_mm_srli_si128(v, 8)),
+                                 middle));
+        }
+        widen8Scalar(in + i, count - i, out + i);
+    }
+
+    /**
+     * Unpacks eight 24-bit samples to ints, AVX2 version.
+     *
+     * Reads 28 bytes: each 128-bit lane gets 12 bytes of samples (and 4
+     * more, which are ignored), which are moved to the upper three bytes
+     * of 32-bit lanes and shifted back with sign extension.
+     */
+    __attribute__((target("avx2")))
+    static inline __m256i unpack24Avx2(const boost::uint8_t* in)
+    {
+        const __m256i shuffle = _mm256_setr_epi8(
+            -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+            -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+        __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in))),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 12)), 1);
+        return _mm256_srai_epi32(_mm256_shuffle_epi8(v, shuffle), 8);
+    }
+
+    /**
+     * Splits 24-bit stereo samples into channels, AVX2 version.
+     */
+    __attribute__((target("avx2")))
+    static void deinterleave24Avx2(const boost::uint8_t* in,
+                                   unsigned int count, int* left, int* right)
+    {
+        const __m256i order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+        unsigned int i = 0;
+        // the last load reads 4 bytes past the 4 sample pairs
+        for (; i + 5 <= count; i += 4)
+        {
+            __m256i v = _mm256_permutevar8x32_epi32(unpack24Avx2(in + 6*i),
+                                                    order);
+            if (left)
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(left + i),
+                                 _mm256_castsi256_si128(v));
+            if (right)
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(right + i),
+                                 _mm256_extracti128_si256(v, 1));
+        }
+        deinterleave24Scalar(in + 6*i, count - i, left ? left + i : 0,
+                             right ? right + i : 0);
+    }
+
+    /**
+     * Mixes 24-bit stereo samples down to mono, AVX2 version.
+     */
+    __attribute__((target("avx2")))
+    static void downmix24Avx2(const boost::uint8_t* in, unsigned int count,
+                              int* out)
+    {
+        const __m256i order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+        unsigned int i = 0;
+        for (; i + 5 <= count; i += 4)
+        {
+            __m256i v = _mm256_permutevar8x32_epi32(unpack24Avx2(in + 6*i),
+                                                    order);
+            __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v),
+                                        _mm256_extracti128_si256(v, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                             _mm_srai_epi32(sum, 1));
+        }
+        downmix24Scalar(in + 6*i, count - i, out + i);
+    }
+
+    /**
+     * Widens 24-bit mono samples, AVX2 version.
+     */
+    __attribute__((target("avx2")))
+    static void widen24Avx2(const boost::uint8_t* in, unsigned int count,
+                            int* out)
+    {
+        unsigned int i = 0;
+        for (; i + 10 <= count; i += 8)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+                                unpack24Avx2(in + 3*i));
+        }
+        widen24Scalar(in + 3*i, count - i, out + i);
+    }
+
+    /**
+     * Saturates floating point samples and rounds them, AVX2 version.
+     */
+    __attribute__((target("avx2")))
+    static inline __m256i roundAvx2(__m256 x)
+    {
+        x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(FLOAT_TO_INT_MIN)),
+                          _mm256_set1_ps(FLOAT_TO_INT_MAX));
+        __m256 half = _mm256_or_ps(_mm256_and_ps(x, _mm256_set1_ps(-0.0f)),
+                                   _mm256_set1_ps(0.5f));
+        return _mm256_cvttps_epi32(_mm256_add_ps(x, half));
+    }
+
+    __attribute__((target("avx2")))
+    static inline void storeAvx2(float* out, __m256 x)
+    {
+        _mm256_storeu_ps(out, x);
+    }
+
+    __attribute__((target("avx2")))
+    static inline void storeAvx2(int* out, __m256 x)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), roundAvx2(x));
+    }
+
+    /**
+     * Takes every other float of two vectors, AVX2 version.
+     *
+     * Shuffling works within 128-bit lanes, so the 64-bit quarters of the
+     * result are put back in order.
+     */
+    __attribute__((target("avx2")))
+    static inline __m256 evenAvx2(__m256 a, __m256 b)
+    {
+        return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(
+            _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))), 0xD8));
+    }
+
+    __attribute__((target("avx2")))
+    static inline __m256 oddAvx2(__m256 a, __m256 b)
+    {
+        return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(
+            _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))), 0xD8));
+    }
+
+    /**
+     * Splits floating point stereo samples into channels, AVX2 version.
+     */
+    template <typename T>
+    __attribute__((target("avx2")))
+    static void deinterleaveFloatAvx2(const float* in, unsigned int count,
+                                      float scale, T* left, T* right)
+    {
+        const __m256 s = _mm256_set1_ps(scale);
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 a = _mm256_loadu_ps(in + 2*i);
+            __m256 b = _mm256_loadu_ps(in + 2*i + 8);
+            if (left)
+                storeAvx2(left + i, _mm256_mul_ps(evenAvx2(a, b), s));
+            if (right)
+                storeAvx2(right + i, _mm256_mul_ps(oddAvx2(a, b), s));
+        }
+        deinterleaveFloatScalar(in + 2*i, count - i, scale,
+                                left ? left + i : 0, right ? right + i : 0);
+    }
+
+    /**
+     * Mixes floating point stereo samples down to mono, AVX2 version.
+     */
+    template <typename T>
+    __attribute__((target("avx2")))
+    static void downmixFloatAvx2(const float* in, unsigned int count,
+                                 float scale, T* out)
+    {
+        const __m256 s = _mm256_set1_ps(scale);
+        const __m256 half = _mm256_set1_ps(0.5f);
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 a = _mm256_loadu_ps(in + 2*i);
+            __m256 b = _mm256_loadu_ps(in + 2*i + 8);
+            __m256 l = _mm256_mul_ps(evenAvx2(a, b), s);
+            __m256 r = _mm256_mul_ps(oddAvx2(a, b), s);
+            storeAvx2(out + i, _mm256_mul_ps(_mm256_add_ps(l, r), half));
+        }
+        downmixFloatScalar(in + 2*i, count - i, scale, out + i);
+    }
+
+    /**
+     * Scales floating point mono samples, AVX2 version.
+     */
+    template <typename T>
+    __attribute__((target("avx2")))
+    static void scaleFloatAvx2(const float* in, unsigned int count,
+                               float scale, T* out)
+    {
+        const __m256 s = _mm256_set1_ps(scale);
+        unsigned int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            storeAvx2(out + i, _mm256_mul_ps(_mm256_loadu_ps(in + i), s));
+        }
+        scaleFloatScalar(in + i, count - i, scale, out + i);
+    }
+#endif // AQUILA_X86_SIMD
+
+    /**
+     * Expands a mu-law (G.711) code to a 16-bit sample.
+     *
+     * @param code companded sample
+     * @return linear sample
+     */
+    static boost::int16_t expandMuLaw(boost::uint8_t code)
+    {
+        code = static_cast<boost::uint8_t>(~code);
+        int t = (((code & 0x0F) << 3) + 0x84) << ((code & 0x70) >> 4);
+        return static_cast<boost::int16_t>((code & 0x80) ? 0x84 - t : t - 0x84);
+    }
+
+    /**
+     * Expands an A-law (G.711) code to a 16-bit sample.
+     *
+     * @param code companded sample
+     * @return linear sample
+     */
+    static boost::int16_t expandALaw(boost::uint8_t code)
+    {
+        code ^= 0x55;
+        int t = (code & 0x0F) << 4;
+        const int segment = (code & 0x70) >> 4;
+        if (0 == segment)
+        {
+            t += 8;
+        }
+        else
+        {
+            t += 0x108;
+            t <<= segment - 1;
+        }
+        return static_cast<boost::int16_t>((code & 0x80) ? t : -t);
+    }
+
+    /**
+     * Lookup tables of all 256 companded codes.
+     */
+    struct CompandingTables
+    {
+        CompandingTables()
+        {
+            for (unsigned int i = 0; i < 256; ++i)
+            {
+                muLaw[i] = expandMuLaw(static_cast<boost::uint8_t>(i));
+                aLaw[i] = expandALaw(static_cast<boost::uint8_t>(i));
+            }
+        }
+
+        boost::int16_t muLaw[256];
+        boost::int16_t aLaw[256];
+    };
+
+    static const CompandingTables compandingTables;
+
+    /**
+     * Returns kernels matching the instruction set of FftKernels.
+     *
+     * AVX-512 would not be faster than AVX2 for these memory-bound loops,
+     * so AVX2 kernels are used in both cases. Unpacking 24-bit samples
+     * needs byte shuffles, which SSE2 lacks, so the plain C++ version is
+     * used at SSE2 level.
+     *
+     * @return table of kernel pointers
+     */
+    const PcmKernels::Functions& PcmKernels::getFunctions()
+    {
+        static const Functions scalar = {
+            &deinterleave16Scalar<int>,
+            &deinterleave16Scalar<boost::int16_t>,
+            &downmix16Scalar<int>,
+            &downmix16Scalar<boost::int16_t>,
+            &widen16Scalar,
+            &deinterleave8Scalar,
+            &downmix8Scalar,
+            &widen8Scalar,
+            &deinterleave24Scalar,
+            &downmix24Scalar,
+            &widen24Scalar,
+            &deinterleaveFloatScalar<float>,
+            &deinterleaveFloatScalar<int>,
+            &downmixFloatScalar<float>,
+            &downmixFloatScalar<int>,
+            &scaleFloatScalar<float>,
+            &scaleFloatScalar<int>
+        };
+#ifdef AQUILA_X86_SIMD
+        static const Functions sse2 = {
+            &deinterleave16Sse2,
+            &deinterleave16NativeSse2,
+            &downmix16Sse2,
+            &downmix16NativeSse2,
+            &widen16Sse2,
+            &deinterleave8Sse2,
+            &downmix8Sse2,
+            &widen8Sse2,
+            &deinterleave24Scalar,
+            &downmix24Scalar,
+            &widen24Scalar,
+            &deinterleaveFloatSse2<float>,
+            &deinterleaveFloatSse2<int>,
+            &downmixFloatSse2<float>,
+            &downmixFloatSse2<int>,
+            &scaleFloatSse2<float>,
+            &scaleFloatSse2<int>
+        };
+        static const Functions avx2 = {
+            &deinterleave16Avx2,
+            &deinterleave16NativeAvx2,
+            &downmix16Avx2,
+            &downmix16NativeAvx2,
+            &widen16Avx2,
+            &deinterleave8Avx2,
+            &downmix8Avx2,
+            &widen8Avx2,
+            &deinterleave24Avx2,
+            &downmix24Avx2,
+            &widen24Avx2,
+            &deinterleaveFloatAvx2<float>,
+            &deinterleaveFloatAvx2<int>,
+            &downmixFloatAvx2<float>,
+            &downmixFloatAvx2<int>,
+            &scaleFloatAvx2<float>,
+            &scaleFloatAvx2<int>
+        };
+
+        switch (FftKernels::getLevel())
+        {
+        case SIMD_AVX512:
+        case SIMD_AVX2:
+            return avx2;
+        case SIMD_SSE2:
+            return sse2;
+        default:
+            break;
+        }
+#endif
+        return scalar;
+    }
+
+    /**
+     * Splits 16-bit stereo samples into int channels.
+     *
+     * @param input count interleaved sample pairs
+     * @param count number of samples in a channel
+     * @param left left channel or 0
+     * @param right right channel or 0
+     */
+    void PcmKernels::deinterleave16(const boost::int16_t* input,
+                                    unsigned int count, int* left, int* right)
+    {
+        getFunctions().deinterleave16(input, count, left, right);
+    }
+
+    /**
+     * Splits 16-bit stereo samples into 16-bit channels.
+     *
+     * @param input count interleaved sample pairs
+     * @param count number of samples in a channel
+     * @param left left channel or 0
+     * @param right right channel or 0
+     */
+    void PcmKernels::deinterleave16(const boost::int16_t* input,
+                                    unsigned int count, boost::int16_t* left,
+                                    boost::int16_t* right)
+    {
+        getFunctions().deinterleave16Native(input, count, left, right);
+    }
+
+    /**
+     * Mixes 16-bit stereo samples down to an int channel.
+     *
+     * @param input count interleaved sample pairs
+     * @param count number of samples in a channel
+     * @param output mono channel
+     */
+    void PcmKernels::downmix16(const boost::int16_t* input, unsigned int count,
+                               int* output)
+    {
+        getFunctions().downmix16(input, count, output);
+    }
+
+    /**
+     * Mixes 16-bit stereo samples down to a 16-bit channel.
+     *
+     * @param input count interleaved sample pairs
+     * @param count number of samples in a channel
+     * @param output mono channel
+     */
+    void PcmKernels::downmix16(const boost::int16_t* input, unsigned int count,
+                               boost::int16_t* output)
+    {
+        getFunctions().downmix16Native(input, count, output);
+    }
+
+    /**
+     * Widens 16-bit mono samples to int.
+     *
+     * @param input count samples
+     * @param count number of samples
+     * @param output the channel
+     */
+    void PcmKernels::widen16(const boost::int16_t* input, unsigned int count,
+                             int* output)
+    {
+        getFunctions().widen16(input, count, output);
+    }
+
+    /**
+     * Splits unsigned 8-bit stereo samples into int channels.
+     *
+     * @param input count interleaved sample pairs
+     * @param count number of samples in a channel
+     * @param left left channel or 0
+     * @param right right channel or 0
+     */
+    void PcmKernels::deinterleave8(const boost::uint8_t* input,
+                                   unsigned int count, int* left, int* right)
+    {
+        getFunctions().deinterleave8(input, count, left, right);
+    }
+
+    /**
+     * Mixes unsigned 8-bit stereo samples down to an int channel.
+     *
+     * @param input count interleaved sample pairs
+     * @param count number of samples in a channel
+     * @param output mono channel
+     */
+    void PcmKernels::downmix8(const boost::uint8_t* input, unsigned int count,
+                              int* output)
+    {
+        getFunctions().downmix8(input, count, output);
+    }
+
+    /**
+     * Widens unsigned 8-bit mono samples to signed int.
+     *
+     * @param input count samples
+     * @param count number of samples
+     * @param output the channel
+     */
+    void PcmKernels::widen8(const boost::uint8_t* input, unsigned int count,
+                            int* output)
+    {
+        getFunctions().widen8(input, count, output);
+    }
+
+    /**
+     * Splits 24-bit stereo samples into int channels.
+     *
+     * @param input count interleaved sample pairs, 3 bytes each
+     * @param count number of samples in a channel
+     * @param left left channel or 0
+     * @param right right channel or 0
+     */
+    void PcmKernels::deinterleave24(const boost::uint8_t* input,
+                                    unsigned int count, int* left, int* right)
+    {
+        getFunctions().deinterleave24(input, count, left, right);
+    }
+
+    /**
+     * Mixes 24-bit stereo samples down to an int channel.
+     *
+     * @param input count interleaved sample pairs, 3 bytes each
+     * @param count number of samples in a channel
+     * @param output mono channel
+     */
+    void PcmKernels::downmix24(const boost::uint8_t* input, unsigned int count,
+                               int* output)
+    {
+        getFunctions().downmix24(input, count, output);
+    }
+
+    /**
+     * Widens 24-bit mono samples to int.
+     *
+     * @param input count samples, 3 bytes each
+     * @param count number of samples
+     * @param output the channel
+     */
+    void PcmKernels::widen24(const boost::uint8_t* input, unsigned int count,
+                             int* output)
+    {
+        getFunctions().widen24(input, count, output);
+    }
+
+    /**
+     * Splits floating point stereo samples into scaled channels.
+     *
+     * @param input count interleaved sample pairs
+     * @param count number of samples in a channel
+     * @param scale factor applied to all samples
+     * @param left left channel or 0
+     * @param right right channel or 0
+     */
+    void PcmKernels::deinterleaveFloat(const float* input, unsigned int count,
+                                       float scale, float* left, float* right)
+    {
+        getFunctions().deinterleaveFloat(input, count, scale, left, right);
+    }
+
+    /**
+     * Splits floating point stereo samples into rounded int channels.
+     *
+     * @param input count interleaved sample pairs
+     * @param count number of samples in a channel
+     * @param scale factor applied to all samples
+     * @param left left channel or 0
+     * @param right right channel or 0
+     */
+    void PcmKernels::deinterleaveFloat(const float* input, unsigned int count,
+                                       float scale, int* left, int* right)
+    {
+        getFunctions().deinterleaveFloatToInt(input, count, scale, left, right);
+    }
+
+    /**
+     * Mixes floating point stereo samples down to a scaled channel.
+     *
+     * @param input count interleaved sample pairs
+     * @param count number of samples in a channel
+     * @param scale factor applied to all samples
+     * @param output mono channel
+     */
+    void PcmKernels::downmixFloat(const float* input, unsigned int count,
+                                  float scale, float* output)
+    {
+        getFunctions().downmixFloat(input, count, scale, output);
+    }
+
+    /**
+     * Mixes floating point stereo samples down to a rounded int channel.
+     *
+     * @param input count interleaved sample pairs
+     * @param count number of samples in a channel
+     * @param scale factor applied to all samples
+     * @param output mono channel
+     */
+    void PcmKernels::downmixFloat(const float* input, unsigned int count,
+                                  float scale, int* output)
+    {
+        getFunctions().downmixFloatToInt(input, count, scale, output);
+    }
+
+    /**
+     * Scales floating point mono samples.
+     *
+     * @param input count samples
+     * @param count number of samples
+     * @param scale factor applied to all samples
+     * @param output the channel
+     */
+    void PcmKernels::scaleFloat(const float* input, unsigned int count,
+                                float scale, float* output)
+    {
+        getFunctions().scaleFloat(input, count, scale, output);
+    }
+
+    /**
+     * Scales floating point mono samples and rounds them to int.
+     *
+     * @param input count samples
+     * @param count number of samples
+     * @param scale factor applied to all samples
+     * @param output the channel
+     */
+    void PcmKernels::scaleFloat(const float* input, unsigned int count,
+                                float scale, int* output)
+    {
+        getFunctions().scaleFloatToInt(input, count, scale, output);
+    }
+
+    /**
+     * Returns the mu-law expansion table.
+     *
+     * @return 256 linear 16-bit samples, indexed by companded code
+     */
+    const boost::int16_t* PcmKernels::getMuLawTable()
+    {
+        return compandingTables.muLaw;
+    }
+
+    /**
+     * Returns the A-law expansion table.
+     *
+     * @return 256 linear 16-bit samples, indexed by companded code
+     */
+    const boost::int16_t* PcmKernels::getALawTable()
+    {
+        return compandingTables.aLaw;
+    }
+}
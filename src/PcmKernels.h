@@ -0,0 +1,133 @@
+/**
+ * @file PcmKernels.h
+ *
+ * Vectorized PCM decoding kernels - header.
+ *
+ * Kernels convert interleaved PCM data of a .wav file into channel
+ * samples: they deinterleave stereo data, widen samples to int and
+ * optionally mix both channels down to one. Companded (mu-law and A-law)
+ * samples are expanded with lookup tables. Every kernel is compiled for
+ * a few instruction sets and the version matching FftKernels::getLevel()
+ * is used, so FftKernels::setLevel() controls these kernels too.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#ifndef PCMKERNELS_H
+#define PCMKERNELS_H
+
+#include "global.h"
+#include <boost/cstdint.hpp>
+
+namespace Aquila
+{
+    /**
+     * A collection of PCM decoding kernels, dispatched by instruction set.
+     *
+     * Stereo kernels take count interleaved sample pairs. A null channel
+     * pointer skips that channel. Unsigned 8-bit samples are moved by half
+     * of the dynamic range. Mixed down integer samples are the mean of
+     * both channels, rounded towards minus infinity.
+     *
+     * Floating point samples are multiplied by a scale factor. When they
+     * are stored as integers, they are saturated to the int range and
+     * rounded to the nearest integer, away from zero on ties.
+     */
+    class AQUILA_EXPORT PcmKernels
+    {
+    public:
+        static void deinterleave16(const boost::int16_t* input,
+                                   unsigned int count, int* left, int* right);
+
+        static void deinterleave16(const boost::int16_t* input,
+                                   unsigned int count, boost::int16_t* left,
+                                   boost::int16_t* right);
+
+        static void downmix16(const boost::int16_t* input, unsigned int count,
+                              int* output);
+
+        static void downmix16(const boost::int16_t* input, unsigned int count,
+                              boost::int16_t* output);
+
+        static void widen16(const boost::int16_t* input, unsigned int count,
+                            int* output);
+
+        static void deinterleave8(const boost::uint8_t* input,
+                                  unsigned int count, int* left, int* right);
+
+        static void downmix8(const boost::uint8_t* input, unsigned int count,
+                             int* output);
+
+        static void widen8(const boost::uint8_t* input, unsigned int count,
+                           int* output);
+
+        static void deinterleave24(const boost::uint8_t* input,
+                                   unsigned int count, int* left, int* right);
+
+        static void downmix24(const boost::uint8_t* input, unsigned int count,
+                              int* output);
+
+        static void widen24(const boost::uint8_t* input, unsigned int count,
+                            int* output);
+
+        static void deinterleaveFloat(const float* input, unsigned int count,
+                                      float scale, float* left, float* right);
+
+        static void deinterleaveFloat(const float* input, unsigned int count,
+                                      float scale, int* left, int* right);
+
+        static void downmixFloat(const float* input, unsigned int count,
+                                 float scale, float* output);
+
+        static void downmixFloat(const float* input, unsigned int count,
+                                 float scale, int* output);
+
+        static void scaleFloat(const float* input, unsigned int count,
+                               float scale, float* output);
+
+        static void scaleFloat(const float* input, unsigned int count,
+                               float scale, int* output);
+
+        static const boost::int16_t* getMuLawTable();
+        static const boost::int16_t* getALawTable();
+
+    private:
+        /**
+         * Kernels compiled for a single instruction set.
+         */
+        struct Functions
+        {
+            void (*deinterleave16)(const boost::int16_t*, unsigned int,
+                                   int*, int*);
+            void (*deinterleave16Native)(const boost::int16_t*, unsigned int,
+                                         boost::int16_t*, boost::int16_t*);
+            void (*downmix16)(const boost::int16_t*, unsigned int, int*);
+            void (*downmix16Native)(const boost::int16_t*, unsigned int,
+                                    boost::int16_t*);
+            void (*widen16)(const boost::int16_t*, unsigned int, int*);
+            void (*deinterleave8)(const boost::uint8_t*, unsigned int,
+                                  int*, int*);
+            void (*downmix8)(const boost::uint8_t*, unsigned int, int*);
+            void (*widen8)(const boost::uint8_t*, unsigned int, int*);
+            void (*deinterleave24)(const boost::uint8_t*, unsigned int,
+                                   int*, int*);
+            void (*downmix24)(const boost::uint8_t*, unsigned int, int*);
+            void (*widen24)(const boost::uint8_t*, unsigned int, int*);
+            void (*deinterleaveFloat)(const float*, unsigned int, float,
+                                      float*, float*);
+            void (*deinterleaveFloatToInt)(const float*, unsigned int, float,
+                                           int*, int*);
+            void (*downmixFloat)(const float*, unsigned int, float, float*);
+            void (*downmixFloatToInt)(const float*, unsigned int, float, int*);
+            void (*scaleFloat)(const float*, unsigned int, float, float*);
+            void (*scaleFloatToInt)(const float*, unsigned int, float, int*);
+        };
+
+        static const Functions& getFunctions();
+    };
+}
+
+#endif // PCMKERNELS_H
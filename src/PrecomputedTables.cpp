@@ -0,0 +1,86 @@
+/**
+ * @file PrecomputedTables.cpp
+ *
+ * Precomputed tables - implementation.
+ *
+ * Window, Mel filter and DCT tables for a few fixed signal configurations
+ * are generated ahead of time by gen_tables.py and compiled into the
+ * library. Window, MelFiltersBank and DctPlan use them instead of
+ * computing the tables at runtime when the parameters match, which
+ * shortens startup of short-lived processes.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#include "PrecomputedTables.h"
+
+namespace Aquila
+{
+    /**
+     * Returns a precomputed window table, if there is one.
+     *
+     * @param type window function type
+     * @param N window length
+     * @return pointer to N window values or 0
+     */
+    const double* PrecomputedTables::findWindow(WindowType type, unsigned int N)
+    {
+        for (unsigned int i = 0; i < PRECOMPUTED_WINDOWS_COUNT; ++i)
+        {
+            const PrecomputedWindow& window = PRECOMPUTED_WINDOWS[i];
+            if (window.type == type && window.N == N)
+                return window.values;
+        }
+
+        return 0;
+    }
+
+    /**
+     * Returns a precomputed Mel filters bank, if there is one.
+     *
+     * @param sampleFrequency sample frequency in Hz
+     * @param melFilterWidth filter width in Mel frequency scale
+     * @param N spectrum size of each filter
+     * @return pointer to the bank or 0
+     */
+    const PrecomputedMelBank* PrecomputedTables::findMelBank(
+        double sampleFrequency, unsigned short melFilterWidth, unsigned int N)
+    {
+        for (unsigned int i = 0; i < PRECOMPUTED_MEL_BANKS_COUNT; ++i)
+        {
+            const PrecomputedMelBank& bank = PRECOMPUTED_MEL_BANKS[i];
+            if (bank.sampleFrequency == sampleFrequency &&
+                bank.melFilterWidth == melFilterWidth && bank.N == N)
+                return &bank;
+        }
+
+        return 0;
+    }
+
+    /**
+     * Returns precomputed DCT cosines, if there are any.
+     *
+     * Rows of a larger matrix are used when fewer coefficients are needed.
+     *
+     * @param N transform length
+     * @param K number of coefficients
+     * @param stride length of a matrix row
+     * @return pointer to K rows of stride values or 0
+     */
+    const double* PrecomputedTables::findDctCosines(unsigned int N,
+                                                    unsigned int K,
+                                                    unsigned int stride)
+    {
+        for (unsigned int i = 0; i < PRECOMPUTED_DCTS_COUNT; ++i)
+        {
+            const PrecomputedDct& dct = PRECOMPUTED_DCTS[i];
+            if (dct.N == N && dct.rows >= K && dct.stride == stride)
+                return dct.cosines;
+        }
+
+        return 0;
+    }
+}
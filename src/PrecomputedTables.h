@@ -0,0 +1,92 @@
+/**
+ * @file PrecomputedTables.h
+ *
+ * Precomputed tables - header.
+ *
+ * Window, Mel filter and DCT tables for a few fixed signal configurations
+ * are generated ahead of time by gen_tables.py and compiled into the
+ * library. Window, MelFiltersBank and DctPlan use them instead of
+ * computing the tables at runtime when the parameters match, which
+ * shortens startup of short-lived processes.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#ifndef PRECOMPUTEDTABLES_H
+#define PRECOMPUTEDTABLES_H
+
+#include "global.h"
+#include "Window.h"
+
+namespace Aquila
+{
+    /**
+     * A precomputed window table.
+     */
+    struct PrecomputedWindow
+    {
+        WindowType type;
+        unsigned int N;
+        const double* values;
+    };
+
+    /**
+     * A precomputed bank of MELFILTERS Mel filters.
+     *
+     * Only the nonzero part of each filter spectrum is stored: filter i
+     * has lengths[i] values, starting from spectrum bin begins[i]. Values
+     * of all filters follow each other in the values array.
+     */
+    struct PrecomputedMelBank
+    {
+        double sampleFrequency;
+        unsigned short melFilterWidth;
+        unsigned int N;
+        const unsigned int* begins;
+        const unsigned int* lengths;
+        const double* values;
+    };
+
+    /**
+     * A precomputed matrix of scaled DCT cosines, as in DctPlan.
+     */
+    struct PrecomputedDct
+    {
+        unsigned int N;
+        unsigned int rows;
+        unsigned int stride;
+        const double* cosines;
+    };
+
+    /**
+     * Generated tables, see PrecomputedTablesData.cpp.
+     */
+    extern const PrecomputedWindow PRECOMPUTED_WINDOWS[];
+    extern const unsigned int PRECOMPUTED_WINDOWS_COUNT;
+    extern const PrecomputedMelBank PRECOMPUTED_MEL_BANKS[];
+    extern const unsigned int PRECOMPUTED_MEL_BANKS_COUNT;
+    extern const PrecomputedDct PRECOMPUTED_DCTS[];
+    extern const unsigned int PRECOMPUTED_DCTS_COUNT;
+
+
+    /**
+     * Lookup of tables compiled into the library.
+     */
+    class AQUILA_EXPORT PrecomputedTables
+    {
+    public:
+        static const double* findWindow(WindowType type, unsigned int N);
+
+        static const PrecomputedMelBank* findMelBank(double sampleFrequency,
+                                                     unsigned short melFilterWidth,
+                                                     unsigned int N);
+
+        static const double* findDctCosines(unsigned int N, unsigned int K,
+                                            unsigned int stride);
+    };
+}
+
+#endif // PRECOMPUTEDTABLES_H
@@ -0,0 +1,775 @@
+/**
+ * @file PrecomputedTablesData.cpp
+ *
+ * Precomputed tables - data generated by gen_tables.py, do not edit.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#include "PrecomputedTables.h"
+#include <boost/static_assert.hpp>
+
+namespace Aquila
+{
+    BOOST_STATIC_ASSERT(MELFILTERS == 24);
+
+    static const double s_win_hamming_256[256] = {
+        0.076719999999999955, 0.076860129908935315, 0.077280434563427924,
+        0.077980658798184777, 0.07896037750984275, 0.080218995915047553,
+        0.081755749911544162, 0.083569706542060251, 0.085659764560701068,
+        0.088024655101511196, 0.090662942448798189, 0.093573024908749913,
+        0.096753135781816435, 0.10020134443526652, 0.10391555747526682,
+        0.10789352001777314, 0.11213281705746186, 0.1166308749338697,
+        0.12138496289385303, 0.12639219474941732, 0.13164953062991042,
+        0.13715377882751584, 0.14290159773492633, 0.14888949787402006,
+        0.15511384401430911, 0.16157085737987376, 0.16825661794344199,
+        0.17516706680622274, 0.18229800866204748, 0.18964511434432368,
+        0.19720392345425486, 0.20496984706873117, 0.2129381705262462,
+        0.22110405628914953, 0.22946254688049661, 0.23800856789371361,
+        0.24673693107324918, 0.25564233746434417, 0.26471938063000605,
+        0.27396254993323549, 0.28336623388251203, 0.29292472353850851,
+        0.30263221597996603, 0.3124828178266234, 0.32247054881706605,
+        0.33258934543931884, 0.34283306461197932, 0.35319548741365969,
+        0.36367032285846779, 0.37425121171524106, 0.38493173036820988,
+        0.3957053947167492, 0.40656566411185113, 0.41750594532692603,
+        0.42851959656052541, 0.43959993146855253, 0.45074022322351553,
+        0.46193370859835819, 0.47317359207238802, 0.48445304995680993,
+        0.4957652345373611, 0.50710327823153079, 0.51846029775784241,
+        0.52982939831466724, 0.54120367776603029, 0.55257623083187035,
+        0.5639401532802083, 0.5752885461186783, 0.58661451978287948,
+        0.59791119831900297, 0.60917172355819627, 0.62038925928013045,
+        0.63155699536324217, 0.64266815191913229, 0.65371598340860859,
+        0.66469378273687618, 0.67559488532538825, 0.68641267315788523,
+        0.69714057879816649, 0.70777208937715452, 0.7183007505468324,
+        0.72872017039865267, 0.73902402334403983, 0.74920605395463036,
+        0.7592600807599178, 0.76917999999999986, 0.77895978933114662,
+        0.78859351148194134, 0.79807531785777486, 0.80739945209150432,
+        0.81656025353811978, 0.82555216071130111, 0.83436971465977294,
+        0.84300756228141327, 0.85146045957310035, 0.85972327481432531,
+        0.86779099168264118, 0.87565871229905101, 0.88332166020149105,
+        0.8907751832446027, 0.89801475642403039, 0.90503598462353496,
+        0.91183460528325067, 0.91840649098746852, 0.92474765197037423,
+        0.93085423853821903, 0.93672254340645367, 0.94234900395040633,
+        0.94773020436813726, 0.9528628777541599, 0.95774390808276488,
+        0.96237033209974787, 0.96673934112138915, 0.97084828273959412,
+        0.97469466243216063, 0.9782761450771924, 0.98159055637074322,
+        0.98463588414682768, 0.98741027959899919, 0.98991205840275387,
+        0.99213970173807631, 0.99409185721150961, 0.99576733967718778,
+        0.99716513195633405, 0.99828438545478493, 0.99912442067816898,
+        0.99968472764442506, 0.99996496619341035, 0.99996496619341035,
+        0.99968472764442506, 0.99912442067816898, 0.99828438545478493,
+        0.99716513195633405, 0.99576733967718778, 0.99409185721150961,
+        0.99213970173807642, 0.98991205840275387, 0.9874102795989993,
+        0.98463588414682768, 0.98159055637074333, 0.97827614507719252,
+        0.97469466243216063, 0.97084828273959412, 0.96673934112138904,
+        0.96237033209974787, 0.95774390808276488, 0.9528628777541599,
+        0.94773020436813737, 0.94234900395040633, 0.93672254340645378,
+        0.93085423853821903, 0.92474765197037434, 0.91840649098746874,
+        0.91183460528325067, 0.90503598462353507, 0.8980147564240305,
+        0.89077518324460281, 0.88332166020149128, 0.87565871229905112,
+        0.86779099168264129, 0.85972327481432553, 0.85146045957310035,
+        0.84300756228141349, 0.83436971465977305, 0.82555216071130144,
+        0.81656025353812023, 0.80739945209150443, 0.79807531785777508,
+        0.78859351148194157, 0.77895978933114685, 0.7691800000000002,
+        0.75926008075991813, 0.74920605395463069, 0.73902402334404027,
+        0.728720170398653, 0.71830075054683284, 0.70777208937715497,
+        0.6971405787981666, 0.68641267315788546, 0.67559488532538847,
+        0.6646937827368764, 0.65371598340860881, 0.64266815191913251,
+        0.63155699536324239, 0.62038925928013056, 0.6091717235581966,
+        0.5979111983190033, 0.58661451978287948, 0.5752885461186783,
+        0.5639401532802083, 0.55257623083187046, 0.5412036777660304,
+        0.52982939831466735, 0.51846029775784264, 0.50710327823153101,
+        0.49576523453736143, 0.48445304995681027, 0.47317359207238829,
+        0.46193370859835808, 0.45074022322351542, 0.43959993146855242,
+        0.42851959656052541, 0.41750594532692603, 0.40656566411185113,
+        0.39570539471674931, 0.38493173036820999, 0.37425121171524128,
+        0.36367032285846801, 0.35319548741365947, 0.34283306461197927,
+        0.33258934543931873, 0.3224705488170661, 0.3124828178266234,
+        0.30263221597996603, 0.29292472353850862, 0.28336623388251203,
+        0.2739625499332356, 0.26471938063000622, 0.25564233746434434,
+        0.24673693107324901, 0.23800856789371344, 0.22946254688049655,
+        0.22110405628914942, 0.21293817052624614, 0.20496984706873111,
+        0.19720392345425486, 0.18964511434432368, 0.18229800866204748,
+        0.17516706680622274, 0.16825661794344227, 0.16157085737987387,
+        0.15511384401430922, 0.14888949787402012, 0.1429015977349265,
+        0.137153778827516, 0.13164953062991053, 0.12639219474941749,
+        0.1213849628938532, 0.11663087493386987, 0.11213281705746203,
+        0.1078935200177733, 0.10391555747526682, 0.10020134443526657,
+        0.096753135781816491, 0.093573024908749969, 0.090662942448798245,
+        0.088024655101511251, 0.085659764560701124, 0.083569706542060307,
+        0.081755749911544162, 0.080218995915047608, 0.07896037750984275,
+        0.077980658798184777, 0.077280434563427924, 0.076860129908935315,
+        0.076719999999999955
+    };
+
+    static const double s_win_hamming_512[512] = {
+        0.076719999999999955, 0.076754896823865604, 0.076859582019540518,
+        0.077034039760056405, 0.077278243669791358, 0.077592156828457604,
+        0.07797573177668321, 0.078428910523187623, 0.078951624553548705,
+        0.079543794840561621, 0.080205331856186168, 0.080936135585082725,
+        0.081736095539732823, 0.082605090777143453, 0.083542989917132104,
+        0.084549651162189488, 0.08562492231891744, 0.086768640821038412,
+        0.087980633753973581, 0.089260717880984664, 0.090608699670877202,
+        0.092024375327259655, 0.093507530819354645, 0.095057941914357458,
+        0.096675374211337095, 0.098359583176674426, 0.10011031418103211,
+        0.10192730253785148, 0.10381027354336925, 0.10575894251814882,
+        0.10777301485012025, 0.1098521860391215, 0.11199614174293449,
+        0.11420455782480948, 0.11647710040247011, 0.11881342589859184,
+        0.12121318109274598, 0.12367600317480204, 0.1262015197997795,
+        0.12878934914414125, 0.1314390999635201, 0.13415037165186966,
+        0.13692275430203044, 0.13975582876770215, 0.14264916672681294,
+        0.14560233074627582, 0.14861487434812243, 0.15168634207700471,
+        0.1548162695690532, 0.15800418362208257, 0.16124960226713358,
+        0.16455203484133968, 0.16791098206210903, 0.17132593610260871,
+        0.17479638066854181, 0.17832179107620333, 0.18190163433180578,
+        0.18553536921206015, 0.18922244634600166, 0.19296230829804706,
+        0.19675438965227132, 0.20059811709789072, 0.20449290951593951,
+        0.20843817806712744, 0.21243332628086375, 0.21647775014543574,
+        0.22057083819932688, 0.22471197162366158, 0.22890052433576186,
+        0.23313586308380269, 0.23741734754255106, 0.24174433041017424,
+        0.24611615750610283, 0.25053216786993415, 0.25499169386136056,
+        0.25949406126110697, 0.26403858937286395, 0.26862459112619996,
+        0.27325137318043607, 0.27791823602947074, 0.28262447410753466,
+        0.28736937589586303, 0.29215222403026764, 0.29697229540959191,
+        0.3018288613050345, 0.30672118747032273, 0.31164853425272077,
+        0.31661015670485504, 0.32160530469733983, 0.32663322303218678,
+        0.33169315155698037, 0.33678432527980262, 0.34190597448488946,
+        0.34705732484900109, 0.35223759755848916, 0.35744600942704241,
+        0.36268177301409421, 0.36794409674387268, 0.37323218502507582,
+        0.37854523837115428, 0.38388245352118244, 0.38924302356130097,
+        0.39462613804671098, 0.40003098312420182, 0.40545674165519513,
+        0.41090259333928447, 0.41636771483825374, 0.42185127990055493,
+        0.42735245948622552, 0.43287042189222824, 0.4384043328781933,
+        0.44395335579254369, 0.44951665169898603, 0.45509337950334572,
+        0.46068269608072926, 0.46628375640299302, 0.47189571366649963,
+        0.4775177194201437, 0.48314892369362572, 0.48878847512595569,
+        0.49443552109416766, 0.50008920784222455, 0.50574868061009381,
+        0.51141308376297634, 0.51708156092066626, 0.52275325508702408,
+        0.52842730877954236, 0.53410286415898545, 0.53977906315908375,
+        0.54545504761626062, 0.55112995939937559, 0.55680294053946167,
+        0.56247313335943872, 0.56813968060378228, 0.57380172556812936,
+        0.57945841222879979, 0.58510888537221561, 0.59075229072419766,
+        0.59638777507912, 0.60201448642890298, 0.60763157409182533,
+        0.61323818884113557, 0.6188334830334431, 0.62441661073687049,
+        0.62998672785894738, 0.63554299227422451, 0.64108456395159286,
+        0.64661060508128398, 0.65212028020153523, 0.65761275632490102,
+        0.66308720306418834, 0.66854279275800066, 0.67397870059586795,
+        0.67939410474294781, 0.68478818646427475, 0.6901601302485425,
+        0.69550912393139763, 0.70083435881822775, 0.70613502980642551,
+        0.71141033550710819, 0.71665947836627764, 0.72188166478539895,
+        0.72707610524138222, 0.73224201440594694, 0.73737861126435356,
+        0.74248511923348137, 0.74756076627923884, 0.75260478503328199,
+        0.75761641290903303, 0.76259489221697052, 0.76753947027918312,
+        0.77244939954316338, 0.77732393769482833, 0.78216234777074578,
+        0.78696389826955493, 0.79172786326255762, 0.79645352250347012,
+        0.80114016153731349, 0.80578707180843034, 0.81039355076760788,
+        0.81495890197829457, 0.81948243522189101, 0.82396346660210207,
+        0.82840131864833233, 0.83279532041811066, 0.83714480759852727,
+        0.84144912260666915, 0.84570761468903677, 0.84991964001993003,
+        0.85408456179878511, 0.85820175034645096, 0.86227058320038674,
+        0.86629044520877119, 0.87026072862350423, 0.87418083319209017,
+        0.87805016624838828, 0.88186814280221482, 0.88563418562778651,
+        0.88934772535098872, 0.89300820053545693, 0.89661505776745842,
+        0.90016775173956098, 0.90366574533307542, 0.90710850969926149,
+        0.91049552433928094, 0.91382627718289222, 0.91710026466586569,
+        0.92031699180611848, 0.92347597227854628, 0.92657672848855133,
+        0.92961879164424643, 0.9326017018273316, 0.9355250080626254,
+        0.938388268386248, 0.94119104991243896, 0.94393292889900438,
+        0.94661349081137991, 0.94923233038530408, 0.95178905168808736,
+        0.95428326817847264, 0.95671460276507481, 0.95908268786339135,
+        0.96138716545137659, 0.96362768712356983, 0.96580391414376876,
+        0.96791551749624261, 0.96996217793547412, 0.97194358603442566,
+        0.97385944223131982, 0.97570945687492938, 0.97749335026836892,
+        0.97921085271137986, 0.98086170454110766, 0.98244565617135682,
+        0.98396246813032673, 0.98541191109681581, 0.98679376593489176,
+        0.98810782372702155, 0.98935388580565808, 0.99053176378327445,
+        0.99164127958084691, 0.992682265454777, 0.99365456402225261,
+        0.99455802828504192, 0.99539252165171788, 0.99615791795830821,
+        0.9968541014873703, 0.99748096698548616, 0.9980384196791745,
+        0.99852637528922039, 0.99894476004341604, 0.99929351068771455,
+        0.9995725744957934, 0.99978190927702526, 0.99992148338285736,
+        0.99999127571159574, 0.99999127571159574, 0.99992148338285736,
+        0.99978190927702526, 0.9995725744957934, 0.99929351068771455,
+        0.99894476004341604, 0.99852637528922039, 0.9980384196791745,
+        0.99748096698548616, 0.9968541014873703, 0.99615791795830821,
+        0.99539252165171788, 0.99455802828504192, 0.99365456402225261,
+        0.992682265454777, 0.99164127958084691, 0.99053176378327445,
+        0.98935388580565808, 0.98810782372702166, 0.98679376593489176,
+        0.98541191109681581, 0.98396246813032684, 0.98244565617135682,
+        0.98086170454110766, 0.97921085271137998, 0.97749335026836892,
+        0.97570945687492949, 0.97385944223131982, 0.97194358603442566,
+        0.96996217793547423, 0.96791551749624261, 0.96580391414376887,
+        0.96362768712356983, 0.9613871654513767, 0.95908268786339135,
+        0.95671460276507481, 0.95428326817847275, 0.95178905168808747,
+        0.94923233038530408, 0.94661349081137991, 0.94393292889900438,
+        0.94119104991243896, 0.93838826838624789, 0.9355250080626254,
+        0.9326017018273316, 0.92961879164424654, 0.92657672848855133,
+        0.92347597227854639, 0.92031699180611859, 0.91710026466586581,
+        0.91382627718289222, 0.91049552433928116, 0.90710850969926149,
+        0.90366574533307564, 0.9001677517395611, 0.89661505776745853,
+        0.89300820053545704, 0.88934772535098872, 0.88563418562778673,
+        0.88186814280221482, 0.87805016624838839, 0.87418083319209028,
+        0.87026072862350423, 0.86629044520877119, 0.86227058320038674,
+        0.85820175034645085, 0.85408456179878522, 0.84991964001993003,
+        0.84570761468903699, 0.84144912260666926, 0.83714480759852772,
+        0.83279532041811077, 0.82840131864833244, 0.82396346660210196,
+        0.81948243522189135, 0.81495890197829479, 0.81039355076760788,
+        0.80578707180843034, 0.8011401615373136, 0.79645352250347035,
+        0.79172786326255773, 0.78696389826955504, 0.782162347770746,
+        0.77732393769482855, 0.7724493995431635, 0.76753947027918323,
+        0.76259489221697074, 0.75761641290903303, 0.7526047850332821,
+        0.74756076627923862, 0.74248511923348182, 0.73737861126435367,
+        0.73224201440594716, 0.72707610524138211, 0.72188166478539939,
+        0.71665947836627764, 0.71141033550710842, 0.7061350298064254,
+        0.70083435881822798, 0.69550912393139785, 0.6901601302485425,
+        0.68478818646427519, 0.67939410474294792, 0.67397870059586829,
+        0.66854279275800066, 0.66308720306418889, 0.65761275632490113,
+        0.65212028020153501, 0.64661060508128387, 0.64108456395159297,
+        0.63554299227422473, 0.62998672785894727, 0.62441661073687049,
+        0.61883348303344321, 0.61323818884113579, 0.60763157409182544,
+        0.6020144864289031, 0.59638777507912022, 0.59075229072419755,
+        0.58510888537221561, 0.57945841222879957, 0.57380172556812969,
+        0.56813968060378228, 0.56247313335943883, 0.55680294053946155,
+        0.55112995939937603, 0.54545504761626074, 0.53977906315908397,
+        0.53410286415898578, 0.52842730877954236, 0.5227532550870243,
+        0.51708156092066626, 0.51141308376297667, 0.50574868061009381,
+        0.50008920784222466, 0.49443552109416761, 0.48878847512595613,
+        0.48314892369362583, 0.47751771942014393, 0.47189571366649952,
+        0.46628375640299302, 0.46068269608072943, 0.45509337950334561,
+        0.44951665169898603, 0.4439533557925438, 0.43840433287819353,
+        0.43287042189222824, 0.42735245948622563, 0.42185127990055515,
+        0.41636771483825408, 0.41090259333928447, 0.40545674165519485,
+        0.4000309831242021, 0.39462613804671098, 0.38924302356130114,
+        0.38388245352118266, 0.37854523837115456, 0.37323218502507594,
+        0.36794409674387285, 0.36268177301409443, 0.3574460094270423,
+        0.35223759755848916, 0.34705732484900087, 0.3419059744848898,
+        0.33678432527980262, 0.33169315155698048, 0.32663322303218667,
+        0.32160530469734017, 0.31661015670485515, 0.31164853425272099,
+        0.30672118747032268, 0.3018288613050345, 0.29697229540959202,
+        0.29215222403026753, 0.28736937589586309, 0.28262447410753477,
+        0.27791823602947091, 0.27325137318043607, 0.26862459112620002,
+        0.26403858937286417, 0.25949406126110719, 0.25499169386136056,
+        0.25053216786993426, 0.24611615750610294, 0.24174433041017412,
+        0.23741734754255112, 0.23313586308380285, 0.22890052433576202,
+        0.22471197162366158, 0.22057083819932699, 0.21647775014543591,
+        0.21243332628086398, 0.20843817806712744, 0.20449290951593935,
+        0.20059811709789094, 0.19675438965227132, 0.19296230829804711,
+        0.18922244634600155, 0.18553536921206032, 0.18190163433180584,
+        0.17832179107620344, 0.17479638066854175, 0.17132593610260899,
+        0.16791098206210908, 0.16455203484133957, 0.16124960226713358,
+        0.15800418362208263, 0.15481626956905326, 0.15168634207700465,
+        0.14861487434812265, 0.14560233074627588, 0.14264916672681305,
+        0.13975582876770215, 0.13692275430203071, 0.13415037165186977,
+        0.13143909996352005, 0.12878934914414125, 0.12620151979977956,
+        0.12367600317480215, 0.12121318109274598, 0.1188134258985919,
+        0.11647710040247022, 0.11420455782480959, 0.11199614174293449,
+        0.10985218603912156, 0.10777301485012036, 0.10575894251814877,
+        0.1038102735433693, 0.10192730253785148, 0.10011031418103222,
+        0.098359583176674426, 0.096675374211337151, 0.095057941914357402,
+        0.093507530819354701, 0.092024375327259655, 0.090608699670877146,
+        0.089260717880984719, 0.087980633753973636, 0.086768640821038467,
+        0.085624922318917385, 0.084549651162189599, 0.083542989917132104,
+        0.082605090777143508, 0.081736095539732823, 0.080936135585082836,
+        0.080205331856186224, 0.079543794840561621, 0.078951624553548705,
+        0.078428910523187678, 0.07797573177668321, 0.077592156828457604,
+        0.077278243669791358, 0.077034039760056405, 0.076859582019540518,
+        0.076754896823865604, 0.076719999999999955
+    };
+
+    static const unsigned int s_mel_16000_512_begins[24] = {
+        1, 3, 5,
+        7, 10, 13,
+        16, 20, 24,
+        28, 33, 38,
+        43, 49, 56,
+        63, 71, 79,
+        89, 99, 110,
+        122, 136, 151
+    };
+    static const unsigned int s_mel_16000_512_lengths[24] = {
+        4, 4, 5,
+        6, 6, 7,
+        8, 8, 9,
+        10, 10, 11,
+        13, 14, 15,
+        16, 18, 20,
+        21, 23, 26,
+        29, 31, 33
+    };
+    static const double s_mel_16000_512_values[347] = {
+        0.48113830460829132, 0.96227660921658265, 0.59423441652953923,
+        0.15394844776197258, 0.40576558347046077, 0.84605155223802742,
+        0.73797473278896542, 0.33507242291900985, 0.26202526721103481,
+        0.66492757708099037, 0.93792939119261032, 0.56923658057923943,
+        0.20054376996586809, 0.062070608807389682, 0.43076341942076057,
+        0.79945623003413191, 0.84612810381186465, 0.50874014333612738,
+        0.17135218286039056, 0.15387189618813579, 0.49125985666387306,
+        0.82864781713960989, 0.84806193458871526, 0.53932080214134182,
+        0.23057966969396837, 0.15193806541128474, 0.46067919785865818,
+        0.76942033030603163, 0.92847504549302062, 0.64594840544789811,
+        0.3634217654027756, 0.080895125357653086, 0.071524954506979377,
+        0.35405159455210189, 0.6365782345972244, 0.91910487464234691,
+        0.81548854886846112, 0.55695058956758281, 0.29841263026670362,
+        0.039874670965824421, 0.18451145113153888, 0.44304941043241719,
+        0.70158736973329638, 0.96012532903417558, 0.79990290355933968,
+        0.56331680184239197, 0.32673070012544336, 0.090144598408495646,
+        0.20009709644066032, 0.43668319815760803, 0.67326929987455664,
+        0.90985540159150435, 0.86599250457842292, 0.649494379208436,
+        0.43299625383844997, 0.21649812846846306, 3.0984761423269447e-09,
+        0.13400749542157708, 0.350505620791564, 0.56700374616155003,
+        0.78350187153153694, 0.99999999690152386, 0.80188423040174595,
+        0.60376845796810041, 0.40565268553445488, 0.20753691310080846,
+        0.0094211406671629305, 0.19811576959825405, 0.39623154203189959,
+        0.59434731446554512, 0.79246308689919154, 0.99057885933283707,
+        0.82732699111083541, 0.64603276872482684, 0.46473854633881828,
+        0.28344432395281061, 0.10215010156680204, 0.17267300888916459,
+        0.35396723127517316, 0.53526145366118172, 0.71655567604718939,
+        0.89784989843319796, 0.92757582264103711, 0.76167487156176072,
+        0.59577392048248345, 0.42987296940320707, 0.26397201832393069,
+        0.098071067244654309, 0.072424177358962893, 0.23832512843823928,
+        0.40422607951751655, 0.57012703059679293, 0.73602798167606931,
+        0.90192893275534569, 0.93792939404433362, 0.78611470736112032,
+        0.63430002067790792, 0.48248533399469462, 0.33067064731148221,
+        0.17885596062826892, 0.027041273945055622, 0.062070605955665492,
+        0.21388529263887879, 0.3656999793220912, 0.51751466600530449,
+        0.6693293526885169, 0.82114403937173019, 0.97295872605494349,
+        0.88582080790973539, 0.74689635363274576, 0.60797189935575702,
+        0.4690474450787665, 0.33012299080177776, 0.19119853652478902,
+        0.052274082247798503, 0.11417919209026461, 0.25310364636725424,
+        0.39202810064424298, 0.5309525549212335, 0.66987700919822224,
+        0.80880146347521098, 0.9477259177522015, 0.92070690978553138,
+        0.79357820822299985, 0.66644950666046654, 0.53932080509793501,
+        0.41219210353540348, 0.28506340197287194, 0.15793470041034041,
+        0.03080599884780888, 0.07929309021446862, 0.20642179177700015,
+        0.33355049333953346, 0.46067919490206499, 0.58780789646459652,
+        0.71493659802712806, 0.84206529958965959, 0.96919400115219112,
+        0.91185583423130545, 0.79552133541980119, 0.67918683660829693,
+        0.56285233779679444, 0.44651783898529018, 0.33018334017378592,
+        0.21384884136228166, 0.097514342550779176, 0.088144165768694549,
+        0.20447866458019881, 0.32081316339170307, 0.43714766220320556,
+        0.55348216101470982, 0.66981665982621408, 0.78615115863771834,
+        0.90248565744922082, 0.98277781949130727, 0.87632101274836494,
+        0.76986420600542083, 0.66340739926247849, 0.55695059251953616,
+        0.45049378577659382, 0.34403697903364971, 0.23758017229070738,
+        0.13112336554776505, 0.024666558804820937, 0.01722218050869273,
+        0.12367898725163506, 0.23013579399457917, 0.33659260073752151,
+        0.44304940748046384, 0.54950621422340618, 0.65596302096635029,
+        0.76241982770929262, 0.86887663445223495, 0.97533344119517906,
+        0.92515437202927941, 0.82773656546557639, 0.73031875890187337,
+        0.63290095233817212, 0.53548314577446909, 0.43806533921076607,
+        0.34064753264706482, 0.2432297260833618, 0.14581191951965877,
+        0.048394112955957524, 0.074845627970720585, 0.17226343453442361,
+        0.26968124109812663, 0.36709904766182788, 0.46451685422553091,
+        0.56193466078923393, 0.65935246735293518, 0.7567702739166382,
+        0.85418808048034123, 0.95160588704404248, 0.95513879434267146,
+        0.86599250744907152, 0.77684622055547159, 0.68769993366186988,
+        0.59855364676826994, 0.50940735987467001, 0.42026107298107007,
+        0.33111478608746836, 0.24196849919386842, 0.15282221230026849,
+        0.063675925406668554, 0.04486120565732854, 0.13400749255092848,
+        0.22315377944452841, 0.31230006633813012, 0.40144635323173006,
+        0.49059264012532999, 0.57973892701892993, 0.66888521391253164,
+        0.75803150080613158, 0.84717778769973151, 0.93632407459333145,
+        0.97669226774354634, 0.89511518499821285, 0.81353810225287937,
+        0.73196101950754588, 0.6503839367622124, 0.56880685401687892,
+        0.48722977127154543, 0.40565268852621195, 0.32407560578087846,
+        0.24249852303554498, 0.16092144029021149, 0.079344357544878008,
+        0.023307732256453662, 0.10488481500178715, 0.18646189774712063,
+        0.26803898049245412, 0.3496160632377876, 0.43119314598312108,
+        0.51277022872845457, 0.59434731147378805, 0.67592439421912154,
+        0.75750147696445502, 0.83907855970978851, 0.92065564245512199,
+        0.99795685031006798, 0.9233062881707621, 0.84865572603145623,
+        0.77400516389215213, 0.69935460175284625, 0.62470403961354215,
+        0.55005347747423627, 0.47540291533493217, 0.4007523531956263,
+        0.32610179105632042, 0.25145122891701632, 0.17680066677771045,
+        0.10215010463840635, 0.027499542499100471, 0.0020431496899320223,
+        0.076693711829237898, 0.15134427396854377, 0.22599483610784787,
+        0.30064539824715375, 0.37529596038645785, 0.44994652252576373,
+        0.52459708466506783, 0.5992476468043737, 0.67389820894367958,
+        0.74854877108298368, 0.82319933322228955, 0.89784989536159365,
+        0.97250045750089953, 0.95685246391353829, 0.88854030760474778,
+        0.82022815129595905, 0.75191599498717032, 0.68360383867837982,
+        0.61529168236959109, 0.54697952606080236, 0.47866736975201363,
+        0.41035521344322312, 0.34204305713443439, 0.27373090082564566,
+        0.20541874451685516, 0.13710658820806643, 0.068794431899277697,
+        0.00048227559048719115, 0.043147536086461713, 0.11145969239525222,
+        0.17977184870404095, 0.24808400501282968, 0.31639616132162018,
+        0.38470831763040891, 0.45302047393919764, 0.52133263024798637,
+        0.58964478655677688, 0.65795694286556561, 0.72626909917435434,
+        0.79458125548314484, 0.86289341179193357, 0.9312055681007223,
+        0.99951772440951281, 0.93792939689605603, 0.8754174671017676,
+        0.81290553730747916, 0.75039360751319073, 0.68788167771890052,
+        0.62536974792461208, 0.56285781813032365, 0.50034588833603522,
+        0.43783395854174678, 0.37532202874745657, 0.31281009895316814,
+        0.2502981691588797, 0.18778623936459127, 0.12527430957030283,
+        0.062762379776012622, 0.00025044998172418786, 0.062070603103943967,
+        0.1245825328982324, 0.18709446269252084, 0.24960639248680927,
+        0.31211832228109948, 0.37463025207538792, 0.43714218186967635,
+        0.49965411166396478, 0.56216604145825322, 0.62467797125254343,
+        0.68718990104683186, 0.7497018308411203, 0.81221376063540873,
+        0.87472569042969717, 0.93723762022398738, 0.99974955001827581,
+        0.94302499781534799, 0.88582081077516683, 0.8286166237349839,
+        0.77141243669480275, 0.7142082496546216, 0.65700406261444044,
+        0.59979987557425929, 0.54259568853407814, 0.48539150149389698,
+        0.42818731445371405, 0.3709831274135329, 0.31377894037335174,
+        0.25657475333317059, 0.19937056629298944, 0.14216637925280828,
+        0.08496219221262713, 0.0277580051724442
+    };
+
+    static const unsigned int s_mel_8000_256_begins[24] = {
+        1, 3, 5,
+        7, 10, 13,
+        16, 20, 24,
+        28, 33, 38,
+        43, 49, 56,
+        63, 71, 79,
+        89, 99, 110,
+        122, 136, 151
+    };
+    static const unsigned int s_mel_8000_256_lengths[24] = {
+        4, 4, 5,
+        6, 6, 7,
+        8, 8, 9,
+        10, 10, 11,
+        13, 14, 15,
+        16, 18, 20,
+        21, 23, 26,
+        29, 31, 33
+    };
+    static const double s_mel_8000_256_values[347] = {
+        0.48113830460829132, 0.96227660921658265, 0.59423441652953923,
+        0.15394844776197258, 0.40576558347046077, 0.84605155223802742,
+        0.73797473278896542, 0.33507242291900985, 0.26202526721103481,
+        0.66492757708099037, 0.93792939119261032, 0.56923658057923943,
+        0.20054376996586809, 0.062070608807389682, 0.43076341942076057,
+        0.79945623003413191, 0.84612810381186465, 0.50874014333612738,
+        0.17135218286039056, 0.15387189618813579, 0.49125985666387306,
+        0.82864781713960989, 0.84806193458871526, 0.53932080214134182,
+        0.23057966969396837, 0.15193806541128474, 0.46067919785865818,
+        0.76942033030603163, 0.92847504549302062, 0.64594840544789811,
+        0.3634217654027756, 0.080895125357653086, 0.071524954506979377,
+        0.35405159455210189, 0.6365782345972244, 0.91910487464234691,
+        0.81548854886846112, 0.55695058956758281, 0.29841263026670362,
+        0.039874670965824421, 0.18451145113153888, 0.44304941043241719,
+        0.70158736973329638, 0.96012532903417558, 0.79990290355933968,
+        0.56331680184239197, 0.32673070012544336, 0.090144598408495646,
+        0.20009709644066032, 0.43668319815760803, 0.67326929987455664,
+        0.90985540159150435, 0.86599250457842292, 0.649494379208436,
+        0.43299625383844997, 0.21649812846846306, 3.0984761423269447e-09,
+        0.13400749542157708, 0.350505620791564, 0.56700374616155003,
+        0.78350187153153694, 0.99999999690152386, 0.80188423040174595,
+        0.60376845796810041, 0.40565268553445488, 0.20753691310080846,
+        0.0094211406671629305, 0.19811576959825405, 0.39623154203189959,
+        0.59434731446554512, 0.79246308689919154, 0.99057885933283707,
+        0.82732699111083541, 0.64603276872482684, 0.46473854633881828,
+        0.28344432395281061, 0.10215010156680204, 0.17267300888916459,
+        0.35396723127517316, 0.53526145366118172, 0.71655567604718939,
+        0.89784989843319796, 0.92757582264103711, 0.76167487156176072,
+        0.59577392048248345, 0.42987296940320707, 0.26397201832393069,
+        0.098071067244654309, 0.072424177358962893, 0.23832512843823928,
+        0.40422607951751655, 0.57012703059679293, 0.73602798167606931,
+        0.90192893275534569, 0.93792939404433362, 0.78611470736112032,
+        0.63430002067790792, 0.48248533399469462, 0.33067064731148221,
+        0.17885596062826892, 0.027041273945055622, 0.062070605955665492,
+        0.21388529263887879, 0.3656999793220912, 0.51751466600530449,
+        0.6693293526885169, 0.82114403937173019, 0.97295872605494349,
+        0.88582080790973539, 0.74689635363274576, 0.60797189935575702,
+        0.4690474450787665, 0.33012299080177776, 0.19119853652478902,
+        0.052274082247798503, 0.11417919209026461, 0.25310364636725424,
+        0.39202810064424298, 0.5309525549212335, 0.66987700919822224,
+        0.80880146347521098, 0.9477259177522015, 0.92070690978553138,
+        0.79357820822299985, 0.66644950666046654, 0.53932080509793501,
+        0.41219210353540348, 0.28506340197287194, 0.15793470041034041,
+        0.03080599884780888, 0.07929309021446862, 0.20642179177700015,
+        0.33355049333953346, 0.46067919490206499, 0.58780789646459652,
+        0.71493659802712806, 0.84206529958965959, 0.96919400115219112,
+        0.91185583423130545, 0.79552133541980119, 0.67918683660829693,
+        0.56285233779679444, 0.44651783898529018, 0.33018334017378592,
+        0.21384884136228166, 0.097514342550779176, 0.088144165768694549,
+        0.20447866458019881, 0.32081316339170307, 0.43714766220320556,
+        0.55348216101470982, 0.66981665982621408, 0.78615115863771834,
+        0.90248565744922082, 0.98277781949130727, 0.87632101274836494,
+        0.76986420600542083, 0.66340739926247849, 0.55695059251953616,
+        0.45049378577659382, 0.34403697903364971, 0.23758017229070738,
+        0.13112336554776505, 0.024666558804820937, 0.01722218050869273,
+        0.12367898725163506, 0.23013579399457917, 0.33659260073752151,
+        0.44304940748046384, 0.54950621422340618, 0.65596302096635029,
+        0.76241982770929262, 0.86887663445223495, 0.97533344119517906,
+        0.92515437202927941, 0.82773656546557639, 0.73031875890187337,
+        0.63290095233817212, 0.53548314577446909, 0.43806533921076607,
+        0.34064753264706482, 0.2432297260833618, 0.14581191951965877,
+        0.048394112955957524, 0.074845627970720585, 0.17226343453442361,
+        0.26968124109812663, 0.36709904766182788, 0.46451685422553091,
+        0.56193466078923393, 0.65935246735293518, 0.7567702739166382,
+        0.85418808048034123, 0.95160588704404248, 0.95513879434267146,
+        0.86599250744907152, 0.77684622055547159, 0.68769993366186988,
+        0.59855364676826994, 0.50940735987467001, 0.42026107298107007,
+        0.33111478608746836, 0.24196849919386842, 0.15282221230026849,
+        0.063675925406668554, 0.04486120565732854, 0.13400749255092848,
+        0.22315377944452841, 0.31230006633813012, 0.40144635323173006,
+        0.49059264012532999, 0.57973892701892993, 0.66888521391253164,
+        0.75803150080613158, 0.84717778769973151, 0.93632407459333145,
+        0.97669226774354634, 0.89511518499821285, 0.81353810225287937,
+        0.73196101950754588, 0.6503839367622124, 0.56880685401687892,
+        0.48722977127154543, 0.40565268852621195, 0.32407560578087846,
+        0.24249852303554498, 0.16092144029021149, 0.079344357544878008,
+        0.023307732256453662, 0.10488481500178715, 0.18646189774712063,
+        0.26803898049245412, 0.3496160632377876, 0.43119314598312108,
+        0.51277022872845457, 0.59434731147378805, 0.67592439421912154,
+        0.75750147696445502, 0.83907855970978851, 0.92065564245512199,
+        0.99795685031006798, 0.9233062881707621, 0.84865572603145623,
+        0.77400516389215213, 0.69935460175284625, 0.62470403961354215,
+        0.55005347747423627, 0.47540291533493217, 0.4007523531956263,
+        0.32610179105632042, 0.25145122891701632, 0.17680066677771045,
+        0.10215010463840635, 0.027499542499100471, 0.0020431496899320223,
+        0.076693711829237898, 0.15134427396854377, 0.22599483610784787,
+        0.30064539824715375, 0.37529596038645785, 0.44994652252576373,
+        0.52459708466506783, 0.5992476468043737, 0.67389820894367958,
+        0.74854877108298368, 0.82319933322228955, 0.89784989536159365,
+        0.97250045750089953, 0.95685246391353829, 0.88854030760474778,
+        0.82022815129595905, 0.75191599498717032, 0.68360383867837982,
+        0.61529168236959109, 0.54697952606080236, 0.47866736975201363,
+        0.41035521344322312, 0.34204305713443439, 0.27373090082564566,
+        0.20541874451685516, 0.13710658820806643, 0.068794431899277697,
+        0.00048227559048719115, 0.043147536086461713, 0.11145969239525222,
+        0.17977184870404095, 0.24808400501282968, 0.31639616132162018,
+        0.38470831763040891, 0.45302047393919764, 0.52133263024798637,
+        0.58964478655677688, 0.65795694286556561, 0.72626909917435434,
+        0.79458125548314484, 0.86289341179193357, 0.9312055681007223,
+        0.99951772440951281, 0.93792939689605603, 0.8754174671017676,
+        0.81290553730747916, 0.75039360751319073, 0.68788167771890052,
+        0.62536974792461208, 0.56285781813032365, 0.50034588833603522,
+        0.43783395854174678, 0.37532202874745657, 0.31281009895316814,
+        0.2502981691588797, 0.18778623936459127, 0.12527430957030283,
+        0.062762379776012622, 0.00025044998172418786, 0.062070603103943967,
+        0.1245825328982324, 0.18709446269252084, 0.24960639248680927,
+        0.31211832228109948, 0.37463025207538792, 0.43714218186967635,
+        0.49965411166396478, 0.56216604145825322, 0.62467797125254343,
+        0.68718990104683186, 0.7497018308411203, 0.81221376063540873,
+        0.87472569042969717, 0.93723762022398738, 0.99974955001827581,
+        0.94302499781534799, 0.88582081077516683, 0.8286166237349839,
+        0.77141243669480275, 0.7142082496546216, 0.65700406261444044,
+        0.59979987557425929, 0.54259568853407814, 0.48539150149389698,
+        0.42818731445371405, 0.3709831274135329, 0.31377894037335174,
+        0.25657475333317059, 0.19937056629298944, 0.14216637925280828,
+        0.08496219221262713, 0.0277580051724442
+    };
+
+    static const double s_dct_24[576] = {
+        0.20412414523193151, 0.20412414523193151, 0.20412414523193151,
+        0.20412414523193151, 0.20412414523193151, 0.20412414523193151,
+        0.20412414523193151, 0.20412414523193151, 0.20412414523193151,
+        0.20412414523193151, 0.20412414523193151, 0.20412414523193151,
+        0.20412414523193151, 0.20412414523193151, 0.20412414523193151,
+        0.20412414523193151, 0.20412414523193151, 0.20412414523193151,
+        0.20412414523193151, 0.20412414523193151, 0.20412414523193151,
+        0.20412414523193151, 0.20412414523193151, 0.20412414523193151,
+        0.28805705897253892, 0.28312832282901385, 0.27335518258388319,
+        0.25890485937636765, 0.24002460224293412, 0.21703745761773199,
+        0.19033674191853897, 0.16037931179380527, 0.12767774717873367,
+        0.092791580910474888, 0.056317724966151228, 0.018880257133433546,
+        -0.018880257133433512, -0.056317724966151186, -0.092791580910474847,
+        -0.12767774717873365, -0.16037931179380524, -0.19033674191853897,
+        -0.21703745761773197, -0.24002460224293407, -0.25890485937636754,
+        -0.27335518258388319, -0.28312832282901385, -0.28805705897253892,
+        0.2862054788004203, 0.26670104839708847, 0.22902138228981669,
+        0.17573428745522304, 0.11047119134519727, 0.037679666107271845,
+        -0.03767966610727181, -0.11047119134519717, -0.17573428745522304,
+        -0.22902138228981664, -0.26670104839708847, -0.2862054788004203,
+        -0.2862054788004203, -0.26670104839708852, -0.22902138228981669,
+        -0.17573428745522313, -0.11047119134519717, -0.037679666107271817,
+        0.037679666107271713, 0.11047119134519708, 0.17573428745522282,
+        0.22902138228981661, 0.26670104839708852, 0.2862054788004203,
+        0.28312832282901385, 0.24002460224293412, 0.16037931179380527,
+        0.056317724966151228, -0.056317724966151186, -0.16037931179380513,
+        -0.24002460224293415, -0.28312832282901379, -0.28312832282901379,
+        -0.24002460224293418, -0.16037931179380521, -0.056317724966151325,
+        0.056317724966151221, 0.1603793117938051, 0.24002460224293398,
+        0.28312832282901379, 0.28312832282901385, 0.24002460224293407,
+        0.16037931179380524, 0.05631772496615136, -0.056317724966150937,
+        -0.16037931179380507, -0.24002460224293409, -0.28312832282901385,
+        0.27883876791260265, 0.20412414523193151, 0.074714622680671111,
+        -0.074714622680671083, -0.20412414523193148, -0.27883876791260259,
+        -0.27883876791260265, -0.20412414523193162, -0.074714622680671083,
+        0.074714622680670986, 0.20412414523193145, 0.27883876791260254,
+        0.27883876791260259, 0.20412414523193154, 0.074714622680671111,
+        -0.074714622680670958, -0.20412414523193162, -0.27883876791260265,
+        -0.27883876791260265, -0.20412414523193176, -0.074714622680671638,
+        0.074714622680670931, 0.20412414523193156, 0.27883876791260259,
+        0.27335518258388319, 0.16037931179380527, -0.018880257133433512,
+        -0.19033674191853897, -0.28312832282901385, -0.2589048593763677,
+        -0.1276777471787337, 0.056317724966151221, 0.21703745761773202,
+        0.28805705897253892, 0.24002460224293407, 0.092791580910475194,
+        -0.092791580910474791, -0.24002460224293409, -0.28805705897253892,
+        -0.21703745761773197, -0.056317724966151145, 0.12767774717873331,
+        0.25890485937636742, 0.2831283228290139, 0.19033674191853919,
+        0.018880257133433751, -0.16037931179380502, -0.2733551825838833,
+        0.26670104839708847, 0.11047119134519727, -0.11047119134519717,
+        -0.26670104839708847, -0.26670104839708852, -0.11047119134519742,
+        0.11047119134519733, 0.2667010483970883, 0.26670104839708836,
+        0.11047119134519745, -0.11047119134519728, -0.26670104839708841,
+        -0.26670104839708847, -0.11047119134519748, 0.11047119134519678,
+        0.26670104839708841, 0.26670104839708847, 0.11047119134519705,
+        -0.11047119134519723, -0.26670104839708841, -0.26670104839708869,
+        -0.11047119134519755, 0.1104711913451972, 0.26670104839708852,
+        0.25890485937636765, 0.056317724966151228, -0.19033674191853897,
+        -0.28805705897253892, -0.16037931179380521, 0.092791580910474583,
+        0.27335518258388325, 0.24002460224293434, 0.018880257133433428,
+        -0.21703745761773183, -0.28312832282901379, -0.12767774717873401,
+        0.12767774717873379, 0.28312832282901373, 0.21703745761773199,
+        -0.018880257133432922, -0.24002460224293407, -0.27335518258388325,
+        -0.092791580910474569, 0.16037931179380502, 0.28805705897253886,
+        0.19033674191853925, -0.056317724966151304, -0.25890485937636742,
+        0.25, 1.7676253978748448e-17, -0.25,
+        -0.25000000000000006, -5.302876193624534e-17, 0.24999999999999992,
+        0.24999999999999997, 3.4477629474488409e-16, -0.25000000000000006,
+        -0.25000000000000011, -1.2373377785123914e-16, 0.24999999999999975,
+        0.24999999999999986, 1.5908628580873602e-16, -0.24999999999999997,
+        -0.25000000000000017, 3.1835125593605077e-16, 0.24999999999999997,
+        0.25000000000000022, 7.4258135142601349e-16, -0.24999999999999942,
+        -0.25000000000000022, 2.4764624002105699e-16, 0.24999999999999994,
+        0.24002460224293412, -0.056317724966151186, -0.28312832282901385,
+        -0.16037931179380521, 0.1603793117938051, 0.2831283228290139,
+        0.05631772496615136, -0.24002460224293409, -0.2400246022429342,
+        0.056317724966150902, 0.28312832282901385, 0.16037931179380571,
+        -0.16037931179380502, -0.28312832282901379, -0.056317724966150708,
+        0.24002460224293376, 0.24002460224293398, -0.056317724966150291,
+        -0.28312832282901385, -0.16037931179380538, 0.16037931179380407,
+        0.28312832282901373, 0.056317724966150812, -0.24002460224293429,
+        0.22902138228981669, -0.11047119134519717, -0.2862054788004203,
+        -0.037679666107271817, 0.26670104839708852, 0.17573428745522335,
+        -0.17573428745522301, -0.26670104839708847, 0.0376796661072719,
+        0.28620547880042035, 0.11047119134519705, -0.22902138228981622,
+        -0.22902138228981678, 0.1104711913451972, 0.2862054788004203,
+        0.037679666107271741, -0.26670104839708852, -0.17573428745522368,
+        0.17573428745522243, 0.26670104839708875, -0.037679666107271213,
+        -0.28620547880042024, -0.11047119134519767, 0.22902138228981705,
+        0.21703745761773199, -0.16037931179380524, -0.25890485937636759,
+        0.092791580910474819, 0.28312832282901385, -0.018880257133433252,
+        -0.28805705897253892, -0.056317724966151644, 0.2733551825838833,
+        0.12767774717873404, -0.24002460224293407, -0.19033674191853922,
+        0.19033674191853894, 0.24002460224293456, -0.12767774717873323,
+        -0.27335518258388358, 0.056317724966151263, 0.28805705897253897,
+        0.01888025713343287, -0.28312832282901362, -0.092791580910475666,
+        0.25890485937636687, 0.16037931179380463, -0.21703745761773199,
+        0.20412414523193151, -0.20412414523193148, -0.20412414523193162,
+        0.20412414523193145, 0.20412414523193154, -0.20412414523193126,
+        -0.20412414523193137, 0.20412414523193087, 0.20412414523193106,
+        -0.2041241452319312, -0.20412414523193145, 0.20412414523193115,
+        0.20412414523193148, -0.20412414523193115, -0.2041241452319322,
+        0.20412414523193112, 0.20412414523193151, -0.20412414523193184,
+        -0.20412414523193154, 0.20412414523193106, 0.20412414523193231,
+        -0.20412414523193106, -0.20412414523193162, 0.20412414523193173,
+        0.19033674191853897, -0.24002460224293407, -0.1276777471787337,
+        0.27335518258388319, 0.05631772496615136, -0.28805705897253892,
+        0.018880257133433474, 0.2831283228290139, -0.092791580910474722,
+        -0.25890485937636759, 0.16037931179380502, 0.21703745761773238,
+        -0.21703745761773208, -0.16037931179380538, 0.25890485937636737,
+        0.092791580910475638, -0.28312832282901379, -0.018880257133433928,
+        0.28805705897253897, -0.056317724966151159, -0.27335518258388336,
+        0.12767774717873306, 0.24002460224293465, -0.19033674191853953,
+        0.17573428745522304, -0.26670104839708847, -0.037679666107271817,
+        0.28620547880042035, -0.11047119134519728, -0.22902138228981703,
+        0.22902138228981689, 0.11047119134519799, -0.28620547880042035,
+        0.037679666107271317, 0.2667010483970883, -0.17573428745522249,
+        -0.1757342874552229, 0.26670104839708814, 0.03767966610727181,
+        -0.28620547880042047, 0.11047119134519706, 0.22902138228981689,
+        -0.22902138228981703, -0.11047119134519774, 0.28620547880042008,
+        -0.037679666107271075, -0.26670104839708841, 0.17573428745522229,
+        0.16037931179380527, -0.28312832282901385, 0.056317724966151221,
+        0.24002460224293407, -0.24002460224293409, -0.056317724966151644,
+        0.28312832282901379, -0.16037931179380502, -0.16037931179380532,
+        0.28312832282901362, -0.056317724966151304, -0.24002460224293456,
+        0.2400246022429337, 0.056317724966151818, -0.2831283228290139,
+        0.16037931179380488, 0.16037931179380463, -0.28312832282901362,
+        0.05631772496615213, 0.24002460224293465, -0.24002460224293359,
+        -0.056317724966151991, 0.28312832282901357, -0.16037931179380471,
+        0.14433756729740646, -0.28867513459481287, 0.14433756729740646,
+        0.1443375672974066, -0.28867513459481287, 0.14433756729740618,
+        0.14433756729740641, -0.28867513459481287, 0.14433756729740657,
+        0.1443375672974069, -0.28867513459481287, 0.1443375672974056,
+        0.1443375672974061, -0.28867513459481287, 0.14433756729740643,
+        0.14433756729740704, -0.28867513459481287, 0.14433756729740638,
+        0.1443375672974071, -0.28867513459481287, 0.14433756729740455,
+        0.14433756729740718, -0.28867513459481287, 0.14433756729740627,
+        0.12767774717873367, -0.28312832282901385, 0.21703745761773202,
+        0.018880257133433685, -0.2400246022429342, 0.27335518258388297,
+        -0.092791580910474722, -0.16037931179380616, 0.28805705897253886,
+        -0.19033674191853892, -0.056317724966150784, 0.25890485937636765,
+        -0.25890485937636781, 0.0563177249661512, 0.19033674191853936,
+        -0.28805705897253892, 0.16037931179380568, 0.092791580910475763,
+        -0.27335518258388336, 0.24002460224293304, -0.018880257133432062,
+        -0.2170374576177326, 0.28312832282901373, -0.12767774717873384,
+        0.11047119134519727, -0.26670104839708852, 0.26670104839708852,
+        -0.11047119134519728, -0.11047119134519748, 0.26670104839708869,
+        -0.26670104839708841, 0.1104711913451972, 0.11047119134519758,
+        -0.26670104839708875, 0.26670104839708852, -0.11047119134519616,
+        -0.11047119134519767, 0.26670104839708841, -0.26670104839708886,
+        0.11047119134519603, 0.11047119134519683, -0.26670104839708925,
+        0.26670104839708847, -0.1104711913451969, -0.11047119134519977,
+        0.26670104839708808, -0.2667010483970888, 0.11047119134519774,
+        0.092791580910474888, -0.24002460224293418, 0.28805705897253892,
+        -0.21703745761773183, 0.056317724966150902, 0.12767774717873404,
+        -0.25890485937636759, 0.28312832282901362, -0.19033674191853892,
+        0.018880257133432304, 0.16037931179380541, -0.2733551825838833,
+        0.27335518258388308, -0.16037931179380485, -0.018880257133432977,
+        0.19033674191853941, -0.28312832282901373, 0.25890485937636726,
+        -0.12767774717873207, -0.056317724966154073, 0.21703745761773194,
+        -0.28805705897253897, 0.24002460224293409, -0.092791580910475707,
+        0.074714622680671111, -0.20412414523193162, 0.27883876791260259,
+        -0.27883876791260265, 0.20412414523193156, -0.074714622680670389,
+        -0.074714622680671222, 0.20412414523193148, -0.27883876791260254,
+        0.2788387679126027, -0.20412414523193184, 0.074714622680669723,
+        0.074714622680671389, -0.20412414523193162, 0.27883876791260265,
+        -0.27883876791260265, 0.2041241452319317, -0.074714622680669543,
+        -0.074714622680672554, 0.20412414523193245, -0.27883876791260293,
+        0.27883876791260231, -0.20412414523193084, 0.074714622680672346,
+        0.056317724966151228, -0.16037931179380521, 0.24002460224293407,
+        -0.28312832282901379, 0.28312832282901385, -0.24002460224293376,
+        0.16037931179380502, -0.056317724966150291, -0.056317724966150784,
+        0.16037931179380541, -0.24002460224293348, 0.28312832282901396,
+        -0.28312832282901362, 0.2400246022429342, -0.1603793117938048,
+        0.056317724966150048, 0.05631772496615102, -0.16037931179380563,
+        0.24002460224293359, -0.28312832282901379, 0.28312832282901335,
+        -0.24002460224293351, 0.16037931179380543, -0.056317724966150812,
+        0.037679666107271845, -0.11047119134519717, 0.17573428745522296,
+        -0.22902138228981672, 0.26670104839708847, -0.28620547880042035,
+        0.28620547880042041, -0.26670104839708819, 0.22902138228981711,
+        -0.17573428745522243, 0.11047119134519706, -0.037679666107271144,
+        -0.037679666107271914, 0.11047119134519873, -0.17573428745522385,
+        0.22902138228981822, -0.26670104839708847, 0.28620547880042047,
+        -0.28620547880042047, 0.26670104839708764, -0.22902138228981564,
+        0.17573428745522049, -0.11047119134519859, 0.037679666107271768,
+        0.018880257133433546, -0.056317724966151325, 0.092791580910474708,
+        -0.12767774717873401, 0.16037931179380571, -0.19033674191853922,
+        0.21703745761773169, -0.24002460224293456, 0.25890485937636765,
+        -0.2733551825838833, 0.28312832282901396, -0.28805705897253897,
+        0.28805705897253897, -0.28312832282901357, 0.27335518258388336,
+        -0.2589048593763677, 0.24002460224293412, -0.21703745761773183,
+        0.19033674191853861, -0.16037931179380463, 0.12767774717873098,
+        -0.092791580910471752, 0.056317724966151783, -0.018880257133433824
+    };
+
+    const PrecomputedWindow PRECOMPUTED_WINDOWS[] = {
+        {WIN_HAMMING, 256, s_win_hamming_256},
+        {WIN_HAMMING, 512, s_win_hamming_512}
+    };
+    const unsigned int PRECOMPUTED_WINDOWS_COUNT = 2;
+
+    const PrecomputedMelBank PRECOMPUTED_MEL_BANKS[] = {
+        {16000.0, 200, 512,
+         s_mel_16000_512_begins, s_mel_16000_512_lengths,
+         s_mel_16000_512_values},
+        {8000.0, 200, 256,
+         s_mel_8000_256_begins, s_mel_8000_256_lengths,
+         s_mel_8000_256_values}
+    };
+    const unsigned int PRECOMPUTED_MEL_BANKS_COUNT = 2;
+
+    const PrecomputedDct PRECOMPUTED_DCTS[] = {
+        {24, 24, 24, s_dct_24}
+    };
+    const unsigned int PRECOMPUTED_DCTS_COUNT = 1;
+}
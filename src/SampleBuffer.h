@@ -0,0 +1,148 @@
+/**
+ * @file SampleBuffer.h
+ *
+ * Native-width sample storage - header.
+ *
+ * A buffer stores samples of a single channel in their native type
+ * (8, 16 or 32-bit integers or floats), so that 16-bit audio takes
+ * only two bytes per sample in memory.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#ifndef SAMPLEBUFFER_H
+#define SAMPLEBUFFER_H
+
+#include "global.h"
+#include "AlignedAllocator.h"
+#include "SampleSpan.h"
+#include <cstddef>
+#include <vector>
+
+namespace Aquila
+{
+    /**
+     * Samples of a single channel, stored in their native type.
+     *
+     * The sample type is chosen at runtime by resize<T>(), and samples
+     * are accessed through getData<T>() or as a SampleSpan.
+     */
+    class AQUILA_EXPORT SampleBuffer
+    {
+    public:
+        /**
+         * Creates an empty buffer.
+         */
+        SampleBuffer():
+            format(SAMPLE_INT32), length(0)
+        {
+        }
+
+        /**
+         * Sets sample type and number of samples.
+         *
+         * Previous contents are lost.
+         *
+         * @param count number of samples
+         * @return pointer to count samples
+         */
+        template <typename T>
+        T* resize(sampleIndexType count)
+        {
+            format = SampleTraits<T>::format;
+            length = count;
+            bytes.resize(count * sizeof(T));
+            return getData<T>();
+        }
+
+        /**
+         * Removes all samples.
+         *
+         * As with std::vector, the memory is kept for reuse.
+         */
+        void clear()
+        {
+            bytes.clear();
+            length = 0;
+        }
+
+        /**
+         * Returns a pointer to the samples.
+         *
+         * @return pointer to getLength() samples, or 0 when the buffer
+         * is empty or holds samples of another type
+         */
+        template <typename T>
+        T* getData()
+        {
+            return (SampleTraits<T>::format == format && length > 0) ?
+                reinterpret_cast<T*>(&bytes[0]) : 0;
+        }
+
+        /**
+         * Returns a const pointer to the samples.
+         *
+         * @return pointer to getLength() samples, or 0 when the buffer
+         * is empty or holds samples of another type
+         */
+        template <typename T>
+        const T* getData() const
+        {
+            return (SampleTraits<T>::format == format && length > 0) ?
+                reinterpret_cast<const T*>(&bytes[0]) : 0;
+        }
+
+        /**
+         * Returns a view of the samples.
+         *
+         * @return span of getLength() samples
+         */
+        SampleSpan getSpan() const
+        {
+            return SampleSpan(length > 0 ? &bytes[0] : 0, format, length);
+        }
+
+        /**
+         * Returns type of the stored samples.
+         *
+         * @return sample format
+         */
+        SampleFormat getFormat() const { return format; }
+
+        /**
+         * Returns number of stored samples.
+         *
+         * @return sample count
+         */
+        sampleIndexType getLength() const { return length; }
+
+        /**
+         * Returns size of the stored samples.
+         *
+         * @return number of bytes
+         */
+        std::size_t getByteSize() const { return bytes.size(); }
+
+    private:
+        /**
+         * Raw storage, aligned for vectorized kernels.
+         */
+        typedef std::vector<char, AlignedAllocator<char> > byteVector;
+        byteVector bytes;
+
+        /**
+         * Type of the stored samples.
+         */
+        SampleFormat format;
+
+        /**
+         * Number of stored samples.
+         */
+        sampleIndexType length;
+    };
+}
+
+#endif // SAMPLEBUFFER_H
@@ -0,0 +1,277 @@
+/**
+ * @file SampleSpan.h
+ *
+ * A read-only view of audio samples - header.
+ *
+ * A span describes samples stored elsewhere (in a channel vector or
+ * directly in a memory-mapped file) without copying them. Samples keep
+ * their native format and can be interleaved with other channels.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#ifndef SAMPLESPAN_H
+#define SAMPLESPAN_H
+
+#include "global.h"
+#include <boost/cstdint.hpp>
+
+namespace Aquila
+{
+    /**
+     * Possible formats of samples viewed by a span.
+     *
+     * SAMPLE_UINT8 - unsigned 8-bit samples, as in 8-bit .wav files
+     * SAMPLE_INT16 - signed 16-bit samples
+     * SAMPLE_INT32 - signed 32-bit samples, eg. WaveFile channel vectors
+     * SAMPLE_INT8 - signed 8-bit samples
+     * SAMPLE_FLOAT - single precision samples, in the same units as
+     * integer samples
+     */
+    enum SampleFormat { SAMPLE_UINT8, SAMPLE_INT16, SAMPLE_INT32,
+                        SAMPLE_INT8, SAMPLE_FLOAT };
+
+
+    /**
+     * Sample format corresponding to a C++ sample type.
+     */
+    template <typename T>
+    struct SampleTraits;
+
+    template <>
+    struct SampleTraits<boost::int8_t>
+    {
+        static const SampleFormat format = SAMPLE_INT8;
+    };
+
+    template <>
+    struct SampleTraits<boost::int16_t>
+    {
+        static const SampleFormat format = SAMPLE_INT16;
+    };
+
+    template <>
+    struct SampleTraits<boost::int32_t>
+    {
+        static const SampleFormat format = SAMPLE_INT32;
+    };
+
+    template <>
+    struct SampleTraits<float>
+    {
+        static const SampleFormat format = SAMPLE_FLOAT;
+    };
+
+
+    /**
+     * A read-only view of samples of a single channel.
+     *
+     * Consecutive samples are stride samples apart, so that a span can
+     * view one channel of interleaved data. The viewed memory must outlive
+     * the span.
+     */
+    struct SampleSpan
+    {
+        /**
+         * Creates an empty span.
+         */
+        SampleSpan():
+            data(0), format(SAMPLE_INT32), length(0), stride(1)
+        {
+        }
+
+        /**
+         * Creates a span viewing given samples.
+         *
+         * @param samples pointer to the first sample
+         * @param sampleFormat format of the samples
+         * @param count number of samples
+         * @param sampleStride distance between consecutive samples
+         */
+        SampleSpan(const void* samples, SampleFormat sampleFormat,
+                   sampleIndexType count, unsigned int sampleStride = 1):
+            data(samples), format(sampleFormat), length(count),
+            stride(sampleStride)
+        {
+        }
+
+        /**
+         * Creates a span viewing an array of native samples.
+         *
+         * @param samples pointer to the first sample
+         * @param count number of samples
+         * @param sampleStride distance between consecutive samples
+         * @return span of count samples
+         */
+        template <typename T>
+        static SampleSpan of(const T* samples, sampleIndexType count,
+                             unsigned int sampleStride = 1)
+        {
+            return SampleSpan(samples, SampleTraits<T>::format, count,
+                              sampleStride);
+        }
+
+        /**
+         * Returns value of a sample.
+         *
+         * Unsigned 8-bit samples are moved by half of the dynamic range,
+         * so that all values are signed. Floating point samples are
+         * rounded to the nearest integer.
+         *
+         * @param i sample index
+         * @return sample value
+         */
+        int operator[](sampleIndexType i) const
+        {
+            switch (format)
+            {
+            case SAMPLE_UINT8:
+                return static_cast<const boost::uint8_t*>(data)[i * stride] - 128;
+            case SAMPLE_INT8:
+                return static_cast<const boost::int8_t*>(data)[i * stride];
+            case SAMPLE_INT16:
+                return static_cast<const boost::int16_t*>(data)[i * stride];
+            case SAMPLE_FLOAT:
+                return roundSample(
+                    static_cast<const float*>(data)[i * stride]);
+            default:
+                return static_cast<const boost::int32_t*>(data)[i * stride];
+            }
+        }
+
+        /**
+         * Checks whether the span views contiguous samples of a given type.
+         *
+         * @return true, if samples can be read directly as a T array
+         */
+        template <typename T>
+        bool isContiguous() const
+        {
+            return SampleTraits<T>::format == format && 1 == stride;
+        }
+
+        /**
+         * Returns a span of a part of the samples.
+         *
+         * @param begin index of the first sample
+         * @param end index one past the last sample
+         * @return span of end - begin samples
+         */
+        SampleSpan subspan(sampleIndexType begin, sampleIndexType end) const
+        {
+            return SampleSpan(static_cast<const char*>(data) +
+                              begin * stride * getSampleSize(format),
+                              format, end - begin, stride);
+        }
+
+        /**
+         * Converts all samples to integers.
+         *
+         * @param output array of length integers
+         */
+        void copyTo(int* output) const
+        {
+            switch (format)
+            {
+            case SAMPLE_UINT8:
+            {
+                const boost::uint8_t* in = static_cast<const boost::uint8_t*>(data);
+                for (sampleIndexType i = 0; i < length; ++i)
+                    output[i] = in[i * stride] - 128;
+                break;
+            }
+            case SAMPLE_INT8:
+            {
+                const boost::int8_t* in = static_cast<const boost::int8_t*>(data);
+                for (sampleIndexType i = 0; i < length; ++i)
+                    output[i] = in[i * stride];
+                break;
+            }
+            case SAMPLE_INT16:
+            {
+                const boost::int16_t* in = static_cast<const boost::int16_t*>(data);
+                for (sampleIndexType i = 0; i < length; ++i)
+                    output[i] = in[i * stride];
+                break;
+            }
+            case SAMPLE_FLOAT:
+            {
+                const float* in = static_cast<const float*>(data);
+                for (sampleIndexType i = 0; i < length; ++i)
+                    output[i] = roundSample(in[i * stride]);
+                break;
+            }
+            default:
+            {
+                const boost::int32_t* in = static_cast<const boost::int32_t*>(data);
+                for (sampleIndexType i = 0; i < length; ++i)
+                    output[i] = in[i * stride];
+                break;
+            }
+            }
+        }
+
+        /**
+         * Returns size of a single sample.
+         *
+         * @param sampleFormat sample format
+         * @return number of bytes
+         */
+        static unsigned int getSampleSize(SampleFormat sampleFormat)
+        {
+            switch (sampleFormat)
+            {
+            case SAMPLE_UINT8:
+            case SAMPLE_INT8:
+                return 1;
+            case SAMPLE_INT16:
+                return 2;
+            default:
+                return 4;
+            }
+        }
+
+        /**
+         * Rounds a floating point sample to the nearest integer.
+         *
+         * Values out of the int range are saturated; the upper limit is
+         * the largest float below 2^31.
+         *
+         * @param value sample value
+         * @return rounded value
+         */
+        static int roundSample(float value)
+        {
+            if (value < -2147483648.0f)
+                value = -2147483648.0f;
+            if (value > 2147483520.0f)
+                value = 2147483520.0f;
+            return static_cast<int>(value < 0 ? value - 0.5f : value + 0.5f);
+        }
+
+        /**
+         * Pointer to the first sample.
+         */
+        const void* data;
+
+        /**
+         * Format of the samples.
+         */
+        SampleFormat format;
+
+        /**
+         * Number of samples.
+         */
+        sampleIndexType length;
+
+        /**
+         * Distance between consecutive samples, in samples.
+         */
+        unsigned int stride;
+    };
+}
+
+#endif // SAMPLESPAN_H
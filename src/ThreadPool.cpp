@@ -0,0 +1,173 @@
+/**
+ * @file ThreadPool.cpp
+ *
+ * A simple pool of worker threads - implementation.
+ *
+ * The pool runs parallel loops: a task is split into a number of
+ * independent parts, which are picked by the worker threads (and the
+ * calling thread) until all of them are done.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#include "ThreadPool.h"
+
+#include <boost/bind.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/once.hpp>
+
+namespace Aquila
+{
+    /**
+     * The default pool, created on first use.
+     */
+    static ThreadPool* s_defaultPool = 0;
+
+    /**
+     * Makes sure the default pool is created only once.
+     */
+    static boost::once_flag s_defaultPoolFlag = BOOST_ONCE_INIT;
+
+    /**
+     * Creates the default pool.
+     */
+    static void createDefaultPool()
+    {
+        static ThreadPool pool;
+        s_defaultPool = &pool;
+    }
+
+    /**
+     * Starts the worker threads.
+     *
+     * @param threadsCount number of threads running the tasks, including
+     *                     the calling thread; 0 means one per processor
+     */
+    ThreadPool::ThreadPool(unsigned int threadsCount):
+        task(0), count(0), next(0), busy(0), generation(0), stopping(false)
+    {
+        if (0 == threadsCount)
+            threadsCount = boost::thread::hardware_concurrency();
+
+        for (unsigned int i = 1; i < threadsCount; ++i)
+        {
+            workers.push_back(new boost::thread(
+                boost::bind(&ThreadPool::workerLoop, this, i)));
+        }
+    }
+
+    /**
+     * Stops and joins the worker threads.
+     */
+    ThreadPool::~ThreadPool()
+    {
+        {
+            boost::lock_guard<boost::mutex> lock(mutex);
+            stopping = true;
+        }
+        taskReady.notify_all();
+
+        for (unsigned int i = 0; i < workers.size(); ++i)
+        {
+            workers[i]->join();
+            delete workers[i];
+        }
+    }
+
+    /**
+     * Runs all parts of the task and waits until they are finished.
+     *
+     * The calling thread takes part in the computation.
+     *
+     * @param task the task to run
+     * @param count number of its parts
+     */
+    void ThreadPool::run(ParallelTask& task, unsigned int count)
+    {
+        if (workers.empty() || count < 2)
+        {
+            for (unsigned int i = 0; i < count; ++i)
+                task.run(i, 0);
+            return;
+        }
+
+        boost::lock_guard<boost::mutex> runLock(runMutex);
+        {
+            boost::lock_guard<boost::mutex> lock(mutex);
+            this->task = &task;
+            this->count = count;
+            next = 0;
+            busy = workers.size();
+            ++generation;
+        }
+        taskReady.notify_all();
+
+        work(0);
+
+        boost::unique_lock<boost::mutex> lock(mutex);
+        while (busy > 0)
+            taskDone.wait(lock);
+        this->task = 0;
+    }
+
+    /**
+     * Returns the process-wide pool with one thread per processor.
+     *
+     * @return reference to the default pool
+     */
+    ThreadPool& ThreadPool::getDefault()
+    {
+        boost::call_once(&createDefaultPool, s_defaultPoolFlag);
+        return *s_defaultPool;
+    }
+
+    /**
+     * Runs parts of the current task until none is left.
+     *
+     * @param thread number of the running thread
+     */
+    void ThreadPool::work(unsigned int thread)
+    {
+        for (;;)
+        {
+            unsigned int index;
+            {
+                boost::lock_guard<boost::mutex> lock(mutex);
+                if (next >= count)
+                    return;
+                index = next++;
+            }
+            task->run(index, thread);
+        }
+    }
+
+    /**
+     * Main loop of a worker thread.
+     *
+     * @param thread number of the worker thread
+     */
+    void ThreadPool::workerLoop(unsigned int thread)
+    {
+        unsigned int seen = 0;
+        for (;;)
+        {
+            {
+                boost::unique_lock<boost::mutex> lock(mutex);
+                while (generation == seen && !stopping)
+                    taskReady.wait(lock);
+                if (stopping)
+                    return;
+                seen = generation;
+            }
+
+            work(thread);
+
+            boost::lock_guard<boost::mutex> lock(mutex);
+            if (0 == --busy)
+                taskDone.notify_all();
+        }
+    }
+}
@@ -0,0 +1,126 @@
+/**
+ * @file ThreadPool.h
+ *
+ * A simple pool of worker threads - header.
+ *
+ * The pool runs parallel loops: a task is split into a number of
+ * independent parts, which are picked by the worker threads (and the
+ * calling thread) until all of them are done.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include "global.h"
+#include <vector>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace Aquila
+{
+    /**
+     * Interface of a task run by the thread pool.
+     */
+    class AQUILA_EXPORT ParallelTask
+    {
+    public:
+        virtual ~ParallelTask() {}
+
+        /**
+         * Computes one part of the task.
+         *
+         * Parts are run concurrently, in any order.
+         *
+         * @param index number of the part
+         * @param thread number of the thread running it, less than
+         *               ThreadPool::getThreadsCount(), for per-thread buffers
+         */
+        virtual void run(unsigned int index, unsigned int thread) = 0;
+    };
+
+
+    /**
+     * A pool of worker threads running parallel tasks.
+     *
+     * Tasks are run one at a time; concurrent calls to run() wait for
+     * each other. A task must not call run() of the same pool.
+     */
+    class AQUILA_EXPORT ThreadPool
+    {
+    public:
+        explicit ThreadPool(unsigned int threadsCount = 0);
+        ~ThreadPool();
+
+        /**
+         * Returns number of threads running the tasks.
+         *
+         * @return number of worker threads plus the calling thread
+         */
+        unsigned int getThreadsCount() const { return workers.size() + 1; }
+
+        void run(ParallelTask& task, unsigned int count);
+
+        static ThreadPool& getDefault();
+
+    private:
+        /**
+         * Worker threads.
+         */
+        std::vector<boost::thread*> workers;
+
+        /**
+         * Serializes calls to run().
+         */
+        boost::mutex runMutex;
+
+        /**
+         * Guards the state of the current task.
+         */
+        boost::mutex mutex;
+
+        /**
+         * Wakes up workers when a task arrives.
+         */
+        boost::condition_variable taskReady;
+
+        /**
+         * Notifies run() that workers have finished.
+         */
+        boost::condition_variable taskDone;
+
+        /**
+         * Current task, its part count and next part to run.
+         */
+        ParallelTask* task;
+        unsigned int count, next;
+
+        /**
+         * Number of workers still busy with the current task.
+         */
+        unsigned int busy;
+
+        /**
+         * Incremented with each task, so workers notice new ones.
+         */
+        unsigned int generation;
+
+        /**
+         * Set when the pool is destroyed.
+         */
+        bool stopping;
+
+        void work(unsigned int thread);
+        void workerLoop(unsigned int thread);
+
+        ThreadPool(const ThreadPool&);
+        ThreadPool& operator=(const ThreadPool&);
+    };
+}
+
+#endif // THREADPOOL_H
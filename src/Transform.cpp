@@ -15,9 +15,10 @@
 
 #include "Transform.h"
 
+#include "FftKernels.h"
 #include "Window.h"
+#include <algorithm>
 #include <cmath>
-#include <numeric>
 
 namespace Aquila
 {
@@ -33,8 +34,7 @@ namespace Aquila
      */
 	double Transform::frameLogEnergy(const Frame* frame)
 	{
-        double energy = std::accumulate(frame->begin(), frame->end(),
-                0.0, SquareAndSum());
+        double energy = frameEnergy(frame);
 
         return (energy > 0) ? std::log10(energy) : 0.0;
 	}
@@ -49,21 +49,27 @@ namespace Aquila
      */
     double Transform::framePower(const Frame* frame)
     {
-        double energy = std::accumulate(frame->begin(), frame->end(),
-                0.0, SquareAndSum());
+        double energy = frameEnergy(frame);
 
         return energy / frame->getLength();
     }
 
     /**
-     * Calculates Fast Fourier Transform using radix-2 algorithm.
+     * Calculates Fast Fourier Transform.
      *
      * Input data is given as a const reference to the data vector.
      * Output spectrum is written to the spectrum vector, which must be
      * initialized prior to the call to fft(). The spectrum is
      * normalized by N/2, wher N is input data length. The method
      * returns maximum magnitude of the calculated spectrum, which
-     * can be used for example to scale a frequency plot.
+     * can be used for example to scale a frequency plot. Both
+     * normalization and peak search can be skipped, see setScaling()
+     * and setPeakSearch().
+     *
+     * Any data length is allowed, but powers of 2 are the fastest,
+     * followed by lengths with no prime factors other than 2, 3 and 5.
+     * Powers of 2 from LARGE_FFT_MIN_LENGTH on are computed by the
+     * cache-blocked, multithreaded LargeFft.
      *
      * @param data const reference to input data vector
      * @param spectrum initialized complex vector of the same length as data
@@ -74,87 +80,42 @@ namespace Aquila
 	{
         // input signal size
 		unsigned int N = data.size();
+        if (isLargeLength(N))
+        {
+            largeTransform(data, &spectrum[0]);
+            return scaleSpectrum(spectrum, N, N);
+        }
+
+        const FftPlan& plan = usePlan(fftPlan, N);
+
+        if (plan.isPowerOf2())
+        {
+            // bit-reversing the samples - a requirement of radix-2,
+            // the transform itself works on split real/imaginary parts
+            fftReal.resize(N);
+            fftImag.assign(N, 0.0);
+            const unsigned int* reversed = plan.getBitReversal();
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                fftReal[i] = data[reversed[i]];
+            }
+            plan.butterflies(&fftReal[0], &fftImag[0]);
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                spectrum[i] = cplx(fftReal[i], fftImag[i]);
+            }
+        }
+        else
+        {
+            fftBuffer.assign(data.begin(), data.end());
+            plan.transform(&fftBuffer[0], &spectrum[0]);
+        }
 
-        // bit-reversing the samples - a requirement of radix-2
-        // instead of reversing in place, put the samples to result vector
-		unsigned int a = 1, b = 0, c = 0;
-		for (b = 1; b < N; ++b)
-		{
-			if (b < a)
-			{
-				spectrum[a - 1] = data[b - 1];
-				spectrum[b - 1] = data[a - 1];
-			}
-			c = N / 2;
-			while (c < a)
-			{
-				a -= c;
-				c /= 2;
-			}
-			a += c;
-		}
-
-        // FFT calculation using "butterflies"
-        // code ported from Matlab, based on book by Tomasz P. Zieliński
-
-        // FFT stages count
-		unsigned int numStages = static_cast<unsigned int>(
-		        std::log(double(N)) / LN_2);
-
-        // L = 2^k - DFT block length and offset
-        // M = 2^(k-1) - butterflies per block, butterfly width
-        // p - butterfly index
-        // q - block index
-        // r - index of sample in butterfly
-        // Wi - starting value of Fourier base coefficient
-		unsigned int L = 0, M = 0, p = 0, q = 0, r = 0;
-        cplx Wi(0, 0), Temp(0, 0);
-
-        cplx** Wi_cache = getCachedFftWi(numStages);
-
-        // iterate over the stages
-		for (unsigned int k = 1; k <= numStages; ++k)
-		{
-            L = 1 << k;
-            M = 1 << (k - 1);
-            Wi = Wi_cache[k][0];
-
-            // iterate over butterflies
-			for (p = 1; p <= M; ++p)
-			{
-                // iterate over blocks
-				for (q = p; q <= N; q += L)
-				{
-                    r = q + M;
-                    Temp = spectrum[r - 1] * Wi;
-                    spectrum[r - 1] = spectrum[q - 1] - Temp;
-                    spectrum[q - 1] = spectrum[q - 1] + Temp;
-				}
-                Wi = Wi_cache[k][p];
-			}
-		}
-
-		double maxAbs = 0.0, currAbs = 0.0;
-		unsigned int N2 = N >> 1; // N/2
-
-        // scaling by N/2 and searching for maximum magnitude
-        // we can iterate only over the first half of the spectrum,
-        // because of the symmetry, yet scaling is applied
-        // to both halves
-		for (unsigned int k = 0; k < N2; ++k)
-		{
-			spectrum[k] /= N2;
-			spectrum[N2 + k] /= N2;
-			currAbs = std::abs(spectrum[k]);
-			if ((currAbs > maxAbs))
-				maxAbs = currAbs;
-		}
-
-		return maxAbs;
+		return scaleSpectrum(spectrum, N, N);
 	}
 
     /**
-     * Calculates FFT of a signal frame using radix-2 algorithm.
+     * Calculates FFT of a signal frame.
      *
      * Input data is given as a pointer to Frame object.
      * Output spectrum is written to the spectrum vector, which must be
@@ -170,38 +131,709 @@ namespace Aquila
      */
 	double Transform::fft(const Frame* frame, spectrumType& spectrum)
 	{
-        // the vector is initialized to zero padded length,
-        // what means that it contains default values of contained type
-        // (0.0 in case of double); that allows us to loop
-        // only to frame length without padding and
-        // automatically have zeros at the end of data
-        std::vector<double> data(zeroPaddedLength);
-        unsigned int length = frame->getLength();
-        Frame::iterator it = frame->begin(), end = frame->end();
-
-        // first sample does not need preemphasis
-        data[0] = *it;
-        ++it;
-        double current = 0.0, previous = data[0];
-
-        // iterate over all samples of the frame
-        // filter the data through preemphasis
-        // and apply a chosen window function
-        for (unsigned int n = 1; it != end; ++it, ++n)
-        {
-            current = *it;
-            data[n] = (current - preemphasisFactor * previous) *
-                    Window::apply(winType, n, length);
-            previous = current;
-        }
-
-        return fft(data, spectrum);
+        frameBuffer.resize(zeroPaddedLength);
+        prepareFrame(frame, frameBuffer);
+
+        return fft(frameBuffer, spectrum);
 	}
 
     /**
-     * Calculates the Discrete Cosine Transform.
+     * Calculates FFT of real-valued data, returning only the half spectrum.
+     *
+     * The spectrum of a real signal is conjugate-symmetric, so only
+     * N/2+1 bins (from DC to the Nyquist frequency) carry information.
+     * The N real samples are packed into N/2 complex values (even samples
+     * as real parts, odd samples as imaginary parts), transformed by
+     * a complex FFT of half the size, and then separated into the spectrum
+     * of the original signal. This takes roughly half the time and memory
+     * of fft() for the same data. Odd lengths cannot be packed, so they
+     * are computed by a full complex transform.
+     *
+     * Scaling and the return value are the same as in fft().
+     *
+     * @param data const reference to input data vector
+     * @param spectrum initialized complex vector of length N/2+1
+     * @return maximum magnitude of the spectrum
+     * @since 2.6.0
+     */
+    double Transform::rfft(const std::vector<double>& data,
+            spectrumType& spectrum)
+    {
+        halfSpectrum(data, spectrum);
+
+        unsigned int N = data.size();
+        return scaleSpectrum(spectrum, N, N / 2 + 1);
+    }
+
+    /**
+     * Calculates magnitude or power spectrum of real-valued data.
+     *
+     * This is the same as rfft(), followed by computing the magnitude
+     * (or its square) of each bin, but no complex spectrum is returned.
+     * Power spectrum needs no square roots at all.
+     *
+     * @param data const reference to input data vector
+     * @param output initialized vector of length N/2+1
+     * @param type magnitude or power
+     * @return maximum value in the output
+     * @since 2.6.0
+     */
+    double Transform::rfft(const std::vector<double>& data,
+            std::vector<double>& output, MagnitudeType type)
+    {
+        unsigned int N = data.size();
+        spectrumBuffer.resize(N / 2 + 1);
+        halfSpectrum(data, spectrumBuffer);
+
+        return magnitudeSpectrum(spectrumBuffer, N, output, type);
+    }
+
+    /**
+     * Calculates half spectrum of a signal frame using real-input FFT.
+     *
+     * Frame is prepared (preemphasis, windowing, zero padding) in the same
+     * way as in fft(), but only N/2+1 spectral bins are computed.
+     *
+     * @param frame pointer to Frame object
+     * @param spectrum initialized complex vector of length N/2+1
+     * @return maximum magnitude of the spectrum
+     * @since 2.6.0
+     */
+    double Transform::rfft(const Frame* frame, spectrumType& spectrum)
+    {
+        frameBuffer.resize(zeroPaddedLength);
+        prepareFrame(frame, frameBuffer);
+
+        return rfft(frameBuffer, spectrum);
+    }
+
+    /**
+     * Calculates magnitude or power spectrum of a signal frame.
+     *
+     * @param frame pointer to Frame object
+     * @param output initialized vector of length N/2+1
+     * @param type magnitude or power
+     * @return maximum value in the output
+     * @since 2.6.0
+     */
+    double Transform::rfft(const Frame* frame, std::vector<double>& output,
+            MagnitudeType type)
+    {
+        frameBuffer.resize(zeroPaddedLength);
+        prepareFrame(frame, frameBuffer);
+
+        return rfft(frameBuffer, output, type);
+    }
+
+    /**
+     * Calculates inverse FFT of a spectrum returned by fft().
+     *
+     * The spectrum is expected to be scaled like the output of fft()
+     * (by N/2, unless scaling is turned off), so that ifft(fft(x))
+     * gives x back.
+     *
+     * @param spectrum complex spectrum of length N
+     * @param data initialized complex vector of length N for the signal
+     * @since 2.6.0
+     */
+    void Transform::ifft(const spectrumType& spectrum, spectrumType& data)
+    {
+        unsigned int N = spectrum.size();
+        const FftPlan& plan = usePlan(fftPlan, N);
+        plan.inverseTransform(&spectrum[0], &data[0]);
+
+        // undo the N/2 scaling of fft() and divide by N
+        const double factor = scaling ? 0.5 : 1.0 / N;
+        for (unsigned int n = 0; n < N; ++n)
+        {
+            data[n] *= factor;
+        }
+    }
+
+    /**
+     * Calculates real signal from its half spectrum returned by rfft().
+     *
+     * Signal length can't be deduced from N/2+1 bins, so the data vector
+     * must be initialized to the length of the original signal. The
+     * spectrum is rebuilt as a packed half-length transform (see
+     * splitRealSpectrum() for the forward direction), which is inverted
+     * by a complex FFT of length N/2.
+     *
+     * @param spectrum N/2+1 bins, scaled like the output of rfft()
+     * @param data initialized vector of length N for the signal
+     * @since 2.6.0
+     */
+    void Transform::irfft(const spectrumType& spectrum,
+            std::vector<double>& data)
+    {
+        // undo the N/2 scaling of rfft() and divide by N
+        const double N = data.size();
+        inverseHalfSpectrum(spectrum, data, scaling ? 0.5 : 1.0 / N);
+    }
+
+    /**
+     * Calculates a real signal from its half spectrum, times a factor.
+     *
+     * The result is the plain sum from the definition of inverse DFT,
+     * with bins above N/2 given by conjugate symmetry, multiplied by
+     * the factor (1/N gives the inverse of an unscaled spectrum).
+     *
+     * @param spectrum N/2+1 bins
+     * @param data initialized vector of length N for the signal
+     * @param factor scaling factor
+     */
+    void Transform::inverseHalfSpectrum(const spectrumType& spectrum,
+            std::vector<double>& data, double factor)
+    {
+        unsigned int N = data.size(), N2 = N >> 1;
+        if (N & 1)
+        {
+            // conjugate symmetry gives the other half of the spectrum
+            const FftPlan& plan = usePlan(fftPlan, N);
+            fftBuffer.resize(2 * N);
+            for (unsigned int k = 0; k <= N2; ++k)
+            {
+                fftBuffer[k] = spectrum[k];
+                if (k > 0)
+                    fftBuffer[N - k] = std::conj(spectrum[k]);
+            }
+            plan.inverseTransform(&fftBuffer[0], &fftBuffer[N]);
+            for (unsigned int n = 0; n < N; ++n)
+            {
+                data[n] = factor * fftBuffer[N + n].real();
+            }
+            return;
+        }
+
+        // Z[k] = E[k] + j O[k], where E[k] = (X[k] + X*[N/2-k]) / 2
+        // and O[k] = (X[k] - X*[N/2-k]) W^-k / 2
+        const FftPlan& plan = usePlan(rfftPlan, N2);
+        const cplx* W = plan.getRealFftTwiddles();
+        fftBuffer.resize(N);
+        cplx* z = &fftBuffer[0];
+        for (unsigned int k = 0; k < N2; ++k)
+        {
+            const cplx a = spectrum[k], b = std::conj(spectrum[N2 - k]);
+            const cplx e = 0.5 * (a + b), d = 0.5 * (a - b);
+            const cplx o(d.real() * W[k].real() + d.imag() * W[k].imag(),
+                         d.imag() * W[k].real() - d.real() * W[k].imag());
+            z[k] = cplx(e.real() - o.imag(), e.imag() + o.real());
+        }
+        plan.inverseTransform(z, z + N2);
+
+        // the half-length inverse gives N/2 x, half of the full-length sum
+        const double factor2 = 2.0 * factor;
+        for (unsigned int n = 0; n < N2; ++n)
+        {
+            data[2*n] = factor2 * z[N2 + n].real();
+            data[2*n+1] = factor2 * z[N2 + n].imag();
+        }
+    }
+
+    /**
+     * Calculates FFT of a block of frames.
+     *
+     * This gives the same results as calling fft() for each frame, but
+     * frames are transformed in batches of FFT_BATCH_SIZE, which is much
+     * faster for typical frame lengths (up to a few thousand samples).
+     * For lengths other than powers of 2, frames are transformed one
+     * by one.
+     *
+     * @param frames array of frame pointers
+     * @param count number of frames
+     * @param spectra array of count initialized complex vectors,
+     *                each of zero padded length
+     * @param maxAbs optional array of count maximum magnitudes
+     * @since 2.6.0
+     */
+    void Transform::fft(Frame* const* frames, unsigned int count,
+            spectrumType* spectra, double* maxAbs)
+    {
+        const unsigned int N = zeroPaddedLength;
+        const FftPlan& plan = usePlan(fftPlan, N);
+        if (!plan.isPowerOf2())
+        {
+            for (unsigned int i = 0; i < count; ++i)
+            {
+                double frameMax = fft(frames[i], spectra[i]);
+                if (maxAbs)
+                    maxAbs[i] = frameMax;
+            }
+            return;
+        }
+
+        const unsigned int* reversed = plan.getBitReversal();
+        for (unsigned int first = 0; first < count; first += FFT_BATCH_SIZE)
+        {
+            const unsigned int batch = std::min(FFT_BATCH_SIZE, count - first);
+            fftReal.resize(N * batch);
+            fftImag.assign(N * batch, 0.0);
+            for (unsigned int b = 0; b < batch; ++b)
+            {
+                frameBuffer.resize(N);
+                prepareFrame(frames[first + b], frameBuffer);
+                for (unsigned int i = 0; i < N; ++i)
+                {
+                    fftReal[i * batch + b] = frameBuffer[reversed[i]];
+                }
+            }
+
+            plan.butterflies(&fftReal[0], &fftImag[0], batch);
+
+            for (unsigned int b = 0; b < batch; ++b)
+            {
+                spectrumType& spectrum = spectra[first + b];
+                for (unsigned int i = 0; i < N; ++i)
+                {
+                    spectrum[i] = cplx(fftReal[i * batch + b],
+                                       fftImag[i * batch + b]);
+                }
+                double frameMax = scaleSpectrum(spectrum, N, N);
+                if (maxAbs)
+                    maxAbs[first + b] = frameMax;
+            }
+        }
+    }
+
+    /**
+     * Calculates half spectra of a block of frames using real-input FFT.
+     *
+     * This gives the same results as calling rfft() for each frame, but
+     * frames are transformed in batches of FFT_BATCH_SIZE, which is much
+     * faster for typical frame lengths. Frame lengths which are not
+     * powers of 2 are transformed one by one.
+     *
+     * @param frames array of frame pointers
+     * @param count number of frames
+     * @param spectra array of count initialized complex vectors,
+     *                each of length N/2+1
+     * @param maxAbs optional array of count maximum magnitudes
+     * @since 2.6.0
+     */
+    void Transform::rfft(Frame* const* frames, unsigned int count,
+            spectrumType* spectra, double* maxAbs)
+    {
+        const unsigned int N = zeroPaddedLength, N2 = N >> 1;
+        if ((N & 1) || !usePlan(rfftPlan, N2).isPowerOf2())
+        {
+            for (unsigned int i = 0; i < count; ++i)
+            {
+                double frameMax = rfft(frames[i], spectra[i]);
+                if (maxAbs)
+                    maxAbs[i] = frameMax;
+            }
+            return;
+        }
+
+        for (unsigned int first = 0; first < count; first += FFT_BATCH_SIZE)
+        {
+            const unsigned int batch = std::min(FFT_BATCH_SIZE, count - first);
+            halfSpectrumBatch(frames + first, batch, spectra + first);
+            for (unsigned int b = 0; b < batch; ++b)
+            {
+                double frameMax = scaleSpectrum(spectra[first + b], N, N2 + 1);
+                if (maxAbs)
+                    maxAbs[first + b] = frameMax;
+            }
+        }
+    }
+
+    /**
+     * Calculates magnitude or power spectra of a block of frames.
+     *
+     * This gives the same results as calling rfft() with MagnitudeType
+     * for each frame, but frames are transformed in batches.
+     *
+     * @param frames array of frame pointers
+     * @param count number of frames
+     * @param outputs array of count initialized vectors of length N/2+1
+     * @param type magnitude or power
+     * @param maxValue optional array of count maximum output values
+     * @since 2.6.0
+     */
+    void Transform::rfft(Frame* const* frames, unsigned int count,
+            std::vector<double>* outputs, MagnitudeType type,
+            double* maxValue)
+    {
+        const unsigned int N = zeroPaddedLength, N2 = N >> 1;
+        if ((N & 1) || !usePlan(rfftPlan, N2).isPowerOf2())
+        {
+            for (unsigned int i = 0; i < count; ++i)
+            {
+                double frameMax = rfft(frames[i], outputs[i], type);
+                if (maxValue)
+                    maxValue[i] = frameMax;
+            }
+            return;
+        }
+
+        batchSpectra.resize(FFT_BATCH_SIZE);
+        for (unsigned int b = 0; b < FFT_BATCH_SIZE; ++b)
+        {
+            batchSpectra[b].resize(N2 + 1);
+        }
+        for (unsigned int first = 0; first < count; first += FFT_BATCH_SIZE)
+        {
+            const unsigned int batch = std::min(FFT_BATCH_SIZE, count - first);
+            halfSpectrumBatch(frames + first, batch, &batchSpectra[0]);
+            for (unsigned int b = 0; b < batch; ++b)
+            {
+                double frameMax = magnitudeSpectrum(batchSpectra[b], N,
+                                                    outputs[first + b], type);
+                if (maxValue)
+                    maxValue[first + b] = frameMax;
+            }
+        }
+    }
+
+
+    /**
+     * Calculates unscaled half spectrum of real-valued data.
+     *
+     * See rfft() for the description of the algorithm.
+     *
+     * @param data input data vector
+     * @param spectrum initialized complex vector of length N/2+1
+     */
+    void Transform::halfSpectrum(const std::vector<double>& data,
+            spectrumType& spectrum)
+    {
+        unsigned int N = data.size(), N2 = N >> 1;
+        if (isLargeLength(N2))
+        {
+            // packing would need full-length twiddles of the split step,
+            // the large transform of real data is cheaper
+            fftBuffer.resize(N);
+            largeTransform(data, &fftBuffer[0]);
+            std::copy(fftBuffer.begin(), fftBuffer.begin() + N2 + 1,
+                      spectrum.begin());
+            return;
+        }
+        if (N & 1)
+        {
+            const FftPlan& plan = usePlan(fftPlan, N);
+            fftBuffer.resize(2 * N);
+            std::copy(data.begin(), data.end(), fftBuffer.begin());
+            plan.transform(&fftBuffer[0], &fftBuffer[N]);
+            std::copy(&fftBuffer[N], &fftBuffer[N] + N2 + 1, spectrum.begin());
+            return;
+        }
+
+        const FftPlan& plan = usePlan(rfftPlan, N2);
+
+        // pack even/odd samples into a half-length complex signal,
+        // for powers of 2 already in bit-reversed order
+        if (plan.isPowerOf2())
+        {
+            fftReal.resize(N2);
+            fftImag.resize(N2);
+            const unsigned int* reversed = plan.getBitReversal();
+            for (unsigned int n = 0; n < N2; ++n)
+            {
+                unsigned int r = reversed[n];
+                fftReal[n] = data[2*r];
+                fftImag[n] = data[2*r+1];
+            }
+            plan.butterflies(&fftReal[0], &fftImag[0]);
+            splitRealSpectrum(&fftReal[0], &fftImag[0], 1, plan, spectrum);
+        }
+        else
+        {
+            fftBuffer.resize(N);
+            cplx* z = &fftBuffer[0];
+            for (unsigned int n = 0; n < N2; ++n)
+            {
+                z[n] = cplx(data[2*n], data[2*n+1]);
+            }
+            plan.transform(z, z + N2);
+            const double* packed = reinterpret_cast<const double*>(z + N2);
+            splitRealSpectrum(packed, packed + 1, 2, plan, spectrum);
+        }
+    }
+
+    /**
+     * Calculates unscaled half spectra of up to FFT_BATCH_SIZE frames.
+     *
+     * Even and odd samples of each frame are packed as complex values,
+     * interleaved with other frames of the batch, and all of them are
+     * transformed at once. Frame length must be a power of 2, and the
+     * half-length plan must be already selected.
+     *
+     * @param frames array of frame pointers
+     * @param batch number of frames
+     * @param spectra array of batch vectors of length N/2+1
+     */
+    void Transform::halfSpectrumBatch(Frame* const* frames, unsigned int batch,
+            spectrumType* spectra)
+    {
+        const unsigned int N = zeroPaddedLength, N2 = N >> 1;
+        const FftPlan& plan = *rfftPlan;
+        const unsigned int* reversed = plan.getBitReversal();
+
+        fftReal.resize(N2 * batch);
+        fftImag.resize(N2 * batch);
+        for (unsigned int b = 0; b < batch; ++b)
+        {
+            frameBuffer.resize(N);
+            prepareFrame(frames[b], frameBuffer);
+            for (unsigned int n = 0; n < N2; ++n)
+            {
+                unsigned int r = reversed[n];
+                fftReal[n * batch + b] = frameBuffer[2*r];
+                fftImag[n * batch + b] = frameBuffer[2*r+1];
+            }
+        }
+
+        plan.butterflies(&fftReal[0], &fftImag[0], batch);
+
+        for (unsigned int b = 0; b < batch; ++b)
+        {
+            splitRealSpectrum(&fftReal[b], &fftImag[b], batch, plan,
+                              spectra[b]);
+        }
+    }
+
+    /**
+     * Fills the data vector with frame samples ready for the transform.
+     *
+     * Samples are filtered through preemphasis, multiplied by a cached
+     * window table and padded with zeros in a single pass, see
+     * FftKernels::windowFrame(). Contiguous 32 and 16-bit samples are read
+     * directly, frames of other sample formats (eg. viewing interleaved
+     * samples in a mapped file) are converted to integers first.
+     *
+     * @param frame pointer to Frame object
+     * @param data vector of zero padded length
+     */
+    void Transform::prepareFrame(const Frame* frame, std::vector<double>& data)
+    {
+        const unsigned int length = frame->getLength();
+        if (!windowTable || length != windowLength)
+        {
+            windowTable = Window::getTable(winType, length);
+            windowLength = length;
+        }
+
+        const SampleSpan& span = frame->getSpan();
+        if (span.isContiguous<boost::int16_t>())
+        {
+            FftKernels::windowFrame(
+                static_cast<const boost::int16_t*>(span.data), length,
+                preemphasisFactor, &(*windowTable)[0], &data[0], data.size());
+            return;
+        }
+
+        FftKernels::windowFrame(frameSamples(frame), length,
+                                preemphasisFactor, &(*windowTable)[0],
+                                &data[0], data.size());
+    }
+
+    /**
+     * Returns frame samples as a contiguous integer array.
+     *
+     * Frames of channel vectors are read in place, other ones are
+     * converted to the sample buffer.
+     *
+     * @param frame pointer to Frame object
+     * @return pointer to frame->getLength() samples
+     */
+    const int* Transform::frameSamples(const Frame* frame)
+    {
+        const int* samples = frame->getSamples();
+        const unsigned int length = frame->getLength();
+        if (!samples && length > 0)
+        {
+            sampleBuffer.resize(length);
+            frame->getSpan().copyTo(&sampleBuffer[0]);
+            samples = &sampleBuffer[0];
+        }
+
+        return samples;
+    }
+
+    /**
+     * Calculates frame energy - a sum of squares of the samples.
+     *
+     * Contiguous 32 and 16-bit samples are summed in place by
+     * FftKernels::sumOfSquares(), other frames are converted first.
+     *
+     * @param frame pointer to Frame object
+     * @return frame energy
+     */
+    double Transform::frameEnergy(const Frame* frame)
+    {
+        const unsigned int length = frame->getLength();
+        const SampleSpan& span = frame->getSpan();
+        if (span.isContiguous<boost::int16_t>())
+        {
+            return FftKernels::sumOfSquares(
+                static_cast<const boost::int16_t*>(span.data), length);
+        }
+
+        return FftKernels::sumOfSquares(frameSamples(frame), length);
+    }
+
+    /**
+     * Returns a plan of given length, fetching it from registry if needed.
+     *
+     * The plan pointer is kept by the caller, so that the registry is
+     * consulted only when the transform length changes.
+     *
+     * @param plan reference to a plan pointer held by the caller
+     * @param length transform length
+     * @return const reference to the plan
+     */
+    const FftPlan& Transform::usePlan(FftPlan::PointerType& plan,
+            unsigned int length)
+    {
+        if (!plan || plan->getLength() != length)
+            plan = FftPlan::get(length);
+
+        return *plan;
+    }
+
+    /**
+     * Checks if a transform length is handled by LargeFft.
+     *
+     * @param length transform length
+     * @return true for powers of 2 not less than LARGE_FFT_MIN_LENGTH
+     */
+    bool Transform::isLargeLength(unsigned int length)
+    {
+        return length >= LARGE_FFT_MIN_LENGTH && (length & (length - 1)) == 0;
+    }
+
+    /**
+     * Calculates unscaled FFT of real data by the six-step algorithm.
+     *
+     * @param data input data, its length must be a large length
+     * @param spectrum output array of data.size() values
+     */
+    void Transform::largeTransform(const std::vector<double>& data,
+            cplx* spectrum)
+    {
+        const unsigned int N = data.size();
+        if (!largeFft || largeFft->getLength() != N)
+            largeFft.reset(new LargeFft(N));
+
+        fftReal.assign(data.begin(), data.end());
+        fftImag.assign(N, 0.0);
+        largeFft->transform(&fftReal[0], &fftImag[0], spectrum);
+    }
+
+    /**
+     * Separates spectrum of real data from transform of its packed form.
+     *
+     * The real signal x of length N was packed as z[n] = x[2n] + j x[2n+1]
+     * and Z is the N/2-point transform of z. Then transforms of even (E)
+     * and odd (O) samples are E[k] = (Z[k] + Z*[N/2-k]) / 2 and
+     * O[k] = -j (Z[k] - Z*[N/2-k]) / 2, and X[k] = E[k] + W^k O[k].
+     *
+     * @param zr real parts of Z
+     * @param zi imaginary parts of Z
+     * @param stride distance between consecutive values in zr and zi
+     * @param plan plan of the N/2-point transform
+     * @param spectrum output, N/2+1 bins
+     */
+    void Transform::splitRealSpectrum(const double* zr, const double* zi,
+            unsigned int stride, const FftPlan& plan, spectrumType& spectrum)
+    {
+        const unsigned int N2 = plan.getLength();
+        const cplx* W = plan.getRealFftTwiddles();
+
+        spectrum[0] = cplx(zr[0] + zi[0], 0.0);
+        spectrum[N2] = cplx(zr[0] - zi[0], 0.0);
+        for (unsigned int k = 1, l = N2 - 1; k < N2; ++k, --l)
+        {
+            const double ar = zr[k * stride], ai = zi[k * stride];
+            const double br = zr[l * stride], bi = zi[l * stride];
+            double er = 0.5 * (ar + br), ei = 0.5 * (ai - bi);
+            double or_ = 0.5 * (ai + bi), oi = -0.5 * (ar - br);
+            spectrum[k] = cplx(er + W[k].real() * or_ - W[k].imag() * oi,
+                               ei + W[k].real() * oi + W[k].imag() * or_);
+        }
+    }
+
+    /**
+     * Scales the spectrum by N/2 and finds its maximum magnitude.
+     *
+     * We can search only the first half of the spectrum, because of
+     * the symmetry, yet scaling is applied to all given bins. Both steps
+     * can be turned off, see setScaling() and setPeakSearch().
+     *
+     * @param spectrum spectrum to scale
+     * @param N transform length
+     * @param length number of spectral bins stored in the vector
+     * @return maximum magnitude of the spectrum (0 if peak search is off)
+     */
+    double Transform::scaleSpectrum(spectrumType& spectrum, unsigned int N,
+            unsigned int length)
+    {
+        if (scaling)
+        {
+            const double factor = 2.0 / N;
+            for (unsigned int k = 0; k < length; ++k)
+            {
+                spectrum[k] *= factor;
+            }
+        }
+
+        if (!peakSearch)
+            return 0.0;
+
+        // comparing squared magnitudes saves a square root per bin
+        const unsigned int N2 = std::min(N >> 1, length);
+        double maxNorm = 0.0;
+        for (unsigned int k = 0; k < N2; ++k)
+        {
+            double currNorm = spectrum[k].real() * spectrum[k].real() +
+                              spectrum[k].imag() * spectrum[k].imag();
+            if (currNorm > maxNorm)
+                maxNorm = currNorm;
+        }
+
+        return std::sqrt(maxNorm);
+    }
+
+    /**
+     * Converts unscaled half spectrum to magnitude or power spectrum.
+     *
+     * Scaling by N/2 is applied to magnitudes (when enabled), so the
+     * output is the same as the magnitude of the rfft() result.
+     *
+     * @param spectrum unscaled half spectrum
+     * @param N transform length
+     * @param output initialized vector of the same length as spectrum
+     * @param type magnitude or power
+     * @return maximum value in the first N/2 bins (0 if peak search is off)
+     */
+    double Transform::magnitudeSpectrum(const spectrumType& spectrum,
+            unsigned int N, std::vector<double>& output, MagnitudeType type)
+    {
+        const unsigned int length = spectrum.size(), N2 = N >> 1;
+        const double factor = scaling ? 2.0 / N : 1.0;
+        const double powerFactor = factor * factor;
+        double maxValue = 0.0;
+        for (unsigned int k = 0; k < length; ++k)
+        {
+            double power = (spectrum[k].real() * spectrum[k].real() +
+                            spectrum[k].imag() * spectrum[k].imag()) *
+                           powerFactor;
+            double value = (MAGNITUDE_POWER == type) ? power : std::sqrt(power);
+            output[k] = value;
+            if (peakSearch && k < N2 && value > maxValue)
+                maxValue = value;
+        }
+
+        return maxValue;
+    }
+
+    /**
+     * Calculates the Discrete Cosine Transform of logarithms of the data.
      *
      * Uses cosine value caching in order to speed up computations.
+     * Logarithms are taken once per input value, and the transform is
+     * a product of the cached cosine matrix and the vector of logarithms.
      *
      * @param data input data vector
      * @param output initialized vector of output values
@@ -209,145 +841,292 @@ namespace Aquila
 	void Transform::dct(const std::vector<double>& data,
 	        std::vector<double>& output)
 	{
-	    using namespace std;
+        dct(&data, 1, &output);
+	}
+
+    /**
+     * Calculates the Discrete Cosine Transform of a block of vectors.
+     *
+     * All vectors must have the same length, and so must the outputs.
+     * The block is computed as a single matrix product, so each row of
+     * the cosine matrix is loaded once for all the vectors. Long
+     * transforms are computed one by one with FFT, see dct2().
+     *
+     * @param data array of count input data vectors
+     * @param count number of vectors
+     * @param outputs array of count initialized vectors of output values
+     */
+    void Transform::dct(const std::vector<double>* data, unsigned int count,
+                        std::vector<double>* outputs)
+    {
+        if (0 == count || data[0].empty() || outputs[0].empty())
+            return;
 
         // output size determines how many coefficients will be calculated
-		unsigned int outputLength = output.size();
-		unsigned int inputLength = data.size();
-
-        // DCT scaling factor
-        double c0 = sqrt(1.0 / inputLength);
-        double cn = sqrt(2.0 / inputLength);
-        // cached cosine values
-        double** cosines = getCachedCosines(inputLength, outputLength);
-
-		for (unsigned int n = 0; n < outputLength; ++n)
-		{
-			output[n] = 0.0;
-			for (unsigned int k = 0; k < inputLength; ++k)
-			{
-                // 1e-10 added for the logarithm value to be grater than 0
-                output[n] += log(fabs(data[k]) + 1e-10) * cosines[n][k];
-			}
+        const unsigned int outputLength = outputs[0].size();
+        const DctPlan& plan = useDctPlan(data[0].size(), outputLength);
+        if (plan.isFast())
+        {
+            for (unsigned int f = 0; f < count; ++f)
+            {
+                logInputs(data + f, 1, plan.getInputLength());
+                fastDct2(plan, &dctInput[0], &outputs[f][0]);
+            }
+            return;
+        }
 
-            output[n] *= (0 == n) ? c0 : cn;
-		}
-	}
+        logInputs(data, count, plan.getStride());
+
+        dctOutput.resize(count * outputLength);
+        FftKernels::matrixProduct(plan.getCosines(), outputLength,
+                                  plan.getStride(), &dctInput[0], count,
+                                  &dctOutput[0]);
+
+        for (unsigned int f = 0; f < count; ++f)
+        {
+            std::copy(dctOutput.begin() + f * outputLength,
+                      dctOutput.begin() + (f + 1) * outputLength,
+                      outputs[f].begin());
+        }
+    }
 
     /**
-     * Returns a table of DCT cosine values stored in memory cache.
+     * Calculates the orthonormal DCT-II of the data.
      *
-     * The two params unambigiously identify which cache to use.
+     * X[k] = c(k) * sum x[n] cos(pi*(2n+1)*k / 2N), where c(0) = sqrt(1/N)
+     * and c(k) = sqrt(2/N) otherwise. Output size determines how many
+     * coefficients are calculated (at most N). Short transforms, or
+     * just a few coefficients, are computed from the cosine matrix of
+     * a shared DctPlan, others through the real-input FFT, in O(N log N)
+     * time.
      *
-     * @param inputLength length of the input vector
-     * @param outputLength length of the output vector
-     * @return pointer to array of pointers to arrays of doubles
+     * @param data input data vector
+     * @param output initialized vector of output values
+     * @since 2.6.0
      */
-    double** Transform::getCachedCosines(unsigned int inputLength, unsigned int outputLength)
+    void Transform::dct2(const std::vector<double>& data,
+            std::vector<double>& output)
     {
-        cosineCacheKeyType key = std::make_pair(inputLength, outputLength);
+        const unsigned int N = data.size(), K = output.size();
+        if (0 == N || 0 == K)
+            return;
+
+        const DctPlan& plan = useDctPlan(N, K);
+        if (plan.isFast())
+        {
+            fastDct2(plan, &data[0], &output[0]);
+            return;
+        }
+
+        const unsigned int stride = plan.getStride();
+        dctInput.assign(stride, 0.0);
+        std::copy(data.begin(), data.end(), dctInput.begin());
+        FftKernels::matrixProduct(plan.getCosines(), K, stride, &dctInput[0],
+                                  1, &output[0]);
+    }
 
-        // if we have that key cached, return immediately!
-        if (cosineCache.find(key) != cosineCache.end())
+    /**
+     * Calculates the orthonormal DCT-III, the inverse of dct2().
+     *
+     * x[n] = sum c(k) X[k] cos(pi*(2n+1)*k / 2N). Coefficients beyond the
+     * input size are taken as zeros, so a signal of length N can be
+     * approximated from its first few DCT-II coefficients.
+     *
+     * @param data input vector of DCT coefficients (at most N)
+     * @param output initialized vector of N output values
+     * @since 2.6.0
+     */
+    void Transform::dct3(const std::vector<double>& data,
+            std::vector<double>& output)
+    {
+        const unsigned int K = data.size(), N = output.size();
+        if (0 == N)
+            return;
+        if (0 == K)
         {
-            return cosineCache[key];
+            std::fill(output.begin(), output.end(), 0.0);
+            return;
         }
 
-        // nothing in cache for that pair, calculate cosines
-        double** cosines = new double*[outputLength];
-        for (unsigned int n = 0; n < outputLength; ++n)
+        const DctPlan& plan = useDctPlan(N, K);
+        if (plan.isFast())
         {
-            cosines[n] = new double[inputLength];
+            fastDct3(plan, &data[0], &output[0]);
+            return;
+        }
 
-            for (unsigned int k = 0; k < inputLength; ++k)
+        // transposed product, the matrix row of each coefficient is scaled
+        // and added to the output
+        std::fill(output.begin(), output.end(), 0.0);
+        const double* cosines = plan.getCosines();
+        const unsigned int stride = plan.getStride();
+        for (unsigned int k = 0; k < K; ++k)
+        {
+            const double* row = cosines + k * stride;
+            const double value = data[k];
+            for (unsigned int n = 0; n < N; ++n)
             {
-                // from the definition of DCT
-                cosines[n][k] = cos((M_PI * (2*k+1) * n) /
-                                    (2 * inputLength));
+                output[n] += value * row[n];
             }
         }
+    }
 
-        // store in cache and return
-        cosineCache[key] = cosines;
-
-        return cosines;
+    /**
+     * Builds shared tables used by transforms of given options and sizes.
+     *
+     * FFT and DCT plans and window tables are shared by all Transform
+     * objects, and built when first needed. Calling this method at
+     * startup moves that cost out of the processing of the first file,
+     * eg. for MFCC: warmUp(options, wav.getSamplesPerFrame(), MELFILTERS,
+     * number of coefficients).
+     *
+     * @param options transform options
+     * @param frameLength number of samples in a frame (before padding)
+     * @param dctInputLength DCT length, 0 if DCT is not used
+     * @param dctOutputLength number of DCT coefficients
+     * @since 2.6.0
+     */
+    void Transform::warmUp(const TransformOptions& options,
+                           unsigned int frameLength,
+                           unsigned int dctInputLength,
+                           unsigned int dctOutputLength)
+    {
+        const unsigned int N = options.zeroPaddedLength;
+        if (N > 0)
+        {
+            FftPlan::get(N);
+            if (0 == (N & 1) && N > 2)
+                FftPlan::get(N / 2);
+        }
+        if (frameLength > 0)
+            Window::getTable(options.windowType, frameLength);
+        if (dctInputLength > 0 && dctOutputLength > 0)
+            DctPlan::get(dctInputLength, dctOutputLength);
     }
 
     /**
-     * Deletes all the memory used by cache.
+     * Returns a DCT plan of given size, fetching it from registry if needed.
+     *
+     * @param inputLength transform length N
+     * @param outputLength number of coefficients K
+     * @return const reference to the plan
      */
-    void Transform::clearCosineCache()
+    const DctPlan& Transform::useDctPlan(unsigned int inputLength,
+                                         unsigned int outputLength)
     {
-        cosineCacheType::const_iterator it;
-        for (it = cosineCache.begin(); it != cosineCache.end(); it++)
+        if (!dctPlan || dctPlan->getInputLength() != inputLength ||
+            dctPlan->getOutputLength() != outputLength)
         {
-            cosineCacheKeyType key = it->first;
-            double** cosines = it->second;
-            unsigned int outputLength = key.second;
-            for (unsigned int i = 0; i < outputLength; ++i)
-            {
-                delete [] cosines[i];
-            }
-            delete [] cosines;
+            dctPlan = DctPlan::get(inputLength, outputLength);
         }
+
+        return *dctPlan;
     }
 
+    /**
+     * Calculates DCT-II through a real-input FFT of the same length.
+     *
+     * Even samples in order, followed by odd samples in reverse order,
+     * form a signal v whose DFT V gives the unscaled DCT as
+     * Re(exp(-j*pi*k/2N) V[k]) (J. Makhoul, 1980).
+     *
+     * @param plan FFT-based plan of the transform
+     * @param data N input values
+     * @param output K output values
+     */
+    void Transform::fastDct2(const DctPlan& plan, const double* data,
+                             double* output)
+    {
+        const unsigned int N = plan.getInputLength(), K = plan.getOutputLength();
+        dctBuffer.resize(N);
+        for (unsigned int n = 0; 2*n < N; ++n)
+        {
+            dctBuffer[n] = data[2*n];
+        }
+        for (unsigned int n = 0; 2*n + 1 < N; ++n)
+        {
+            dctBuffer[N - 1 - n] = data[2*n + 1];
+        }
+
+        spectrumBuffer.resize(N / 2 + 1);
+        halfSpectrum(dctBuffer, spectrumBuffer);
+
+        const cplx* W = plan.getTwiddles();
+        const double c0 = std::sqrt(1.0 / N), cn = std::sqrt(2.0 / N);
+        output[0] = c0 * spectrumBuffer[0].real();
+        for (unsigned int k = 1; k < K; ++k)
+        {
+            // bins above N/2 are conjugates of the lower ones
+            const cplx V = (2*k <= N) ? spectrumBuffer[k] :
+                                        std::conj(spectrumBuffer[N - k]);
+            output[k] = cn * (V.real() * W[k].real() - V.imag() * W[k].imag());
+        }
+    }
 
     /**
-     * Returns a table of Wi (twiddle factors) stored in cache.
+     * Calculates DCT-III through an inverse real-input FFT.
+     *
+     * Reverses the steps of fastDct2(): with unscaled coefficients Y,
+     * V[k] = exp(j*pi*k/2N) (Y[k] - j Y[N-k]), and the inverse DFT of V
+     * gives the even and odd samples.
      *
-     * @param numStages the FFT stages count
-     * @return pointer to an array of pointers to arrays of complex numbers
+     * @param plan FFT-based plan of the transform
+     * @param data K input coefficients
+     * @param output N output values
      */
-    cplx** Transform::getCachedFftWi(unsigned int numStages)
+    void Transform::fastDct3(const DctPlan& plan, const double* data,
+                             double* output)
     {
-        fftWiCacheKeyType key = numStages;
-        // cache hit, return immediately
-        if (fftWiCache.find(key) != fftWiCache.end())
-        {
-            return fftWiCache[key];
-        }
-
-        // nothing in cache, calculate twiddle factors
-        cplx** Wi = new cplx*[numStages+1];
-        for (unsigned int k = 1; k <= numStages; ++k)
-        {
-            // L = 2^k - DFT block length and offset
-            // M = 2^(k-1) - butterflies per block, butterfly width
-            // W - Fourier base multiplying factor
-            unsigned int L = 1 << k;
-            unsigned int M = 1 << (k-1);
-            cplx W = exp((-j) * 2.0 * M_PI / double(L));
-            Wi[k] = new cplx[M+1];
-            Wi[k][0] = cplx(1.0);
-            for (unsigned int p = 1; p <= M; ++p)
-            {
-                Wi[k][p] = Wi[k][p-1] * W;
-            }
+        const unsigned int N = plan.getInputLength(), K = plan.getOutputLength();
+        const unsigned int N2 = N / 2;
+        const cplx* W = plan.getTwiddles();
+        const double c0 = std::sqrt(1.0 / N), cn = std::sqrt(2.0 / N);
+
+        spectrumBuffer.resize(N2 + 1);
+        spectrumBuffer[0] = cplx(data[0] / c0, 0.0);
+        for (unsigned int k = 1; k <= N2; ++k)
+        {
+            const double a = (k < K) ? data[k] / cn : 0.0;
+            const double b = (N - k < K) ? data[N - k] / cn : 0.0;
+            // multiply (a - jb) by conjugate of W[k]
+            spectrumBuffer[k] = cplx(a * W[k].real() - b * W[k].imag(),
+                                     -a * W[k].imag() - b * W[k].real());
         }
 
-        // store in cache and return
-        fftWiCache[key] = Wi;
+        dctBuffer.resize(N);
+        inverseHalfSpectrum(spectrumBuffer, dctBuffer, 1.0 / N);
 
-        return Wi;
+        for (unsigned int n = 0; 2*n < N; ++n)
+        {
+            output[2*n] = dctBuffer[n];
+        }
+        for (unsigned int n = 0; 2*n + 1 < N; ++n)
+        {
+            output[2*n + 1] = dctBuffer[N - 1 - n];
+        }
     }
 
     /**
-     * Clears the twiddle factor cache.
+     * Stores logarithms of absolute input values in the work buffer.
+     *
+     * Each vector is padded with zeros to the stride.
+     *
+     * @param data array of count input data vectors
+     * @param count number of vectors
+     * @param stride padded vector length
      */
-    void Transform::clearFftWiCache()
+    void Transform::logInputs(const std::vector<double>* data,
+                              unsigned int count, unsigned int stride)
     {
-        fftWiCacheType::const_iterator it;
-        for (it = fftWiCache.begin(); it != fftWiCache.end(); it++)
+        dctInput.assign(count * stride, 0.0);
+        for (unsigned int f = 0; f < count; ++f)
         {
-            cplx** c = it->second;
-            unsigned int numStages = it->first;
-            for (unsigned int i = 1; i <= numStages; ++i)
+            double* logs = &dctInput[f * stride];
+            for (unsigned int k = 0; k < data[f].size(); ++k)
             {
-                delete [] c[i];
+                // 1e-10 added for the logarithm value to be grater than 0
+                logs[k] = std::log(std::fabs(data[f][k]) + 1e-10);
             }
-
-            delete [] c;
         }
     }
 }
@@ -17,11 +17,15 @@
 #define TRANSFORM_H
 
 #include "global.h"
+#include "DctPlan.h"
+#include "FftPlan.h"
 #include "Frame.h"
+#include "LargeFft.h"
 #include "Window.h"
 #include <functional>
 #include <map>
 #include <utility>
+#include <boost/shared_ptr.hpp>
 
 
 namespace Aquila
@@ -31,6 +35,11 @@ namespace Aquila
 	 */
 	const double LN_2 = 0.69314718055994530941723212145818;
 
+    /**
+     * Number of frames transformed together by batch FFT methods.
+     */
+    const unsigned int FFT_BATCH_SIZE = 8;
+
 	/**
      * A functor class used for calculating energy or power of the signal.
 	 */
@@ -50,6 +59,11 @@ namespace Aquila
         }
     };
 
+    /**
+     * Output of magnitude spectrum methods: |X| or |X|^2.
+     */
+    enum MagnitudeType { MAGNITUDE_ABS, MAGNITUDE_POWER };
+
     /**
      * A simple wrapper for few of the transformation options.
      */
@@ -74,13 +88,14 @@ namespace Aquila
         /**
          * Creates the transform object and explicitly sets the options.
          *
-         * @param length spectrum length (a power of 2)
+         * @param length spectrum length (preferably a power of 2)
          * @param window type of used window function (default is Hamming)
          * @param factor preemphasis factor (default is 0.95)
          */
         Transform(unsigned int length, WindowType window = WIN_HAMMING,
             double factor = 0.95):
-            zeroPaddedLength(length), preemphasisFactor(factor), winType(window)
+            zeroPaddedLength(length), preemphasisFactor(factor), winType(window),
+            windowLength(0), scaling(true), peakSearch(true)
         {
         }
 
@@ -92,18 +107,30 @@ namespace Aquila
         Transform(TransformOptions options):
             zeroPaddedLength(options.zeroPaddedLength),
             preemphasisFactor(options.preemphasisFactor),
-            winType(options.windowType)
+            winType(options.windowType), windowLength(0),
+            scaling(true), peakSearch(true)
         {
         }
 
         /**
-         * Makes sure no memory leaks are caused by the cache.
+         * Turns on/off scaling of FFT results by N/2.
+         *
+         * Unscaled spectrum is the plain sum from the definition of DFT.
+         * Inverse transforms expect the same scaling as forward ones.
+         *
+         * @param enable true (default) - spectrum is divided by N/2
          */
-        ~Transform()
-        {
-            clearCosineCache();
-            clearFftWiCache();
-        }
+        void setScaling(bool enable) { scaling = enable; }
+
+        /**
+         * Turns on/off searching for the maximum magnitude after FFT.
+         *
+         * When turned off, FFT methods return 0 instead of the peak value,
+         * which saves a pass over the spectrum.
+         *
+         * @param enable true (default) - peak value is returned
+         */
+        void setPeakSearch(bool enable) { peakSearch = enable; }
 
         double frameLogEnergy(const Frame* frame);
         double framePower(const Frame* frame) ;
@@ -111,8 +138,37 @@ namespace Aquila
         double fft(const std::vector<double>& data, spectrumType& spectrum);
         double fft(const Frame* frame, spectrumType& spectrum);
 
+        double rfft(const std::vector<double>& data, spectrumType& spectrum);
+        double rfft(const Frame* frame, spectrumType& spectrum);
+
+        double rfft(const std::vector<double>& data,
+                    std::vector<double>& output, MagnitudeType type);
+        double rfft(const Frame* frame, std::vector<double>& output,
+                    MagnitudeType type);
+
+        void ifft(const spectrumType& spectrum, spectrumType& data);
+        void irfft(const spectrumType& spectrum, std::vector<double>& data);
+
+        void fft(Frame* const* frames, unsigned int count,
+                 spectrumType* spectra, double* maxAbs = 0);
+        void rfft(Frame* const* frames, unsigned int count,
+                  spectrumType* spectra, double* maxAbs = 0);
+        void rfft(Frame* const* frames, unsigned int count,
+                  std::vector<double>* outputs, MagnitudeType type,
+                  double* maxValue = 0);
+
         void dct(const std::vector<double>& data,
                 std::vector<double>& output);
+        void dct(const std::vector<double>* data, unsigned int count,
+                 std::vector<double>* outputs);
+
+        void dct2(const std::vector<double>& data, std::vector<double>& output);
+        void dct3(const std::vector<double>& data, std::vector<double>& output);
+
+        static void warmUp(const TransformOptions& options,
+                           unsigned int frameLength,
+                           unsigned int dctInputLength = 0,
+                           unsigned int dctOutputLength = 0);
 
     private:
         /**
@@ -130,47 +186,120 @@ namespace Aquila
          */
         WindowType winType;
 
-        // COSINE CACHING FOR DCT
         /**
-         * Key type for the cache, using input and output length.
+         * Shared window table of the last frame length.
          */
-        typedef std::pair<unsigned int, unsigned int> cosineCacheKeyType;
+        Window::TablePointer windowTable;
+        unsigned int windowLength;
 
         /**
-         * Cache type.
+         * Whether the spectrum is scaled by N/2.
          */
-        typedef std::map<cosineCacheKeyType, double**> cosineCacheType;
+        bool scaling;
 
         /**
-         * Cache object, implemented as a map.
+         * Whether FFT methods search for the maximum magnitude.
          */
-        cosineCacheType cosineCache;
+        bool peakSearch;
 
-        double** getCachedCosines(unsigned int inputLength, unsigned int outputLength);
+        /**
+         * Shared plan of the last complex FFT.
+         */
+        FftPlan::PointerType fftPlan;
 
-        void clearCosineCache();
+        /**
+         * Shared plan of the last real-input FFT (of half its length).
+         */
+        FftPlan::PointerType rfftPlan;
 
+        /**
+         * Six-step transform of the last large length.
+         */
+        boost::shared_ptr<LargeFft> largeFft;
 
+        /**
+         * Work buffer for transforms of real data.
+         */
+        spectrumType fftBuffer;
+
+        /**
+         * Work buffers for real and imaginary parts of split transforms.
+         */
+        alignedVectorType fftReal, fftImag;
 
-        // TWIDDLE FACTOR CACHE FOR FFT
         /**
-         * Type of the twiddle factor cache key.
+         * Work buffer for a single prepared frame.
          */
-        typedef unsigned int fftWiCacheKeyType;
+        std::vector<double> frameBuffer;
 
         /**
-         * Type of the twiddle factor cache.
+         * Samples of a frame which is not stored as integers.
          */
-        typedef std::map<fftWiCacheKeyType, cplx**> fftWiCacheType;
+        std::vector<int> sampleBuffer;
 
         /**
-         * Twiddle factor cache - implemented as a map.
+         * Work buffers for unscaled half spectra.
          */
-        fftWiCacheType fftWiCache;
+        spectrumType spectrumBuffer;
+        std::vector<spectrumType> batchSpectra;
+
+        static const FftPlan& usePlan(FftPlan::PointerType& plan,
+                                      unsigned int length);
+
+        void prepareFrame(const Frame* frame, std::vector<double>& data);
+
+        const int* frameSamples(const Frame* frame);
+
+        double frameEnergy(const Frame* frame);
+
+        void halfSpectrum(const std::vector<double>& data,
+                          spectrumType& spectrum);
+
+        void halfSpectrumBatch(Frame* const* frames, unsigned int batch,
+                               spectrumType* spectra);
+
+        static bool isLargeLength(unsigned int length);
+
+        void largeTransform(const std::vector<double>& data, cplx* spectrum);
+
+        void inverseHalfSpectrum(const spectrumType& spectrum,
+                                 std::vector<double>& data, double factor);
+
+        static void splitRealSpectrum(const double* zr, const double* zi,
+                                      unsigned int stride, const FftPlan& plan,
+                                      spectrumType& spectrum);
+
+        double scaleSpectrum(spectrumType& spectrum, unsigned int N,
+                             unsigned int length);
+
+        double magnitudeSpectrum(const spectrumType& spectrum, unsigned int N,
+                                 std::vector<double>& output,
+                                 MagnitudeType type);
+
+        /**
+         * Shared plan of the last DCT size.
+         */
+        DctPlan::PointerType dctPlan;
+
+        /**
+         * Work buffers for logarithms of DCT inputs and for its outputs.
+         */
+        alignedVectorType dctInput, dctOutput;
+
+        /**
+         * Work buffer for reordered samples of FFT-based DCT.
+         */
+        std::vector<double> dctBuffer;
+
+        const DctPlan& useDctPlan(unsigned int inputLength,
+                                  unsigned int outputLength);
+
+        void logInputs(const std::vector<double>* data, unsigned int count,
+                       unsigned int stride);
 
-        cplx** getCachedFftWi(unsigned int numStages);
+        void fastDct2(const DctPlan& plan, const double* data, double* output);
+        void fastDct3(const DctPlan& plan, const double* data, double* output);
 
-        void clearFftWiCache();
 	};
 }
 
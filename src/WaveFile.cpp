@@ -15,13 +15,21 @@
 #include "WaveFile.h"
 
 #include "Exceptions.h"
+#include "FftPlan.h"
+#include "WaveReader.h"
+#include "WaveWriter.h"
+#include <algorithm>
 #include <cmath>
-#include <cstring>
-#include <fstream>
 #include <stdexcept>
 
 namespace Aquila
 {
+    /**
+     * Returned for channels which were not loaded.
+     */
+    static const WaveFile::channelType emptyChannel;
+    static const SampleBuffer emptyBuffer;
+
     /**
      * Creates the WaveFile object.
      *
@@ -36,7 +44,10 @@ namespace Aquila
      * @param frameOverlap overlap between adjacent frames
      */
     WaveFile::WaveFile(unsigned int frameLengthMs, double frameOverlap):
-        frameLength(frameLengthMs), overlap(frameOverlap)
+        frameLength(frameLengthMs), overlap(frameOverlap),
+        zeroPaddedLength(0), paddingType(PADDING_POWER_OF_2),
+        loadMode(LOAD_COPY), downmix(false), lazyFrames(false), frameChannel(0),
+        dataOffset(0), waveSize(0)
     {
     }
 
@@ -54,276 +65,398 @@ namespace Aquila
     /**
      * Reads the header and channel data from given .wav file.
      *
-     * Data are read into a temporary buffer and then converted to
-     * channel sample vectors. If source is a mono recording, samples
-     * are written to left channel.
+     * Data are read by a WaveReader and converted to channel sample
+     * vectors. If source is a mono recording, samples are written to
+     * left channel. Only the channels selected with setChannelSelection()
+     * are decoded.
      *
-     * To improve performance, no format checking is performed.
+     * In LOAD_MAPPED mode the file is memory-mapped instead, and frames
+     * view the samples in the mapping. In LOAD_NATIVE mode samples are
+     * kept in their native width, see setLoadMode(). Recordings can be
+     * mixed down to mono while loading, see setDownmix().
      *
      * @param file full path to .wav file
+     * @throw Aquila::Exception when the file cannot be opened or has none
+     * of the selected channels
+     * @throw FormatException file is not a recording in one of the
+     * encodings supported by WaveReader
      */
     void WaveFile::load(const std::string& file)
     {
         filename = file;
         LChTab.clear();
         RChTab.clear();
+        otherChTabs.clear();
+        for (unsigned int c = 0; c < channelBuffers.size(); ++c)
+            channelBuffers[c].clear();
+        loadedChannels.clear();
+        frameChannel = 0;
         if (frameLength != 0)
             clearFrames();
-
-        // first we read header from the stream
-        // then as we know now the data size, we create a temporary
-        // buffer and read raw data into that buffer
-        std::fstream fs;
-        fs.open(filename.c_str(), std::ios::in | std::ios::binary);
-        loadHeader(fs);
-        short* data = new short[hdr.WaveSize/2];
-        loadRawData(fs, data, hdr.WaveSize);
-        fs.close();
-
-        // initialize data channels (using right channel only in stereo mode)
-        unsigned int channelSize = hdr.WaveSize/hdr.BytesPerSamp;
-        LChTab.resize(channelSize);
-        if (2 == hdr.Channels)
-            RChTab.resize(channelSize);
-
-        // most important conversion happens right here
-        if (16 == hdr.BitsPerSamp)
+        mappedFile.reset();
+
+        WaveReader reader(filename);
+        hdr = reader.getHeader();
+        dataOffset = reader.getDataOffset();
+        waveSize = reader.getDataSize();
+
+        // only integer PCM samples can be viewed in the mapping directly,
+        // and only when they are aligned (RIFF aligns chunks to 2 bytes
+        // only); other data are decoded as in LOAD_NATIVE mode
+        const bool mapped = LOAD_MAPPED == loadMode &&
+            FORMAT_PCM == hdr.formatTag && 24 != hdr.BitsPerSamp &&
+            0 == dataOffset % (hdr.BitsPerSamp / 8);
+
+        // a mixed down recording is seen as mono from now on
+        const bool mix = !mapped && downmix && hdr.Channels > 1;
+        if (mix)
         {
-            if (2 == hdr.Channels)
-                convert16Stereo(data, channelSize);
-            else
-                convert16Mono(data, channelSize);
+            setMonoHeader();
+            loadedChannels.assign(1, true);
         }
         else
         {
-            if (2 == hdr.Channels)
-                convert8Stereo(data, channelSize);
-            else
-                convert8Mono(data, channelSize);
-        }
-
-        // clear the buffer
-        delete [] data;
-
-        // when we have the data, it is possible to create frames
-        if (frameLength != 0)
-            divideFrames(LChTab);
-    }
-
-    /**
-     * Returns the audio recording length
-     *
-     * @return recording length in milliseconds
-     */
-    unsigned int WaveFile::getAudioLength() const
-    {
-        return static_cast<unsigned int>(hdr.WaveSize /
-                static_cast<double>(hdr.BytesPerSec) * 1000);
-    }
-
+            const unsigned int channels = hdr.Channels;
+            loadedChannels.assign(channels, channelSelection.empty());
+            for (unsigned int i = 0; i < channelSelection.size(); ++i)
+            {
+                if (channelSelection[i] < channels)
+                    loadedChannels[channelSelection[i]] = true;
+            }
 
+            // frames are made of the first selected channel
+            frameChannel = std::find(loadedChannels.begin(),
+                                     loadedChannels.end(), true) -
+                loadedChannels.begin();
+            if (frameChannel >= channels)
+            {
+                throw Exception("Load error: none of the selected channels "
+                                "is in the file!");
+            }
+        }
 
-    /**
-     * Saves selected frame span to a new file.
-     *
-     * @param filename where to save frames
-     * @param begin number of the first frame
-     * @param end number of the last frame
-     * @throw FormatException not allowed to save 8b-mono files
-     */
-    void WaveFile::saveFrames(const std::string& filename, unsigned int begin,
-            unsigned int end) const
-    {
-        if (1 == hdr.Channels && 8 == hdr.BitsPerSamp)
+        if (mapped)
         {
-            throw FormatException("Save error: 8-bit mono files are not supported yet!");
+            // every channel can be viewed in the mapping at no cost
+            loadedChannels.assign(hdr.Channels, true);
+            mappedFile.reset(new MappedFile(filename));
+            if (frameLength != 0)
+                divideFrames(getChannelSpan(frameChannel));
+            return;
         }
-        unsigned int samples = getSamplesPerFrame();
 
-        // calculate the boundaries of a fragment of the source channel
-        // which correspond to given frame numbers
-        unsigned int startPos = static_cast<unsigned int>(
-                begin * samples * (1 - overlap));
-        unsigned int endPos = static_cast<unsigned int>(
-                (end + 1) * samples * (1 - overlap) + samples * overlap);
-        if (endPos > LChTab.size())
-            endPos = LChTab.size();
-
-        // number of data bytes in the resulting wave file
-        unsigned int waveSize = (endPos - startPos) * hdr.BytesPerSamp;
-
-        // prepare a new header and write it to file stream
-        WaveHeader newHdr;
-        std::strncpy(newHdr.RIFF, hdr.RIFF, 4);
-        newHdr.DataLength = waveSize + sizeof(WaveHeader);
-        std::strncpy(newHdr.WAVE, hdr.WAVE, 4);
-        std::strncpy(newHdr.fmt_, hdr.fmt_, 4);
-        newHdr.SubBlockLength = hdr.SubBlockLength;
-        newHdr.formatTag = hdr.formatTag;
-        newHdr.Channels = hdr.Channels;
-        newHdr.SampFreq = hdr.SampFreq;
-        newHdr.BytesPerSec = hdr.BytesPerSec;
-        newHdr.BytesPerSamp = hdr.BytesPerSamp;
-        newHdr.BitsPerSamp = hdr.BitsPerSamp;
-        std::strncpy(newHdr.data, hdr.data, 4);
-        newHdr.WaveSize = waveSize;
-
-        std::fstream fs;
-        fs.open(filename.c_str(), std::ios::out | std::ios::binary);
-        fs.write((char*)&newHdr, sizeof(WaveHeader));
-
-        // convert our data from source channels to a temporary buffer
-        short* data = new short[waveSize/2];
-        for (unsigned int i = startPos, di = 0; i < endPos; ++i, ++di)
+        // initialize selected data channels and convert the samples
+        // straight into them, skipping the other channels
+        const sampleIndexType channelSize = reader.getSamplesCount();
+        if (LOAD_COPY != loadMode)
         {
-            if (16 == hdr.BitsPerSamp)
+            switch (reader.getNativeFormat())
             {
-                if (2 == hdr.Channels)
-                {
-                    data[2*di] = LChTab[i];
-                    data[2*di+1] = RChTab[i];
-                }
-                else
-                {
-                    data[di] = LChTab[i];
-                }
+            case SAMPLE_INT8:
+                loadNative<boost::int8_t>(reader, mix);
+                break;
+            case SAMPLE_INT16:
+                loadNative<boost::int16_t>(reader, mix);
+                break;
+            case SAMPLE_FLOAT:
+                loadNative<float>(reader, mix);
+                break;
+            default:
+                loadNative<boost::int32_t>(reader, mix);
+                break;
+            }
+        }
+        else if (channelSize > 0)
+        {
+            if (mix)
+            {
+                LChTab.resize(channelSize);
+                reader.readMono(&LChTab[0], channelSize);
             }
             else
             {
-                if (2 == hdr.Channels)
+                const unsigned int channels = hdr.Channels;
+                if (channels > 2)
+                    otherChTabs.resize(channels - 2);
+                std::vector<int*> outputs(channels, static_cast<int*>(0));
+                for (unsigned int c = 0; c < channels; ++c)
                 {
-                    data[di/2] = ((RChTab[i] + 128) << 8) | (LChTab[i] + 128);
+                    if (loadedChannels[c])
+                    {
+                        channelType& channel = getChannelVector(c);
+                        channel.resize(channelSize);
+                        outputs[c] = &channel[0];
+                    }
                 }
+                reader.read(&outputs[0], channelSize);
             }
         }
 
-        // write the raw data to file and clean the buffer
-        fs.write((char*)data, waveSize);
-        fs.close();
-        delete [] data;
+        // when we have the data, it is possible to create frames
+        if (frameLength != 0)
+            divideFrames(getChannelSpan(frameChannel));
     }
 
     /**
-     * Recalculates frame division, taking new arguments into consideration.
+     * Checks whether samples of a channel are available.
      *
-     * @param newFrameLength new frame length in milliseconds
-     * @param newOverlap new overlap value
+     * In LOAD_MAPPED mode all channels of the file are available,
+     * otherwise only those selected with setChannelSelection().
+     *
+     * @param channel channel number
+     * @return true if the channel was loaded
+     * @since 2.6.0
      */
-    void WaveFile::recalculate(unsigned int newFrameLength, double newOverlap)
+    bool WaveFile::isChannelLoaded(unsigned int channel) const
     {
-        if (newFrameLength != 0)
-            frameLength = newFrameLength;
-
-        overlap = newOverlap;
-
-        clearFrames();
-        divideFrames(LChTab);
+        return channel < loadedChannels.size() && loadedChannels[channel];
     }
 
     /**
-     * Reads file header into the struct.
+     * Returns a const reference to channel source.
      *
-     * @param fs input file stream
-     * @see WaveFile::hdr
+     * @param channel which channel to use as a source
+     * @return source vector, empty if the channel was not loaded
      */
-    void WaveFile::loadHeader(std::fstream& fs)
+    const WaveFile::channelType& WaveFile::getDataVector(
+        unsigned int channel) const
     {
-        fs.read((char*)(&hdr), sizeof(WaveHeader));
+        if (LEFT_CHANNEL == channel)
+            return LChTab;
+        if (RIGHT_CHANNEL == channel)
+            return RChTab;
+        return (channel - 2 < otherChTabs.size()) ?
+            otherChTabs[channel - 2] : emptyChannel;
     }
 
     /**
-     * Reads raw data into the buffer.
+     * Returns native-width samples of a channel.
      *
-     * @param fs input file stream
-     * @param buffer pointer to data array
-     * @param bufferLength data buffer size
+     * The buffer is empty unless the file was loaded in LOAD_NATIVE mode.
+     *
+     * @param channel which channel to use as a source
+     * @return const reference to channel buffer
+     * @since 2.6.0
      */
-    void WaveFile::loadRawData(std::fstream& fs, short* buffer,
-            int bufferLength)
+    const SampleBuffer& WaveFile::getChannelBuffer(unsigned int channel) const
     {
-        fs.read((char*)buffer, bufferLength);
+        return (channel < channelBuffers.size()) ?
+            channelBuffers[channel] : emptyBuffer;
     }
 
     /**
-     * Converts the buffer to 16b stereo channels.
+     * Returns a view of channel samples.
+     *
+     * In LOAD_COPY mode the span views a channel vector, in LOAD_NATIVE
+     * mode a channel buffer, and in LOAD_MAPPED mode it views the original
+     * samples in the mapped file. Mono recordings have only the left
+     * channel.
      *
-     * @param data pointer to data buffer
-     * @param channelSize length of the channels
+     * @param channel which channel to view
+     * @return span of getSamplesCount() samples, valid until next load(),
+     * or an empty span if the channel was not loaded
+     * @since 2.6.0
      */
-    void WaveFile::convert16Stereo(short *data, unsigned int channelSize)
+    SampleSpan WaveFile::getChannelSpan(unsigned int channel) const
     {
-        for (unsigned int i = 0; i < channelSize; ++i)
+        if (!isChannelLoaded(channel))
+            return SampleSpan();
+
+        if (!mappedFile)
         {
-            LChTab[i] = data[2*i];
-            RChTab[i] = data[2*i+1];
+            const SampleBuffer& buffer = getChannelBuffer(channel);
+            if (buffer.getLength() > 0)
+                return buffer.getSpan();
+
+            const channelType& samples = getDataVector(channel);
+            return SampleSpan(samples.empty() ? 0 : &samples[0], SAMPLE_INT32,
+                              samples.size());
         }
+
+        SampleFormat format = SAMPLE_UINT8;
+        if (16 == hdr.BitsPerSamp)
+            format = SAMPLE_INT16;
+        else if (32 == hdr.BitsPerSamp)
+            format = SAMPLE_INT32;
+        const char* data = mappedFile->getData() + dataOffset +
+            channel * SampleSpan::getSampleSize(format);
+
+        return SampleSpan(data, format, waveSize / hdr.BytesPerSamp,
+                          hdr.Channels);
     }
 
     /**
-     * Converts the buffer to 16b mono channel.
+     * Returns a channel vector for writing.
      *
-     * @param data pointer to data buffer
-     * @param channelSize length of the channel
+     * @param channel channel number, less than number of channels
+     * @return reference to channel vector
      */
-    void WaveFile::convert16Mono(short *data, unsigned int channelSize)
+    WaveFile::channelType& WaveFile::getChannelVector(unsigned int channel)
     {
-        for (unsigned int i = 0; i < channelSize; ++i)
-        {
-            LChTab[i] = data[i];
-        }
+        if (LEFT_CHANNEL == channel)
+            return LChTab;
+        if (RIGHT_CHANNEL == channel)
+            return RChTab;
+        return otherChTabs[channel - 2];
     }
 
     /**
-     * Converts the buffer to 8b stereo channels.
+     * Reads samples into native-width channel buffers.
      *
-     * @param data pointer to data buffer
-     * @param channelSize length of the channels
+     * @param reader reader of the file being loaded
+     * @param mix whether to mix all channels down into the left buffer
      */
-    void WaveFile::convert8Stereo(short *data, unsigned int channelSize)
+    template <typename T>
+    void WaveFile::loadNative(WaveReader& reader, bool mix)
     {
-        // low byte and high byte of a 16b word
-        unsigned char lb, hb;
-        for (unsigned int i = 0; i < channelSize; ++i)
+        const sampleIndexType channelSize = reader.getSamplesCount();
+        const unsigned int channels = reader.getChannelsNum();
+        if (channelBuffers.size() < channels)
+            channelBuffers.resize(channels);
+        if (mix)
+        {
+            T* left = channelBuffers[LEFT_CHANNEL].resize<T>(channelSize);
+            reader.readMono(left, channelSize);
+            return;
+        }
+
+        std::vector<T*> outputs(channels, static_cast<T*>(0));
+        for (unsigned int c = 0; c < channels; ++c)
         {
-            splitBytes(data[i/2], lb, hb);
-            // left channel is in low byte, right in high
-            // values are unipolar, so we move them by half
-            // of the dynamic range
-            LChTab[i] = lb-128;
-            RChTab[i] = hb-128;
+            if (loadedChannels[c])
+                outputs[c] = channelBuffers[c].resize<T>(channelSize);
         }
+        reader.read(&outputs[0], channelSize);
+    }
+
+    /**
+     * Changes a multichannel header to describe the mixed down mono
+     * recording.
+     */
+    void WaveFile::setMonoHeader()
+    {
+        const unsigned int channels = hdr.Channels;
+        hdr.Channels = 1;
+        hdr.BytesPerSamp /= channels;
+        hdr.BytesPerSec /= channels;
+        waveSize /= channels;
+        hdr.WaveSize = static_cast<boost::uint32_t>(
+            std::min<boost::uint64_t>(waveSize, 0xFFFFFFFFu));
+    }
+
+    /**
+     * Returns the audio recording length
+     *
+     * @return recording length in milliseconds
+     */
+    unsigned int WaveFile::getAudioLength() const
+    {
+        return static_cast<unsigned int>(waveSize /
+                static_cast<double>(hdr.BytesPerSec) * 1000);
     }
 
+
+
     /**
-     * Converts the buffer to 8b mono channel.
+     * Saves selected frame span to a new file.
+     *
+     * Samples are streamed through a WaveWriter in the format of the
+     * loaded file. Companded files are saved as 16-bit PCM, floating point
+     * files as 32-bit floats with samples rounded to integers.
      *
-     * @param data pointer to data buffer
-     * @param channelSize length of the channel
+     * @param filename where to save frames
+     * @param begin number of the first frame
+     * @param end number of the last frame
+     * @throw Aquila::Exception when the file cannot be written
+     * @throw FormatException some channels were not loaded or the frames
+     * do not fit in a RIFF file
      */
-    void WaveFile::convert8Mono(short *data, unsigned int channelSize)
+    void WaveFile::saveFrames(const std::string& filename, unsigned int begin,
+            unsigned int end) const
     {
-        // low byte and high byte of a 16b word
-        unsigned char lb, hb;
-        for (unsigned int i = 0; i < channelSize; ++i)
+        const unsigned int channels = hdr.Channels;
+        for (unsigned int c = 0; c < channels; ++c)
+        {
+            if (!isChannelLoaded(c))
+            {
+                throw FormatException("Save error: all channels must be loaded!");
+            }
+        }
+        unsigned int samples = getSamplesPerFrame();
+
+        // calculate the boundaries of a fragment of the source channel
+        // which correspond to given frame numbers
+        sampleIndexType startPos = static_cast<sampleIndexType>(
+                static_cast<sampleIndexType>(begin) * samples * (1 - overlap));
+        sampleIndexType endPos = static_cast<sampleIndexType>(
+                (static_cast<sampleIndexType>(end) + 1) * samples *
+                (1 - overlap) + samples * overlap);
+        const sampleIndexType length = getSamplesCount();
+        if (endPos > length)
+            endPos = length;
+        if (startPos > endPos)
+            startPos = endPos;
+
+        // companded samples are already expanded to 16 bits
+        WaveFormatTag format = FORMAT_PCM;
+        unsigned short bits = hdr.BitsPerSamp;
+        if (FORMAT_IEEE_FLOAT == hdr.formatTag)
+        {
+            format = FORMAT_IEEE_FLOAT;
+            bits = 32;
+        }
+        else if (FORMAT_PCM != hdr.formatTag)
         {
-            splitBytes(data[i/2], lb, hb);
-            // only the left channel collects samples
-            LChTab[i] = lb-128;
+            bits = 16;
         }
+
+        // samples are encoded straight from the channels, a buffer at a time
+        std::vector<SampleSpan> spans(channels);
+        for (unsigned int c = 0; c < channels; ++c)
+            spans[c] = getChannelSpan(c).subspan(startPos, endPos);
+        WaveWriter writer(filename, hdr.SampFreq, channels, bits, format);
+        writer.write(&spans[0], endPos - startPos);
+        writer.close();
+    }
+
+    /**
+     * Recalculates frame division, taking new arguments into consideration.
+     *
+     * @param newFrameLength new frame length in milliseconds
+     * @param newOverlap new overlap value
+     */
+    void WaveFile::recalculate(unsigned int newFrameLength, double newOverlap)
+    {
+        if (newFrameLength != 0)
+            frameLength = newFrameLength;
+
+        overlap = newOverlap;
+
+        clearFrames();
+        divideFrames(getChannelSpan(frameChannel));
     }
 
     /**
-     * Splits a 16-b number to lower and upper byte.
+     * Calculates frame length after zero padding.
      *
-     * @param twoBytes number to split
-     * @param lb lower byte (by reference)
-     * @param hb upper byte (by reference)
+     * @param samplesPerFrame frame length before padding
+     * @param type zero padding type
+     * @return padded frame length
+     * @since 2.6.0
      */
-    void WaveFile::splitBytes(short twoBytes, unsigned char& lb,
-            unsigned char& hb)
+    unsigned int WaveFile::getZeroPaddedLength(unsigned int samplesPerFrame,
+                                               ZeroPaddingType type)
     {
-        lb = twoBytes & 0x00FF;
-        hb = (twoBytes >> 8) & 0x00FF;
+        if (PADDING_FAST_LENGTH == type)
+        {
+            return FftPlan::getFastLength(samplesPerFrame);
+        }
+        else
+        {
+            unsigned int power = static_cast<unsigned int>(
+                std::log(double(samplesPerFrame))/log(2.0));
+            return 1 << (power + 1);
+        }
     }
 
     /**
@@ -331,40 +464,35 @@ namespace Aquila
      *
      * Number of samples in an individual frame does not depend on the
      * overlap value. The overlap affects total number of frames.
+     * Frame boundaries are kept in the frame view; unless lazy frames
+     * are enabled, a Frame object is also created for each frame.
      *
-     * @param source const reference to source chanel
+     * @param source view of the source channel
      */
-    void WaveFile::divideFrames(const WaveFile::channelType& source)
+    void WaveFile::divideFrames(const SampleSpan& source)
     {
         // calculate how many samples are in the part of the frame
-        // which does NOT overlap, and use that value to find out
-        // total number of frames; also set zero-padded length
+        // which does NOT overlap, this is the distance between frames;
+        // also set zero-padded length
         samplesPerFrame = getSamplesPerFrame();
         unsigned int samplesPerNonOverlap =
             static_cast<unsigned int>(samplesPerFrame * (1 - overlap));
-        unsigned int framesCount =
-            (hdr.WaveSize / hdr.BytesPerSamp) / samplesPerNonOverlap;
-        unsigned int power =
-            static_cast<unsigned int>(std::log(double(samplesPerFrame))/log(2.0));
-        zeroPaddedLength = 1 << (power + 1);
+        frameView = FrameView(source, samplesPerFrame, samplesPerNonOverlap);
+        zeroPaddedLength = getZeroPaddedLength(samplesPerFrame, paddingType);
+
+        if (lazyFrames)
+            return;
 
+        const unsigned int framesCount = frameView.getFramesCount();
         frames.reserve(framesCount);
-        unsigned int indexBegin = 0, indexEnd = 0;
-        for (unsigned int i = 0, size = source.size(); i < framesCount; ++i)
+        for (unsigned int i = 0; i < framesCount; ++i)
         {
-            // calculate frame boundaries in the source channel
-            // when frame end exceeds channel size, break out
-            indexBegin = i * samplesPerNonOverlap;
-            indexEnd = indexBegin + samplesPerFrame;
-            if (indexEnd < size)
-                frames.push_back(new Frame(source, indexBegin, indexEnd));
-            else
-                break;
+            frames.push_back(new Frame(frameView.getFrame(i)));
         }
     }
 
     /**
-     * Deletes all frame objects and clears the vector.
+     * Deletes all frame objects and clears the vector and the view.
      */
     void WaveFile::clearFrames()
     {
@@ -374,6 +502,7 @@ namespace Aquila
         }
 
         frames.clear();
+        frameView = FrameView();
     }
 }
 
@@ -17,13 +17,23 @@
 
 #include "global.h"
 #include "Frame.h"
+#include "FrameView.h"
+#include "MappedFile.h"
+#include "SampleBuffer.h"
+#include "SampleSpan.h"
 #include <string>
 #include <vector>
 #include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
 
 
 namespace Aquila
 {
+    /**
+     * Forward reference to streaming reader class.
+     */
+    class WaveReader;
+
     /**
      * .wav file header structure.
      */
@@ -45,12 +55,50 @@ namespace Aquila
     };
 
 
+    /**
+     * Format tags of supported sample encodings.
+     *
+     * FORMAT_EXTENSIBLE files are read as the format in their sub-format
+     * GUID.
+     */
+    enum WaveFormatTag { FORMAT_PCM = 1, FORMAT_IEEE_FLOAT = 3,
+                         FORMAT_ALAW = 6, FORMAT_MULAW = 7,
+                         FORMAT_EXTENSIBLE = 0xFFFE };
+
+
     /**
      * Which channel to use when reading stereo recordings.
+     *
+     * Channels of multichannel recordings are given by their numbers,
+     * LEFT_CHANNEL and RIGHT_CHANNEL are the first two of them.
      */
     enum StereoDataSource { LEFT_CHANNEL, RIGHT_CHANNEL };
 
 
+    /**
+     * How to choose frame length after zero padding.
+     *
+     * PADDING_POWER_OF_2 - next power of 2 larger than frame length
+     * PADDING_FAST_LENGTH - smallest even length not less than frame
+     * length, which has no prime factors other than 2, 3 and 5
+     */
+    enum ZeroPaddingType { PADDING_POWER_OF_2, PADDING_FAST_LENGTH };
+
+
+    /**
+     * How the samples are loaded.
+     *
+     * LOAD_COPY - samples are converted to channel vectors
+     * LOAD_MAPPED - the file is memory-mapped and frames view the samples
+     * in the mapping, channel vectors stay empty; files other than 8, 16
+     * and 32-bit PCM, or with samples not aligned to their size in the
+     * file, are loaded as in LOAD_NATIVE mode
+     * LOAD_NATIVE - samples are stored in channel buffers in their native
+     * width (see WaveReader::getNativeFormat()), channel vectors stay empty
+     */
+    enum LoadMode { LOAD_COPY, LOAD_MAPPED, LOAD_NATIVE };
+
+
     /**
      * Wave file data access.
      */
@@ -63,12 +111,17 @@ namespace Aquila
         typedef std::vector<int> channelType;
 
         /**
-         * Data from both channels.
+         * Data from the first two channels.
+         *
+         * Further channels of multichannel recordings are accessed with
+         * getDataVector().
          */
         channelType LChTab, RChTab;
 
         /**
          * Pointers to signal frames.
+         *
+         * Empty when lazy frames are enabled, see getFrameView().
          */
         std::vector<Frame*> frames;
 
@@ -88,7 +141,7 @@ namespace Aquila
         /**
          * Returns number of channels.
          *
-         * @return 1 for mono, 2 for stereo, other types are not recognized
+         * @return 1 for mono, 2 for stereo, more for multichannel files
          */
         unsigned short getChannelsNum() const { return hdr.Channels; }
 
@@ -110,13 +163,14 @@ namespace Aquila
          * Returns number of bytes per sample.
          *
          * @return 1 for 8b-mono, 2 for 8b-stereo or 16b-mono, 4 dor 16b-stereo
+         * (and so on for wider samples)
          */
         unsigned int getBytesPerSamp() const { return hdr.BytesPerSamp; }
 
         /**
          * Returns number of bits per sample
          *
-         * @return 8 or 16
+         * @return 8, 16, 24, 32 or 64
          */
         unsigned int getBitsPerSamp() const { return hdr.BitsPerSamp; }
 
@@ -124,18 +178,20 @@ namespace Aquila
          * Returns the recording size (without header).
          *
          * The return value is a raw byte count. To know the real sample count,
-         * it must be divided by bytes per sample.
+         * it must be divided by bytes per sample. Unlike the WaveSize header
+         * field, it is not limited to 4 GB.
          *
          * @return byte count
          */
-        unsigned int getWaveSize() const { return hdr.WaveSize; }
+        boost::uint64_t getWaveSize() const { return waveSize; }
 
         /**
          * Returns the real data length.
          *
-         * @return left channel vector size
+         * @return number of samples in a channel
          */
-        unsigned int getSamplesCount() const { return LChTab.size(); }
+        sampleIndexType getSamplesCount() const
+            { return getChannelSpan(frameChannel).length; }
 
         unsigned int getAudioLength() const;
 
@@ -148,18 +204,19 @@ namespace Aquila
          * but as we use it only to copy that memory to another buffer,
          * we can do that safely.
          *
+         * Channel vectors are empty in LOAD_MAPPED and LOAD_NATIVE modes,
+         * use getChannelSpan().
+         *
          * @return address of the first element
          */
         int* getData() { return &LChTab[0]; }
 
-        /**
-         * Returns a const reference to channel source.
-         *
-         * @param source which channel to use as a source
-         * @return source vector
-         */
-        const channelType& getDataVector(StereoDataSource source = LEFT_CHANNEL) const
-            { return (source == LEFT_CHANNEL) ? LChTab : RChTab; }
+        const channelType& getDataVector(unsigned int channel = LEFT_CHANNEL) const;
+
+        const SampleBuffer& getChannelBuffer(
+            unsigned int channel = LEFT_CHANNEL) const;
+
+        SampleSpan getChannelSpan(unsigned int channel = LEFT_CHANNEL) const;
 
         void saveFrames(const std::string& filename,
                         unsigned int begin,
@@ -168,9 +225,20 @@ namespace Aquila
         /**
          * Returns number of frames in the file.
          *
-         * @return frame vector length
+         * @return number of frames, also with lazy frames enabled
          */
-        unsigned int getFramesCount() const { return frames.size(); }
+        unsigned int getFramesCount() const
+            { return frameView.getFramesCount(); }
+
+        /**
+         * Returns frames of the file, computed on demand.
+         *
+         * The view is valid until next load() or recalculate().
+         *
+         * @return view of all frames
+         * @since 2.6.0
+         */
+        const FrameView& getFrameView() const { return frameView; }
 
 
         /**
@@ -189,12 +257,122 @@ namespace Aquila
         /**
          * Returns frame length (in samples) after zero padding (ZP).
          *
-         * @return padded frame length is a power of 2
+         * @return padded frame length, depending on zero padding type
          */
         unsigned int getSamplesPerFrameZP() const { return zeroPaddedLength; }
 
+        /**
+         * Sets the way of choosing zero padded frame length.
+         *
+         * Takes effect on next load() or recalculate().
+         *
+         * @param type zero padding type
+         */
+        void setZeroPadding(ZeroPaddingType type) { paddingType = type; }
+
+        /**
+         * Returns the way of choosing zero padded frame length.
+         *
+         * @return zero padding type
+         */
+        ZeroPaddingType getZeroPadding() const { return paddingType; }
+
+        /**
+         * Sets the way of loading samples.
+         *
+         * Takes effect on next load().
+         *
+         * @param mode load mode
+         */
+        void setLoadMode(LoadMode mode) { loadMode = mode; }
+
+        /**
+         * Returns the way of loading samples.
+         *
+         * @return load mode
+         */
+        LoadMode getLoadMode() const { return loadMode; }
+
+        /**
+         * Sets whether stereo recordings are mixed down to mono.
+         *
+         * A mixed down recording is seen as mono: the left channel holds
+         * the mean of all channels and the header describes a single
+         * channel. Channel selection is ignored then. Takes effect on next
+         * load(), ignored in LOAD_MAPPED mode.
+         *
+         * @param enabled true to mix channels down
+         * @since 2.6.0
+         */
+        void setDownmix(bool enabled) { downmix = enabled; }
+
+        /**
+         * Checks whether stereo recordings are mixed down to mono.
+         *
+         * @return true if downmix is enabled
+         * @since 2.6.0
+         */
+        bool getDownmix() const { return downmix; }
+
+        /**
+         * Enables or disables lazy frames.
+         *
+         * With lazy frames, frame division does not create Frame objects
+         * and the frames vector stays empty; frames are accessed through
+         * getFrameView() instead. Frame division then takes constant time
+         * and memory. Takes effect on next load() or recalculate().
+         *
+         * @param enabled whether to skip creating frame objects
+         * @since 2.6.0
+         */
+        void setLazyFrames(bool enabled) { lazyFrames = enabled; }
+
+        /**
+         * Checks whether frame division skips creating frame objects.
+         *
+         * @return true if lazy frames are enabled
+         * @since 2.6.0
+         */
+        bool getLazyFrames() const { return lazyFrames; }
+
+        /**
+         * Selects channels to load.
+         *
+         * Only the selected channels are decoded and kept in memory, samples
+         * of the other ones are skipped. Frames are made of the first
+         * selected channel present in the file. An empty selection (the
+         * default) loads all channels. Takes effect on next load().
+         *
+         * @param channels numbers of channels to load
+         * @since 2.6.0
+         */
+        void setChannelSelection(const std::vector<unsigned int>& channels)
+            { channelSelection = channels; }
+
+        /**
+         * Returns numbers of channels to load.
+         *
+         * @return channel selection, empty if all channels are loaded
+         * @since 2.6.0
+         */
+        const std::vector<unsigned int>& getChannelSelection() const
+            { return channelSelection; }
+
+        bool isChannelLoaded(unsigned int channel) const;
+
+        /**
+         * Returns number of the channel divided into frames.
+         *
+         * @return the first selected channel of the loaded file
+         * @since 2.6.0
+         */
+        unsigned int getFrameChannel() const { return frameChannel; }
+
         void recalculate(unsigned int newFrameLength = 0, double newOverlap = 0.66);
 
+        static unsigned int getZeroPaddedLength(unsigned int samplesPerFrame,
+                                                ZeroPaddingType type);
+
     private:
         /**
          * Full path of the .wav file.
@@ -222,19 +400,83 @@ namespace Aquila
         double overlap;
 
         /**
-         * Next power of 2 larger than number of samples per frame.
+         * Frame length after zero padding.
          */
         unsigned int zeroPaddedLength;
 
-        void loadHeader(std::fstream& file);
-        void loadRawData(std::fstream& file, short* buffer, int bufferLength);
-        void convert16Stereo(short* data, unsigned int channelSize);
-        void convert16Mono(short* data, unsigned int channelSize);
-        void convert8Stereo(short* data, unsigned int channelSize);
-        void convert8Mono(short* data, unsigned int channelSize);
-        void splitBytes(short twoBytes, unsigned char& lb, unsigned char& hb);
+        /**
+         * How the zero padded length is chosen.
+         */
+        ZeroPaddingType paddingType;
+
+        /**
+         * How the samples are loaded.
+         */
+        LoadMode loadMode;
+
+        /**
+         * Whether stereo channels are mixed down on load.
+         */
+        bool downmix;
+
+        /**
+         * Whether frame division skips creating frame objects.
+         */
+        bool lazyFrames;
+
+        /**
+         * Frame boundaries of the current frame division.
+         */
+        FrameView frameView;
+
+        /**
+         * Numbers of channels to load, empty for all channels.
+         */
+        std::vector<unsigned int> channelSelection;
+
+        /**
+         * Which channels of the file were loaded.
+         */
+        std::vector<bool> loadedChannels;
+
+        /**
+         * Channel divided into frames.
+         */
+        unsigned int frameChannel;
+
+        /**
+         * The mapped file in LOAD_MAPPED mode.
+         */
+        boost::shared_ptr<MappedFile> mappedFile;
+
+        /**
+         * Offset of the sample data in the file.
+         */
+        boost::uint64_t dataOffset;
+
+        /**
+         * Size of the sample data in bytes.
+         */
+        boost::uint64_t waveSize;
+
+        /**
+         * Data from channels after the first two.
+         */
+        std::vector<channelType> otherChTabs;
+
+        /**
+         * Native-width channel samples in LOAD_NATIVE mode.
+         */
+        std::vector<SampleBuffer> channelBuffers;
+
+        channelType& getChannelVector(unsigned int channel);
+
+        template <typename T>
+        void loadNative(WaveReader& reader, bool mix);
+
+        void setMonoHeader();
 
-        void divideFrames(const channelType& source);
+        void divideFrames(const SampleSpan& source);
         void clearFrames();
     };
 }
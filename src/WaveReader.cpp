@@ -0,0 +1,1158 @@
+/**
+ * @file WaveReader.cpp
+ *
+ * Streaming WAVE file reader - implementation.
+ *
+ * WaveReader walks the RIFF chunks of a .wav file and reads samples
+ * block by block, so that recordings larger than available memory
+ * can be processed.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#include "WaveReader.h"
+
+#include "Exceptions.h"
+#include "PcmKernels.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <boost/cstdint.hpp>
+
+namespace Aquila
+{
+    /**
+     * Size of the raw data buffer in bytes.
+     */
+    const unsigned int READ_BUFFER_SIZE = 65536;
+
+    /**
+     * Copies a little-endian header field from raw chunk data.
+     *
+     * @param data pointer to the field in chunk data
+     * @param field where to store the value
+     */
+    template <typename T>
+    static void readField(const char* data, T& field)
+    {
+        std::memcpy(&field, data, sizeof(T));
+    }
+
+    /**
+     * Limits a 64-bit size to a 32-bit header field.
+     *
+     * @param size size in bytes
+     * @return size or 0xFFFFFFFF, whichever is smaller
+     */
+    static boost::uint32_t saturateField(boost::uint64_t size)
+    {
+        return static_cast<boost::uint32_t>(
+            std::min<boost::uint64_t>(size, 0xFFFFFFFFu));
+    }
+
+    /**
+     * GUID of the Sony Wave64 "riff" chunk, after the first four bytes.
+     */
+    static const char W64_RIFF_GUID[12] = {
+        '\x2E', '\x91', '\xCF', '\x11', '\xA5', '\xD6',
+        '\x28', '\xDB', '\x04', '\xC1', '\x00', '\x00' };
+
+    /**
+     * Common part of the other Wave64 chunk GUIDs, which begin with the
+     * RIFF chunk name (eg. "fmt " or "data").
+     */
+    static const char W64_CHUNK_GUID[12] = {
+        '\xF3', '\xAC', '\xD3', '\x11', '\x8C', '\xD1',
+        '\x00', '\xC0', '\x4F', '\x8E', '\xDB', '\x8A' };
+
+    /**
+     * Checks name of a RIFF or Wave64 chunk.
+     *
+     * @param chunk chunk header
+     * @param name four character chunk name
+     * @param w64 whether the header is a Wave64 GUID
+     * @return true, if the chunk has given name
+     */
+    static bool isChunk(const char* chunk, const char* name, bool w64)
+    {
+        return 0 == std::memcmp(chunk, name, 4) &&
+            (!w64 || 0 == std::memcmp(chunk + 4, W64_CHUNK_GUID, 12));
+    }
+
+    /**
+     * Decoders of raw samples in supported encodings.
+     *
+     * A decoder knows the size of a single sample in bytes, and its
+     * decode() returns the value of the sample at a given address, as int
+     * or float.
+     */
+    struct Pcm8Decoder
+    {
+        static const unsigned int size = 1;
+        int decode(const char* p) const
+        {
+            return static_cast<boost::uint8_t>(*p) - 128;
+        }
+    };
+
+    struct Pcm16Decoder
+    {
+        static const unsigned int size = 2;
+        int decode(const char* p) const
+        {
+            boost::int16_t v;
+            std::memcpy(&v, p, 2);
+            return v;
+        }
+    };
+
+    struct Pcm24Decoder
+    {
+        static const unsigned int size = 3;
+        int decode(const char* p) const
+        {
+            return static_cast<boost::int8_t>(p[2]) * 65536 +
+                (static_cast<boost::uint8_t>(p[1]) << 8) +
+                static_cast<boost::uint8_t>(p[0]);
+        }
+    };
+
+    struct Pcm32Decoder
+    {
+        static const unsigned int size = 4;
+        int decode(const char* p) const
+        {
+            boost::int32_t v;
+            std::memcpy(&v, p, 4);
+            return v;
+        }
+    };
+
+    struct Float32Decoder
+    {
+        static const unsigned int size = 4;
+        float decode(const char* p) const
+        {
+            float v;
+            std::memcpy(&v, p, 4);
+            return v * FLOAT_SAMPLE_SCALE;
+        }
+    };
+
+    struct Float64Decoder
+    {
+        static const unsigned int size = 8;
+        float decode(const char* p) const
+        {
+            double v;
+            std::memcpy(&v, p, 8);
+            return static_cast<float>(v * FLOAT_SAMPLE_SCALE);
+        }
+    };
+
+    struct CompandedDecoder
+    {
+        static const unsigned int size = 1;
+        explicit CompandedDecoder(const boost::int16_t* expansionTable):
+            table(expansionTable)
+        {
+        }
+        int decode(const char* p) const
+        {
+            return table[static_cast<boost::uint8_t>(*p)];
+        }
+        const boost::int16_t* table;
+    };
+
+    /**
+     * Stores an integer sample.
+     *
+     * Native sample types are wide enough for samples decoded as int.
+     */
+    template <typename T>
+    static inline void storeSample(int value, T& out)
+    {
+        out = static_cast<T>(value);
+    }
+
+    /**
+     * Stores a floating point sample, saturated and rounded.
+     */
+    template <typename T>
+    static inline void storeSample(float value, T& out)
+    {
+        const float low = std::numeric_limits<T>::min();
+        const float high = std::numeric_limits<T>::max();
+        if (value < low)
+            value = low;
+        if (value > high)
+            value = high;
+        out = static_cast<T>(SampleSpan::roundSample(value));
+    }
+
+    /**
+     * Stores a floating point sample as int, saturated and rounded.
+     */
+    static inline void storeSample(float value, int& out)
+    {
+        out = SampleSpan::roundSample(value);
+    }
+
+    /**
+     * Stores a floating point sample.
+     */
+    static inline void storeSample(float value, float& out)
+    {
+        out = value;
+    }
+
+    /**
+     * Mean of two integer samples, rounded towards minus infinity.
+     *
+     * Written so that 32-bit samples do not overflow.
+     */
+    static inline int mean(int a, int b)
+    {
+        return (a >> 1) + (b >> 1) + (a & b & 1);
+    }
+
+    /**
+     * Mean of two floating point samples.
+     */
+    static inline float mean(float a, float b)
+    {
+        return (a + b) * 0.5f;
+    }
+
+    /**
+     * Decodes raw stereo data into channels.
+     *
+     * @param decoder decoder of the sample encoding
+     * @param data pointer to raw data
+     * @param count number of samples in a channel
+     * @param left left channel or 0
+     * @param right right channel or 0
+     */
+    template <typename D, typename T>
+    static void decodeStereo(const D& decoder, const char* data,
+                             unsigned int count, T* left, T* right)
+    {
+        if (left)
+        {
+            for (unsigned int i = 0; i < count; ++i)
+                storeSample(decoder.decode(data + 2*i*D::size), left[i]);
+        }
+        if (right)
+        {
+            for (unsigned int i = 0; i < count; ++i)
+                storeSample(decoder.decode(data + (2*i+1)*D::size), right[i]);
+        }
+    }
+
+    /**
+     * Decodes raw mono data.
+     *
+     * @param decoder decoder of the sample encoding
+     * @param data pointer to raw data
+     * @param count number of samples
+     * @param output the channel
+     */
+    template <typename D, typename T>
+    static void decodeMono(const D& decoder, const char* data,
+                           unsigned int count, T* output)
+    {
+        for (unsigned int i = 0; i < count; ++i)
+            storeSample(decoder.decode(data + i*D::size), output[i]);
+    }
+
+    /**
+     * Decodes raw stereo data, mixing both channels down to one.
+     *
+     * @param decoder decoder of the sample encoding
+     * @param data pointer to raw data
+     * @param count number of samples in a channel
+     * @param output mono channel
+     */
+    template <typename D, typename T>
+    static void decodeMix(const D& decoder, const char* data,
+                          unsigned int count, T* output)
+    {
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            storeSample(mean(decoder.decode(data + 2*i*D::size),
+                             decoder.decode(data + (2*i+1)*D::size)),
+                        output[i]);
+        }
+    }
+
+    // vectorized versions of the above, chosen by overload resolution
+
+    static void decodeStereo(const Pcm8Decoder&, const char* data,
+                             unsigned int count, int* left, int* right)
+    {
+        PcmKernels::deinterleave8(reinterpret_cast<const boost::uint8_t*>(data),
+                                  count, left, right);
+    }
+
+    static void decodeMono(const Pcm8Decoder&, const char* data,
+                           unsigned int count, int* output)
+    {
+        PcmKernels::widen8(reinterpret_cast<const boost::uint8_t*>(data),
+                           count, output);
+    }
+
+    static void decodeMix(const Pcm8Decoder&, const char* data,
+                          unsigned int count, int* output)
+    {
+        PcmKernels::downmix8(reinterpret_cast<const boost::uint8_t*>(data),
+                             count, output);
+    }
+
+    static void decodeStereo(const Pcm16Decoder&, const char* data,
+                             unsigned int count, int* left, int* right)
+    {
+        PcmKernels::deinterleave16(
+            reinterpret_cast<const boost::int16_t*>(data), count, left, right);
+    }
+
+    static void decodeStereo(const Pcm16Decoder&, const char* data,
+                             unsigned int count, boost::int16_t* left,
+                             boost::int16_t* right)
+    {
+        PcmKernels::deinterleave16(
+            reinterpret_cast<const boost::int16_t*>(data), count, left, right);
+    }
+
+    static void decodeMono(const Pcm16Decoder&, const char* data,
+                           unsigned int count, int* output)
+    {
+        PcmKernels::widen16(reinterpret_cast<const boost::int16_t*>(data),
+                            count, output);
+    }
+
+    static void decodeMix(const Pcm16Decoder&, const char* data,
+                          unsigned int count, int* output)
+    {
+        PcmKernels::downmix16(reinterpret_cast<const boost::int16_t*>(data),
+                              count, output);
+    }
+
+    static void decodeMix(const Pcm16Decoder&, const char* data,
+                          unsigned int count, boost::int16_t* output)
+    {
+        PcmKernels::downmix16(reinterpret_cast<const boost::int16_t*>(data),
+                              count, output);
+    }
+
+    static void decodeStereo(const Pcm24Decoder&, const char* data,
+                             unsigned int count, int* left, int* right)
+    {
+        PcmKernels::deinterleave24(
+            reinterpret_cast<const boost::uint8_t*>(data), count, left, right);
+    }
+
+    static void decodeMono(const Pcm24Decoder&, const char* data,
+                           unsigned int count, int* output)
+    {
+        PcmKernels::widen24(reinterpret_cast<const boost::uint8_t*>(data),
+                            count, output);
+    }
+
+    static void decodeMix(const Pcm24Decoder&, const char* data,
+                          unsigned int count, int* output)
+    {
+        PcmKernels::downmix24(reinterpret_cast<const boost::uint8_t*>(data),
+                              count, output);
+    }
+
+    static void decodeStereo(const Float32Decoder&, const char* data,
+                             unsigned int count, int* left, int* right)
+    {
+        PcmKernels::deinterleaveFloat(reinterpret_cast<const float*>(data),
+                                      count, FLOAT_SAMPLE_SCALE, left, right);
+    }
+
+    static void decodeStereo(const Float32Decoder&, const char* data,
+                             unsigned int count, float* left, float* right)
+    {
+        PcmKernels::deinterleaveFloat(reinterpret_cast<const float*>(data),
+                                      count, FLOAT_SAMPLE_SCALE, left, right);
+    }
+
+    static void decodeMono(const Float32Decoder&, const char* data,
+                           unsigned int count, int* output)
+    {
+        PcmKernels::scaleFloat(reinterpret_cast<const float*>(data), count,
+                               FLOAT_SAMPLE_SCALE, output);
+    }
+
+    static void decodeMono(const Float32Decoder&, const char* data,
+                           unsigned int count, float* output)
+    {
+        PcmKernels::scaleFloat(reinterpret_cast<const float*>(data), count,
+                               FLOAT_SAMPLE_SCALE, output);
+    }
+
+    static void decodeMix(const Float32Decoder&, const char* data,
+                          unsigned int count, int* output)
+    {
+        PcmKernels::downmixFloat(reinterpret_cast<const float*>(data), count,
+                                 FLOAT_SAMPLE_SCALE, output);
+    }
+
+    static void decodeMix(const Float32Decoder&, const char* data,
+                          unsigned int count, float* output)
+    {
+        PcmKernels::downmixFloat(reinterpret_cast<const float*>(data), count,
+                                 FLOAT_SAMPLE_SCALE, output);
+    }
+
+    /**
+     * Decodes a single channel of raw multichannel data.
+     *
+     * Samples of other channels are only skipped over.
+     *
+     * @param decoder decoder of the sample encoding
+     * @param data pointer to raw data
+     * @param count number of samples in a channel
+     * @param channels number of interleaved channels
+     * @param channel which channel to decode
+     * @param output the channel
+     */
+    template <typename D, typename T>
+    static void decodeChannel(const D& decoder, const char* data,
+                              unsigned int count, unsigned int channels,
+                              unsigned int channel, T* output)
+    {
+        const char* in = data + channel * D::size;
+        const unsigned int step = channels * D::size;
+        for (unsigned int i = 0; i < count; ++i, in += step)
+            storeSample(decoder.decode(in), output[i]);
+    }
+
+    /**
+     * Mean of integer samples of all channels, rounded towards minus
+     * infinity.
+     */
+    template <typename D>
+    static inline int mixChannels(const D& decoder, const char* in,
+                                  unsigned int channels, int first)
+    {
+        boost::int64_t sum = first;
+        for (unsigned int c = 1; c < channels; ++c)
+            sum += decoder.decode(in + c * D::size);
+        return static_cast<int>(sum >= 0 ? sum / channels :
+                                -((-sum + channels - 1) / channels));
+    }
+
+    /**
+     * Mean of floating point samples of all channels.
+     */
+    template <typename D>
+    static inline float mixChannels(const D& decoder, const char* in,
+                                    unsigned int channels, float first)
+    {
+        float sum = first;
+        for (unsigned int c = 1; c < channels; ++c)
+            sum += decoder.decode(in + c * D::size);
+        return sum / channels;
+    }
+
+    /**
+     * Decodes raw multichannel data, mixing all channels down to one.
+     *
+     * @param decoder decoder of the sample encoding
+     * @param data pointer to raw data
+     * @param count number of samples in a channel
+     * @param channels number of interleaved channels
+     * @param output mono channel
+     */
+    template <typename D, typename T>
+    static void decodeMixAll(const D& decoder, const char* data,
+                             unsigned int count, unsigned int channels,
+                             T* output)
+    {
+        const unsigned int step = channels * D::size;
+        for (unsigned int i = 0; i < count; ++i, data += step)
+        {
+            storeSample(mixChannels(decoder, data, channels,
+                                    decoder.decode(data)), output[i]);
+        }
+    }
+
+    /**
+     * Decodes a chunk of raw data.
+     *
+     * Channel arrays are written from a given offset. Channels without
+     * an array (a null pointer or beyond outputCount) are skipped.
+     *
+     * @param decoder decoder of the sample encoding
+     * @param data pointer to raw data
+     * @param count number of samples in a channel
+     * @param channels number of interleaved channels
+     * @param outputs channel arrays
+     * @param outputCount number of channel arrays
+     * @param offset where to write the first sample in channel arrays
+     * @param downmix whether to mix all channels down into the first array
+     */
+    template <typename D, typename T>
+    static void decode(const D& decoder, const char* data, unsigned int count,
+                       unsigned int channels, T* const* outputs,
+                       unsigned int outputCount, unsigned int offset,
+                       bool downmix)
+    {
+        if (downmix && channels > 1)
+        {
+            if (2 == channels)
+                decodeMix(decoder, data, count, outputs[0] + offset);
+            else
+                decodeMixAll(decoder, data, count, channels,
+                             outputs[0] + offset);
+            return;
+        }
+
+        if (1 == channels)
+        {
+            if (outputs[0])
+                decodeMono(decoder, data, count, outputs[0] + offset);
+        }
+        else if (2 == channels)
+        {
+            T* left = outputs[0] ? outputs[0] + offset : 0;
+            T* right = (outputCount > 1 && outputs[1]) ?
+                outputs[1] + offset : 0;
+            if (left || right)
+                decodeStereo(decoder, data, count, left, right);
+        }
+        else
+        {
+            const unsigned int n = std::min(channels, outputCount);
+            for (unsigned int c = 0; c < n; ++c)
+            {
+                if (outputs[c])
+                    decodeChannel(decoder, data, count, channels, c,
+                                  outputs[c] + offset);
+            }
+        }
+    }
+
+    /**
+     * Opens the file and reads its header.
+     *
+     * @param file full path to .wav file
+     * @param samplesPerBlock number of samples read at once by readBlock()
+     * @throw Aquila::Exception when the file cannot be opened
+     * @throw FormatException file is not a recording in one of the
+     * supported encodings
+     */
+    WaveReader::WaveReader(const std::string& file,
+                           unsigned int samplesPerBlock):
+        filename(file), stream(file.c_str(), std::ios::in | std::ios::binary),
+        encoding(PCM_16), dataOffset(0), dataSize(0), samplesCount(0),
+        position(0),
+        blockSize(samplesPerBlock),
+        buffer(READ_BUFFER_SIZE)
+    {
+        if (!stream)
+        {
+            throw Exception("Cannot open file " + filename);
+        }
+
+        dataOffset = readHeader(stream, hdr, dataSize);
+        if (0 == hdr.Channels)
+        {
+            throw FormatException("Load error: no channels!");
+        }
+        if (!findEncoding(hdr, encoding) ||
+            hdr.BytesPerSamp != hdr.Channels * hdr.BitsPerSamp / 8)
+        {
+            throw FormatException("Load error: unsupported sample format!");
+        }
+
+        // a truncated file has less data than the header says, and some
+        // recorders leave the data size unset until the recording ends
+        stream.seekg(0, std::ios::end);
+        const boost::uint64_t fileSize =
+            static_cast<boost::uint64_t>(stream.tellg());
+        const boost::uint64_t available =
+            (fileSize > dataOffset) ? fileSize - dataOffset : 0;
+        if (dataSize > available)
+            dataSize = available;
+        samplesCount = dataSize / hdr.BytesPerSamp;
+        dataSize = samplesCount * hdr.BytesPerSamp;
+        hdr.WaveSize = saturateField(dataSize);
+
+        seek(0);
+    }
+
+    /**
+     * Moves to a given sample.
+     *
+     * @param sample number of the next sample to read
+     */
+    void WaveReader::seek(sampleIndexType sample)
+    {
+        position = std::min(sample, samplesCount);
+        stream.clear();
+        stream.seekg(static_cast<std::streamoff>(
+            dataOffset + position * hdr.BytesPerSamp), std::ios::beg);
+    }
+
+    /**
+     * Reads next samples into channel arrays.
+     *
+     * Either of the arrays can be null to skip that channel. Mono
+     * recordings have only the left channel; in multichannel recordings
+     * left and right are the first two channels.
+     *
+     * @param left array of at least count samples or 0
+     * @param right array of at least count samples or 0
+     * @param count maximum number of samples to read
+     * @return number of samples read, 0 at the end of the recording
+     */
+    sampleIndexType WaveReader::read(int* left, int* right,
+                                     sampleIndexType count)
+    {
+        int* outputs[2] = { left, right };
+        return readSamples(outputs, 2, count);
+    }
+
+    /**
+     * Reads next samples into 16-bit channel arrays.
+     *
+     * @param left array of at least count samples or 0
+     * @param right array of at least count samples or 0
+     * @param count maximum number of samples to read
+     * @return number of samples read, 0 at the end of the recording
+     * @throw FormatException samples are wider than 16 bits
+     * @see read(int*, int*, sampleIndexType)
+     */
+    sampleIndexType WaveReader::read(boost::int16_t* left,
+                                     boost::int16_t* right,
+                                     sampleIndexType count)
+    {
+        checkNativeFormat(SAMPLE_INT16);
+        boost::int16_t* outputs[2] = { left, right };
+        return readSamples(outputs, 2, count);
+    }
+
+    /**
+     * Reads next samples into 8-bit channel arrays.
+     *
+     * @param left array of at least count samples or 0
+     * @param right array of at least count samples or 0
+     * @param count maximum number of samples to read
+     * @return number of samples read, 0 at the end of the recording
+     * @throw FormatException samples are wider than 8 bits
+     * @see read(int*, int*, sampleIndexType)
+     */
+    sampleIndexType WaveReader::read(boost::int8_t* left,
+                                     boost::int8_t* right,
+                                     sampleIndexType count)
+    {
+        checkNativeFormat(SAMPLE_INT8);
+        boost::int8_t* outputs[2] = { left, right };
+        return readSamples(outputs, 2, count);
+    }
+
+    /**
+     * Reads next samples into floating point channel arrays.
+     *
+     * @param left array of at least count samples or 0
+     * @param right array of at least count samples or 0
+     * @param count maximum number of samples to read
+     * @return number of samples read, 0 at the end of the recording
+     * @see read(int*, int*, sampleIndexType)
+     */
+    sampleIndexType WaveReader::read(float* left, float* right,
+                                     sampleIndexType count)
+    {
+        float* outputs[2] = { left, right };
+        return readSamples(outputs, 2, count);
+    }
+
+    /**
+     * Reads next samples of selected channels.
+     *
+     * Only channels with a non-null array are decoded, samples of the
+     * other ones are skipped.
+     *
+     * @param channels getChannelsNum() arrays of at least count samples,
+     * or null pointers
+     * @param count maximum number of samples to read
+     * @return number of samples read, 0 at the end of the recording
+     */
+    sampleIndexType WaveReader::read(int* const* channels,
+                                     sampleIndexType count)
+    {
+        return readSamples(channels, hdr.Channels, count);
+    }
+
+    /**
+     * Reads next samples of selected channels into 16-bit arrays.
+     *
+     * @param channels getChannelsNum() arrays of at least count samples,
+     * or null pointers
+     * @param count maximum number of samples to read
+     * @return number of samples read, 0 at the end of the recording
+     * @throw FormatException samples are wider than 16 bits
+     * @see read(int* const*, sampleIndexType)
+     */
+    sampleIndexType WaveReader::read(boost::int16_t* const* channels,
+                                     sampleIndexType count)
+    {
+        checkNativeFormat(SAMPLE_INT16);
+        return readSamples(channels, hdr.Channels, count);
+    }
+
+    /**
+     * Reads next samples of selected channels into 8-bit arrays.
+     *
+     * @param channels getChannelsNum() arrays of at least count samples,
+     * or null pointers
+     * @param count maximum number of samples to read
+     * @return number of samples read, 0 at the end of the recording
+     * @throw FormatException samples are wider than 8 bits
+     * @see read(int* const*, sampleIndexType)
+     */
+    sampleIndexType WaveReader::read(boost::int8_t* const* channels,
+                                     sampleIndexType count)
+    {
+        checkNativeFormat(SAMPLE_INT8);
+        return readSamples(channels, hdr.Channels, count);
+    }
+
+    /**
+     * Reads next samples of selected channels into floating point arrays.
+     *
+     * @param channels getChannelsNum() arrays of at least count samples,
+     * or null pointers
+     * @param count maximum number of samples to read
+     * @return number of samples read, 0 at the end of the recording
+     * @see read(int* const*, sampleIndexType)
+     */
+    sampleIndexType WaveReader::read(float* const* channels,
+                                     sampleIndexType count)
+    {
+        return readSamples(channels, hdr.Channels, count);
+    }
+
+    /**
+     * Reads next samples, mixing all channels down to one.
+     *
+     * Each output sample is the mean of samples of all channels. Mono
+     * recordings are read as they are.
+     *
+     * @param output array of at least count samples
+     * @param count maximum number of samples to read
+     * @return number of samples read, 0 at the end of the recording
+     */
+    sampleIndexType WaveReader::readMono(int* output, sampleIndexType count)
+    {
+        return readSamples(&output, 1, count, true);
+    }
+
+    /**
+     * Reads next samples into a 16-bit array, mixing all channels.
+     *
+     * @param output array of at least count samples
+     * @param count maximum number of samples to read
+     * @return number of samples read, 0 at the end of the recording
+     * @throw FormatException samples are wider than 16 bits
+     * @see readMono(int*, sampleIndexType)
+     */
+    sampleIndexType WaveReader::readMono(boost::int16_t* output,
+                                         sampleIndexType count)
+    {
+        checkNativeFormat(SAMPLE_INT16);
+        return readSamples(&output, 1, count, true);
+    }
+
+    /**
+     * Reads next samples into an 8-bit array, mixing all channels.
+     *
+     * @param output array of at least count samples
+     * @param count maximum number of samples to read
+     * @return number of samples read, 0 at the end of the recording
+     * @throw FormatException samples are wider than 8 bits
+     * @see readMono(int*, sampleIndexType)
+     */
+    sampleIndexType WaveReader::readMono(boost::int8_t* output,
+                                         sampleIndexType count)
+    {
+        checkNativeFormat(SAMPLE_INT8);
+        return readSamples(&output, 1, count, true);
+    }
+
+    /**
+     * Reads next samples into a floating point array, mixing all channels.
+     *
+     * @param output array of at least count samples
+     * @param count maximum number of samples to read
+     * @return number of samples read, 0 at the end of the recording
+     * @see readMono(int*, sampleIndexType)
+     */
+    sampleIndexType WaveReader::readMono(float* output,
+                                         sampleIndexType count)
+    {
+        return readSamples(&output, 1, count, true);
+    }
+
+    /**
+     * Reads raw data in chunks and converts it to samples of type T.
+     *
+     * @param outputs channel arrays of at least count samples or 0
+     * @param outputCount number of channel arrays, channels beyond that
+     * are skipped
+     * @param count maximum number of samples to read
+     * @param downmix whether to mix all channels down into the first array
+     * @return number of samples read
+     */
+    template <typename T>
+    sampleIndexType WaveReader::readSamples(T* const* outputs,
+                                            unsigned int outputCount,
+                                            sampleIndexType count,
+                                            bool downmix)
+    {
+        count = std::min(count, samplesCount - position);
+        const unsigned int bytesPerSamp = hdr.BytesPerSamp;
+        const unsigned int maxChunk =
+            std::max(READ_BUFFER_SIZE / bytesPerSamp, 1u);
+        if (buffer.size() < maxChunk * bytesPerSamp)
+            buffer.resize(maxChunk * bytesPerSamp);
+
+        sampleIndexType done = 0;
+        while (done < count)
+        {
+            unsigned int chunk = static_cast<unsigned int>(
+                std::min<sampleIndexType>(maxChunk, count - done));
+            stream.read(&buffer[0], chunk * bytesPerSamp);
+            chunk = static_cast<unsigned int>(stream.gcount()) / bytesPerSamp;
+            if (0 == chunk)
+                break;
+
+            const char* data = &buffer[0];
+            const unsigned int channels = hdr.Channels;
+            switch (encoding)
+            {
+            case PCM_8:
+                decode(Pcm8Decoder(), data, chunk, channels, outputs,
+                       outputCount, done, downmix);
+                break;
+            case PCM_16:
+                decode(Pcm16Decoder(), data, chunk, channels, outputs,
+                       outputCount, done, downmix);
+                break;
+            case PCM_24:
+                decode(Pcm24Decoder(), data, chunk, channels, outputs,
+                       outputCount, done, downmix);
+                break;
+            case PCM_32:
+                decode(Pcm32Decoder(), data, chunk, channels, outputs,
+                       outputCount, done, downmix);
+                break;
+            case FLOAT_32:
+                decode(Float32Decoder(), data, chunk, channels, outputs,
+                       outputCount, done, downmix);
+                break;
+            case FLOAT_64:
+                decode(Float64Decoder(), data, chunk, channels, outputs,
+                       outputCount, done, downmix);
+                break;
+            case MU_LAW:
+                decode(CompandedDecoder(PcmKernels::getMuLawTable()), data,
+                       chunk, channels, outputs, outputCount, done, downmix);
+                break;
+            case A_LAW:
+                decode(CompandedDecoder(PcmKernels::getALawTable()), data,
+                       chunk, channels, outputs, outputCount, done, downmix);
+                break;
+            }
+            done += chunk;
+        }
+
+        position += done;
+        return done;
+    }
+
+    /**
+     * Returns the smallest sample type holding decoded samples.
+     *
+     * @return SAMPLE_INT8 for 8-bit, SAMPLE_INT16 for 16-bit and companded,
+     * SAMPLE_INT32 for 24 and 32-bit and SAMPLE_FLOAT for floating point
+     * files
+     */
+    SampleFormat WaveReader::getNativeFormat() const
+    {
+        switch (encoding)
+        {
+        case PCM_8:
+            return SAMPLE_INT8;
+        case PCM_24:
+        case PCM_32:
+            return SAMPLE_INT32;
+        case FLOAT_32:
+        case FLOAT_64:
+            return SAMPLE_FLOAT;
+        default:
+            return SAMPLE_INT16;
+        }
+    }
+
+    /**
+     * Checks whether decoded samples fit in a given integer type.
+     *
+     * Floating point samples are saturated, so they fit in any type.
+     *
+     * @param format SAMPLE_INT8 or SAMPLE_INT16
+     * @throw FormatException samples are wider than the type
+     */
+    void WaveReader::checkNativeFormat(SampleFormat format) const
+    {
+        const SampleFormat native = getNativeFormat();
+        if (SAMPLE_FLOAT == native)
+            return;
+
+        if (SAMPLE_INT32 == native || (SAMPLE_INT8 == format &&
+                                       SAMPLE_INT16 == native))
+        {
+            throw FormatException(SAMPLE_INT8 == format ?
+                "Read error: samples do not fit in 8 bits!" :
+                "Read error: samples do not fit in 16 bits!");
+        }
+    }
+
+    /**
+     * Finds the encoding of samples described by a header.
+     *
+     * @param hdr header with resolved format tag
+     * @param encoding where to store the encoding
+     * @return false, if the encoding is not supported
+     */
+    bool WaveReader::findEncoding(const WaveHeader& hdr, Encoding& encoding)
+    {
+        switch (hdr.formatTag)
+        {
+        case FORMAT_PCM:
+            switch (hdr.BitsPerSamp)
+            {
+            case 8:
+                encoding = PCM_8;
+                return true;
+            case 16:
+                encoding = PCM_16;
+                return true;
+            case 24:
+                encoding = PCM_24;
+                return true;
+            case 32:
+                encoding = PCM_32;
+                return true;
+            }
+            break;
+        case FORMAT_IEEE_FLOAT:
+            if (32 == hdr.BitsPerSamp || 64 == hdr.BitsPerSamp)
+            {
+                encoding = (32 == hdr.BitsPerSamp) ? FLOAT_32 : FLOAT_64;
+                return true;
+            }
+            break;
+        case FORMAT_MULAW:
+        case FORMAT_ALAW:
+            if (8 == hdr.BitsPerSamp)
+            {
+                encoding = (FORMAT_MULAW == hdr.formatTag) ? MU_LAW : A_LAW;
+                return true;
+            }
+            break;
+        }
+
+        return false;
+    }
+
+    /**
+     * Reads next block of samples.
+     *
+     * Channel vectors are resized to the number of samples read. The
+     * right channel stays empty for mono recordings.
+     *
+     * @param left left channel block
+     * @param right right channel block
+     * @return number of samples read, 0 at the end of the recording
+     */
+    unsigned int WaveReader::readBlock(channelType& left, channelType& right)
+    {
+        const unsigned int count = static_cast<unsigned int>(
+            std::min<sampleIndexType>(blockSize, samplesCount - position));
+        left.resize(count);
+        right.resize(hdr.Channels > 1 ? count : 0);
+        if (0 == count)
+            return 0;
+
+        const unsigned int done = static_cast<unsigned int>(
+            read(&left[0], right.empty() ? 0 : &right[0], count));
+        left.resize(done);
+        if (!right.empty())
+            right.resize(done);
+
+        return done;
+    }
+
+    /**
+     * Reads RIFF chunks up to the beginning of sample data.
+     *
+     * Besides RIFF, RF64 (and BW64) files, whose 64-bit sizes are kept
+     * in a "ds64" chunk, and Sony Wave64 files, which have GUID chunk
+     * names and 64-bit chunk sizes, are recognized.
+     *
+     * The "fmt " chunk can be longer than 16 bytes, the extra format
+     * bytes are skipped, as are all chunks other than "fmt " and "data".
+     * Header fields are stored in the canonical 44-byte form, sizes over
+     * 4 GB are saturated. The format tag of WAVE_FORMAT_EXTENSIBLE files
+     * is replaced by the tag of their sub-format, eg. FORMAT_PCM.
+     *
+     * @param stream input stream at the beginning of the file
+     * @param hdr where to store the header
+     * @param dataSize where to store the size of sample data in bytes
+     * @return offset of the sample data in the file
+     * @throw FormatException file is not a RIFF WAVE file
+     */
+    boost::uint64_t WaveReader::readHeader(std::istream& stream,
+                                           WaveHeader& hdr,
+                                           boost::uint64_t& dataSize)
+    {
+        // Wave64 files begin with two GUIDs and a size in between
+        char riff[40];
+        if (!stream.read(riff, 12))
+        {
+            throw FormatException("Load error: not a RIFF WAVE file!");
+        }
+        const bool w64 = 0 == std::memcmp(riff, "riff", 4);
+        const bool rf64 = 0 == std::memcmp(riff, "RF64", 4) ||
+            0 == std::memcmp(riff, "BW64", 4);
+        if (w64)
+        {
+            if (!stream.read(riff + 12, 28) ||
+                std::memcmp(riff + 4, W64_RIFF_GUID, 12) != 0 ||
+                !isChunk(riff + 24, "wave", true))
+            {
+                throw FormatException("Load error: not a RIFF WAVE file!");
+            }
+        }
+        else if ((!rf64 && std::memcmp(riff, "RIFF", 4) != 0) ||
+                 std::memcmp(riff + 8, "WAVE", 4) != 0)
+        {
+            throw FormatException("Load error: not a RIFF WAVE file!");
+        }
+
+        std::memset(&hdr, 0, sizeof(WaveHeader));
+        std::memcpy(hdr.RIFF, "RIFF", 4);
+        std::memcpy(hdr.WAVE, "WAVE", 4);
+        if (!w64 && !rf64)
+            readField(riff + 4, hdr.DataLength);
+
+        // Wave64 chunk headers are a GUID and a size including the header,
+        // chunks are aligned to 8 bytes instead of 2
+        const unsigned int headerSize = w64 ? 24 : 8;
+        const unsigned int alignment = w64 ? 8 : 2;
+        boost::uint64_t offset = w64 ? 40 : 12;
+        boost::uint64_t ds64DataSize = 0;
+        bool hasFormat = false, hasSize = !rf64;
+        char chunk[24];
+        while (stream.read(chunk, headerSize))
+        {
+            boost::uint64_t size;
+            if (w64)
+            {
+                readField(chunk + 16, size);
+                if (size < headerSize)
+                {
+                    throw FormatException("Load error: invalid chunk size!");
+                }
+                size -= headerSize;
+            }
+            else
+            {
+                boost::uint32_t size32;
+                readField(chunk + 4, size32);
+                size = size32;
+            }
+            offset += headerSize;
+
+            if (isChunk(chunk, "data", w64))
+            {
+                if (!hasFormat || !hasSize)
+                    break;
+                std::memcpy(hdr.data, "data", 4);
+
+                // the real size of RF64 data is in ds64, and a RIFF size
+                // of 0xFFFFFFFF means that the data fill the file
+                if (rf64)
+                    size = ds64DataSize;
+                else if (!w64 && 0xFFFFFFFFu == size)
+                    size = std::numeric_limits<boost::uint64_t>::max();
+                dataSize = size;
+                hdr.WaveSize = saturateField(size);
+                if (w64 || rf64)
+                    hdr.DataLength = saturateField(size + 36);
+                return offset;
+            }
+
+            // chunks are aligned to even offsets (8 bytes in Wave64)
+            const boost::uint64_t padded =
+                size + (alignment - size % alignment) % alignment;
+            boost::uint64_t skip = padded;
+            if (rf64 && isChunk(chunk, "ds64", false))
+            {
+                // RIFF size, data size, sample count and a table of sizes
+                // of other chunks, which are all small enough to skip
+                char ds64[16];
+                if (size < 24 || !stream.read(ds64, 16))
+                {
+                    throw FormatException("Load error: invalid ds64 chunk!");
+                }
+                readField(ds64 + 8, ds64DataSize);
+                hasSize = true;
+                skip -= 16;
+            }
+            else if (isChunk(chunk, "fmt ", w64))
+            {
+                // extensible format ends with a GUID, the first two bytes
+                // of which are the format tag
+                char format[40];
+                const unsigned int length = static_cast<unsigned int>(
+                    std::min<boost::uint64_t>(size, 40));
+                if (size < 16 || !stream.read(format, length))
+                {
+                    throw FormatException("Load error: invalid fmt chunk!");
+                }
+                std::memcpy(hdr.fmt_, "fmt ", 4);
+                hdr.SubBlockLength = 16;
+                readField(format, hdr.formatTag);
+                readField(format + 2, hdr.Channels);
+                readField(format + 4, hdr.SampFreq);
+                readField(format + 8, hdr.BytesPerSec);
+                readField(format + 12, hdr.BytesPerSamp);
+                readField(format + 14, hdr.BitsPerSamp);
+                if (FORMAT_EXTENSIBLE == hdr.formatTag)
+                {
+                    if (length < 40)
+                    {
+                        throw FormatException("Load error: invalid fmt "
+                                              "chunk!");
+                    }
+                    readField(format + 24, hdr.formatTag);
+                }
+                hasFormat = true;
+                skip -= length;
+            }
+            stream.seekg(static_cast<std::streamoff>(skip), std::ios::cur);
+            offset += padded;
+        }
+
+        throw FormatException("Load error: no fmt or data chunk!");
+    }
+}
@@ -0,0 +1,268 @@
+/**
+ * @file WaveReader.h
+ *
+ * Streaming WAVE file reader - header.
+ *
+ * WaveReader walks the RIFF chunks of a .wav file and reads samples
+ * block by block, so that recordings larger than available memory
+ * can be processed.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#ifndef WAVEREADER_H
+#define WAVEREADER_H
+
+#include "global.h"
+#include "SampleSpan.h"
+#include "WaveFile.h"
+#include <fstream>
+#include <istream>
+#include <string>
+#include <vector>
+#include <boost/cstdint.hpp>
+
+namespace Aquila
+{
+    /**
+     * Default number of samples in a block returned by readBlock().
+     */
+    const unsigned int DEFAULT_READ_BLOCK_SIZE = 65536;
+
+    /**
+     * Scale of floating point samples.
+     *
+     * Floating point samples, normally between -1 and 1, are scaled to the
+     * range of 16-bit samples, so that features of float and 16-bit files
+     * are comparable.
+     */
+    const float FLOAT_SAMPLE_SCALE = 32768.0f;
+
+    /**
+     * Sequential reader of .wav file samples.
+     *
+     * The reader keeps only a fixed-size buffer of raw data, regardless
+     * of the recording length. Chunks other than "fmt " and "data"
+     * (eg. LIST or fact) are skipped. RF64 and Sony Wave64 files, which
+     * can be larger than 4 GB, are read as well; sample positions are
+     * 64-bit.
+     *
+     * Supported encodings are 8, 16, 24 and 32-bit integer PCM, 32 and
+     * 64-bit floating point (see FLOAT_SAMPLE_SCALE), and mu-law and A-law
+     * companded samples, which are expanded to 16 bits. Samples keep
+     * the range of their encoding, eg. 24-bit samples are not scaled
+     * down to 16 bits.
+     *
+     * Files may have any number of channels. Channels of a multichannel
+     * recording can be read selectively - samples of channels without
+     * an output array are skipped, not decoded.
+     */
+    class AQUILA_EXPORT WaveReader
+    {
+    public:
+        /**
+         * Audio channel block as an integer vector.
+         */
+        typedef WaveFile::channelType channelType;
+
+        explicit WaveReader(
+            const std::string& file,
+            unsigned int samplesPerBlock = DEFAULT_READ_BLOCK_SIZE);
+
+        /**
+         * Returns the filename.
+         *
+         * @return full path to the file being read
+         */
+        std::string getFilename() const { return filename; }
+
+        /**
+         * Returns the header, in the canonical 44-byte form.
+         *
+         * @return const reference to header structure
+         */
+        const WaveHeader& getHeader() const { return hdr; }
+
+        /**
+         * Returns number of channels.
+         *
+         * @return 1 for mono, 2 for stereo, more for multichannel files
+         */
+        unsigned short getChannelsNum() const { return hdr.Channels; }
+
+        /**
+         * Returns signal sample frequency.
+         *
+         * @return sample frequency in Hz
+         */
+        unsigned int getSampleFrequency() const { return hdr.SampFreq; }
+
+        /**
+         * Returns number of bytes per sample (of all channels).
+         *
+         * @return channels times bytes per single sample
+         */
+        unsigned int getBytesPerSamp() const { return hdr.BytesPerSamp; }
+
+        /**
+         * Returns number of bits per sample
+         *
+         * @return 8, 16, 24, 32 or 64
+         */
+        unsigned int getBitsPerSamp() const { return hdr.BitsPerSamp; }
+
+        /**
+         * Returns the format tag.
+         *
+         * @return one of WaveFormatTag values
+         */
+        unsigned int getFormatTag() const { return hdr.formatTag; }
+
+        SampleFormat getNativeFormat() const;
+
+        /**
+         * Returns position of the sample data in the file.
+         *
+         * @return offset of the "data" chunk contents in bytes
+         */
+        boost::uint64_t getDataOffset() const { return dataOffset; }
+
+        /**
+         * Returns size of the sample data.
+         *
+         * Unlike WaveSize field of the header, the size is not limited
+         * to 4 GB.
+         *
+         * @return number of bytes of samples of all channels
+         */
+        boost::uint64_t getDataSize() const { return dataSize; }
+
+        /**
+         * Returns the recording length.
+         *
+         * @return number of samples in a channel
+         */
+        sampleIndexType getSamplesCount() const { return samplesCount; }
+
+        /**
+         * Returns number of the next sample to read.
+         *
+         * @return current position in samples
+         */
+        sampleIndexType getPosition() const { return position; }
+
+        /**
+         * Returns number of samples read at once by readBlock().
+         *
+         * @return block size in samples
+         */
+        unsigned int getBlockSize() const { return blockSize; }
+
+        /**
+         * Checks whether all samples have been read.
+         *
+         * @return true at the end of the recording
+         */
+        bool atEnd() const { return position >= samplesCount; }
+
+        void seek(sampleIndexType sample);
+
+        sampleIndexType read(int* left, int* right, sampleIndexType count);
+        sampleIndexType read(boost::int16_t* left, boost::int16_t* right,
+                             sampleIndexType count);
+        sampleIndexType read(boost::int8_t* left, boost::int8_t* right,
+                             sampleIndexType count);
+        sampleIndexType read(float* left, float* right, sampleIndexType count);
+
+        sampleIndexType read(int* const* channels, sampleIndexType count);
+        sampleIndexType read(boost::int16_t* const* channels,
+                             sampleIndexType count);
+        sampleIndexType read(boost::int8_t* const* channels,
+                             sampleIndexType count);
+        sampleIndexType read(float* const* channels, sampleIndexType count);
+
+        sampleIndexType readMono(int* output, sampleIndexType count);
+        sampleIndexType readMono(boost::int16_t* output, sampleIndexType count);
+        sampleIndexType readMono(boost::int8_t* output, sampleIndexType count);
+        sampleIndexType readMono(float* output, sampleIndexType count);
+
+        unsigned int readBlock(channelType& left, channelType& right);
+
+        static boost::uint64_t readHeader(std::istream& stream, WaveHeader& hdr,
+                                          boost::uint64_t& dataSize);
+
+    private:
+        /**
+         * Sample encodings supported by the reader.
+         */
+        enum Encoding { PCM_8, PCM_16, PCM_24, PCM_32, FLOAT_32, FLOAT_64,
+                        MU_LAW, A_LAW };
+
+        /**
+         * Full path of the .wav file.
+         */
+        std::string filename;
+
+        /**
+         * Input file stream.
+         */
+        std::ifstream stream;
+
+        /**
+         * Header structure.
+         */
+        WaveHeader hdr;
+
+        /**
+         * Encoding of the samples.
+         */
+        Encoding encoding;
+
+        /**
+         * Offset of the sample data in the file.
+         */
+        boost::uint64_t dataOffset;
+
+        /**
+         * Size of the sample data in bytes.
+         */
+        boost::uint64_t dataSize;
+
+        /**
+         * Number of samples in a channel.
+         */
+        sampleIndexType samplesCount;
+
+        /**
+         * Number of the next sample to read.
+         */
+        sampleIndexType position;
+
+        /**
+         * Number of samples read by readBlock().
+         */
+        unsigned int blockSize;
+
+        /**
+         * Raw data buffer.
+         */
+        std::vector<char> buffer;
+
+        template <typename T>
+        sampleIndexType readSamples(T* const* outputs, unsigned int outputCount,
+                                    sampleIndexType count,
+                                    bool downmix = false);
+
+        void checkNativeFormat(SampleFormat format) const;
+
+        static bool findEncoding(const WaveHeader& hdr, Encoding& encoding);
+
+        WaveReader(const WaveReader&);
+        WaveReader& operator=(const WaveReader&);
+    };
+}
+
+#endif // WAVEREADER_H
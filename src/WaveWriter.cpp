@@ -0,0 +1,373 @@
+/**
+ * @file WaveWriter.cpp
+ *
+ * Streaming WAVE file writer - implementation.
+ *
+ * WaveWriter encodes samples into a .wav file through a fixed-size
+ * buffer, so that memory use does not depend on the length of written
+ * recordings.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#include "WaveWriter.h"
+
+#include "Exceptions.h"
+#include "WaveReader.h"
+#include <algorithm>
+#include <cstring>
+#include <boost/cstdint.hpp>
+
+namespace Aquila
+{
+    /**
+     * Size of the raw data buffer in bytes.
+     */
+    const unsigned int WRITE_BUFFER_SIZE = 65536;
+
+    /**
+     * Limits a sample to the range of an encoding.
+     *
+     * @param value sample value
+     * @param low smallest value of the encoding
+     * @param high largest value of the encoding
+     * @return saturated value
+     */
+    static inline int saturate(int value, int low, int high)
+    {
+        return value < low ? low : (value > high ? high : value);
+    }
+
+    /**
+     * Encoders of samples in supported encodings.
+     *
+     * An encoder knows the size of a single encoded sample in bytes, and
+     * its encode() stores an integer sample at a given address.
+     */
+    struct Pcm8Encoder
+    {
+        static const unsigned int size = 1;
+        void encode(int value, char* p) const
+        {
+            *p = static_cast<char>(saturate(value, -128, 127) + 128);
+        }
+    };
+
+    struct Pcm16Encoder
+    {
+        static const unsigned int size = 2;
+        void encode(int value, char* p) const
+        {
+            boost::int16_t v = static_cast<boost::int16_t>(
+                saturate(value, -32768, 32767));
+            std::memcpy(p, &v, 2);
+        }
+    };
+
+    struct Pcm24Encoder
+    {
+        static const unsigned int size = 3;
+        void encode(int value, char* p) const
+        {
+            const int v = saturate(value, -8388608, 8388607);
+            p[0] = static_cast<char>(v);
+            p[1] = static_cast<char>(v >> 8);
+            p[2] = static_cast<char>(v >> 16);
+        }
+    };
+
+    struct Pcm32Encoder
+    {
+        static const unsigned int size = 4;
+        void encode(int value, char* p) const
+        {
+            boost::int32_t v = value;
+            std::memcpy(p, &v, 4);
+        }
+    };
+
+    struct Float32Encoder
+    {
+        static const unsigned int size = 4;
+        void encode(int value, char* p) const
+        {
+            float v = value / FLOAT_SAMPLE_SCALE;
+            std::memcpy(p, &v, 4);
+        }
+    };
+
+    /**
+     * Encodes samples of all channels into interleaved raw data.
+     *
+     * A null channel pointer writes silence to that channel.
+     *
+     * @param encoder encoder of the sample encoding
+     * @param channels channel arrays
+     * @param channelsNum number of channels
+     * @param offset index of the first sample to encode in channel arrays
+     * @param count number of samples in a channel
+     * @param data where to store raw data
+     */
+    template <typename E>
+    static void encode(const E& encoder, const int* const* channels,
+                       unsigned int channelsNum, sampleIndexType offset,
+                       unsigned int count, char* data)
+    {
+        const unsigned int step = channelsNum * E::size;
+        for (unsigned int c = 0; c < channelsNum; ++c)
+        {
+            char* out = data + c * E::size;
+            if (channels[c])
+            {
+                const int* in = channels[c] + offset;
+                for (unsigned int i = 0; i < count; ++i, out += step)
+                    encoder.encode(in[i], out);
+            }
+            else
+            {
+                for (unsigned int i = 0; i < count; ++i, out += step)
+                    encoder.encode(0, out);
+            }
+        }
+    }
+
+    /**
+     * Creates the file and prepares it for writing samples.
+     *
+     * @param file full path to .wav file
+     * @param sampleFrequency sample frequency in Hz
+     * @param channels number of channels
+     * @param bitsPerSample 8, 16, 24 or 32 for PCM, 32 for floating point
+     * @param format FORMAT_PCM or FORMAT_IEEE_FLOAT
+     * @throw Aquila::Exception when the file cannot be created
+     * @throw FormatException unsupported sample format
+     */
+    WaveWriter::WaveWriter(const std::string& file,
+                           unsigned int sampleFrequency,
+                           unsigned short channels,
+                           unsigned short bitsPerSample,
+                           WaveFormatTag format):
+        filename(file), encoding(PCM_16), samplesCount(0)
+    {
+        if (0 == channels)
+        {
+            throw FormatException("Save error: no channels!");
+        }
+        if (FORMAT_IEEE_FLOAT == format && 32 == bitsPerSample)
+            encoding = FLOAT_32;
+        else if (FORMAT_PCM == format && 8 == bitsPerSample)
+            encoding = PCM_8;
+        else if (FORMAT_PCM == format && 16 == bitsPerSample)
+            encoding = PCM_16;
+        else if (FORMAT_PCM == format && 24 == bitsPerSample)
+            encoding = PCM_24;
+        else if (FORMAT_PCM == format && 32 == bitsPerSample)
+            encoding = PCM_32;
+        else
+        {
+            throw FormatException("Save error: unsupported sample format!");
+        }
+
+        std::memset(&hdr, 0, sizeof(WaveHeader));
+        std::memcpy(hdr.RIFF, "RIFF", 4);
+        std::memcpy(hdr.WAVE, "WAVE", 4);
+        std::memcpy(hdr.fmt_, "fmt ", 4);
+        std::memcpy(hdr.data, "data", 4);
+        hdr.SubBlockLength = 16;
+        hdr.formatTag = format;
+        hdr.Channels = channels;
+        hdr.SampFreq = sampleFrequency;
+        hdr.BytesPerSamp = channels * (bitsPerSample / 8);
+        hdr.BytesPerSec = sampleFrequency * hdr.BytesPerSamp;
+        hdr.BitsPerSamp = bitsPerSample;
+        hdr.DataLength = sizeof(WaveHeader) - 8;
+
+        const unsigned int maxChunk =
+            std::max(WRITE_BUFFER_SIZE / hdr.BytesPerSamp, 1u);
+        buffer.resize(maxChunk * hdr.BytesPerSamp);
+
+        stream.open(filename.c_str(), std::ios::out | std::ios::binary);
+        if (!stream)
+        {
+            throw Exception("Cannot open file " + filename);
+        }
+
+        // the header is rewritten at close(), when sizes are known
+        writeHeader();
+    }
+
+    /**
+     * Closes the file, if it was not closed yet.
+     *
+     * Errors are ignored here, call close() to handle them.
+     */
+    WaveWriter::~WaveWriter()
+    {
+        try
+        {
+            close();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    /**
+     * Writes next samples of all channels.
+     *
+     * @param channels getChannelsNum() arrays of at least count samples;
+     * a null pointer writes silence to that channel
+     * @param count number of samples to write in each channel
+     * @throw Aquila::Exception when the file is closed or cannot be written
+     * @throw FormatException data would not fit in a RIFF file
+     */
+    void WaveWriter::write(const int* const* channels, sampleIndexType count)
+    {
+        const unsigned int maxChunk = buffer.size() / hdr.BytesPerSamp;
+        for (sampleIndexType done = 0; done < count; )
+        {
+            const unsigned int chunk = static_cast<unsigned int>(
+                std::min<sampleIndexType>(maxChunk, count - done));
+            writeChunk(channels, done, chunk);
+            done += chunk;
+        }
+    }
+
+    /**
+     * Writes samples viewed by spans, eg. WaveFile channels.
+     *
+     * Samples are converted to integers a chunk at a time, so that no
+     * copy of whole spans is made.
+     *
+     * @param channels getChannelsNum() spans of at least count samples
+     * @param count number of samples to write in each channel
+     * @throw Aquila::Exception when the file is closed or cannot be written
+     * @throw FormatException data would not fit in a RIFF file
+     * @see write(const int* const*, sampleIndexType)
+     */
+    void WaveWriter::write(const SampleSpan* channels, sampleIndexType count)
+    {
+        const unsigned int channelsNum = hdr.Channels;
+        const unsigned int maxChunk = buffer.size() / hdr.BytesPerSamp;
+        samples.resize(channelsNum * maxChunk);
+        std::vector<const int*> converted(channelsNum);
+        for (unsigned int c = 0; c < channelsNum; ++c)
+            converted[c] = &samples[c * maxChunk];
+
+        for (sampleIndexType done = 0; done < count; )
+        {
+            const unsigned int chunk = static_cast<unsigned int>(
+                std::min<sampleIndexType>(maxChunk, count - done));
+            for (unsigned int c = 0; c < channelsNum; ++c)
+            {
+                channels[c].subspan(done, done + chunk).copyTo(
+                    &samples[c * maxChunk]);
+            }
+            writeChunk(&converted[0], 0, chunk);
+            done += chunk;
+        }
+    }
+
+    /**
+     * Encodes a chunk of samples into the buffer and writes it.
+     *
+     * @param channels channel arrays
+     * @param offset index of the first sample to write in channel arrays
+     * @param count number of samples, at most what fits in the buffer
+     */
+    void WaveWriter::writeChunk(const int* const* channels,
+                                sampleIndexType offset, unsigned int count)
+    {
+        if (!stream.is_open())
+        {
+            throw Exception("Save error: file " + filename + " is closed!");
+        }
+
+        // the canonical header has 32-bit sizes
+        const boost::uint64_t dataSize =
+            (samplesCount + count) * hdr.BytesPerSamp;
+        if (dataSize > 0xFFFFFFFFu - sizeof(WaveHeader))
+        {
+            throw FormatException("Save error: data do not fit in a RIFF "
+                                  "file!");
+        }
+
+        char* data = &buffer[0];
+        const unsigned int channelsNum = hdr.Channels;
+        switch (encoding)
+        {
+        case PCM_8:
+            encode(Pcm8Encoder(), channels, channelsNum, offset, count, data);
+            break;
+        case PCM_16:
+            encode(Pcm16Encoder(), channels, channelsNum, offset, count, data);
+            break;
+        case PCM_24:
+            encode(Pcm24Encoder(), channels, channelsNum, offset, count, data);
+            break;
+        case PCM_32:
+            encode(Pcm32Encoder(), channels, channelsNum, offset, count, data);
+            break;
+        case FLOAT_32:
+            encode(Float32Encoder(), channels, channelsNum, offset, count,
+                   data);
+            break;
+        }
+
+        stream.write(data, count * hdr.BytesPerSamp);
+        if (!stream)
+        {
+            throw Exception("Cannot write file " + filename);
+        }
+        samplesCount += count;
+    }
+
+    /**
+     * Completes the header and closes the file.
+     *
+     * Does nothing if the file is already closed.
+     *
+     * @throw Aquila::Exception when the file cannot be written
+     */
+    void WaveWriter::close()
+    {
+        if (!stream.is_open())
+            return;
+
+        // data chunk is padded to an even size, the pad byte is not a part
+        // of the data, but of the RIFF chunk
+        const unsigned int dataSize =
+            static_cast<unsigned int>(samplesCount * hdr.BytesPerSamp);
+        const unsigned int padding = dataSize & 1;
+        if (padding)
+            stream.put(0);
+        hdr.WaveSize = dataSize;
+        hdr.DataLength = sizeof(WaveHeader) - 8 + dataSize + padding;
+
+        stream.seekp(0, std::ios::beg);
+        writeHeader();
+        stream.close();
+        if (!stream)
+        {
+            throw Exception("Cannot write file " + filename);
+        }
+    }
+
+    /**
+     * Writes the header at the current position.
+     *
+     * @throw Aquila::Exception when the file cannot be written
+     */
+    void WaveWriter::writeHeader()
+    {
+        stream.write(reinterpret_cast<const char*>(&hdr), sizeof(WaveHeader));
+        if (!stream)
+        {
+            stream.close();
+            throw Exception("Cannot write file " + filename);
+        }
+    }
+}
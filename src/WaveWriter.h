@@ -0,0 +1,146 @@
+/**
+ * @file WaveWriter.h
+ *
+ * Streaming WAVE file writer - header.
+ *
+ * WaveWriter encodes samples into a .wav file through a fixed-size
+ * buffer, so that memory use does not depend on the length of written
+ * recordings.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#ifndef WAVEWRITER_H
+#define WAVEWRITER_H
+
+#include "global.h"
+#include "SampleSpan.h"
+#include "WaveFile.h"
+#include <fstream>
+#include <string>
+#include <vector>
+#include <boost/cstdint.hpp>
+
+namespace Aquila
+{
+    /**
+     * Sequential writer of .wav files.
+     *
+     * Samples of all channels are written together, block after block,
+     * and encoded straight into a fixed-size buffer. The header is
+     * written at close(), when the data size is known.
+     *
+     * Supported encodings are 8, 16, 24 and 32-bit integer PCM and 32-bit
+     * floating point, where samples are divided by FLOAT_SAMPLE_SCALE.
+     * Integer samples out of the range of the encoding are saturated.
+     */
+    class AQUILA_EXPORT WaveWriter
+    {
+    public:
+        WaveWriter(const std::string& file, unsigned int sampleFrequency,
+                   unsigned short channels = 1,
+                   unsigned short bitsPerSample = 16,
+                   WaveFormatTag format = FORMAT_PCM);
+        ~WaveWriter();
+
+        /**
+         * Returns the filename.
+         *
+         * @return full path to the file being written
+         */
+        std::string getFilename() const { return filename; }
+
+        /**
+         * Returns the header, as written at close().
+         *
+         * @return const reference to header structure
+         */
+        const WaveHeader& getHeader() const { return hdr; }
+
+        /**
+         * Returns number of channels.
+         *
+         * @return number of interleaved channels
+         */
+        unsigned short getChannelsNum() const { return hdr.Channels; }
+
+        /**
+         * Returns signal sample frequency.
+         *
+         * @return sample frequency in Hz
+         */
+        unsigned int getSampleFrequency() const { return hdr.SampFreq; }
+
+        /**
+         * Returns number of bits per sample
+         *
+         * @return 8, 16, 24 or 32
+         */
+        unsigned int getBitsPerSamp() const { return hdr.BitsPerSamp; }
+
+        /**
+         * Returns number of samples written so far.
+         *
+         * @return number of samples in a channel
+         */
+        sampleIndexType getSamplesCount() const { return samplesCount; }
+
+        void write(const int* const* channels, sampleIndexType count);
+        void write(const SampleSpan* channels, sampleIndexType count);
+
+        void close();
+
+    private:
+        /**
+         * Sample encodings supported by the writer.
+         */
+        enum Encoding { PCM_8, PCM_16, PCM_24, PCM_32, FLOAT_32 };
+
+        /**
+         * Full path of the .wav file.
+         */
+        std::string filename;
+
+        /**
+         * Output file stream.
+         */
+        std::ofstream stream;
+
+        /**
+         * Header structure.
+         */
+        WaveHeader hdr;
+
+        /**
+         * Encoding of the samples.
+         */
+        Encoding encoding;
+
+        /**
+         * Number of samples in a channel written so far.
+         */
+        sampleIndexType samplesCount;
+
+        /**
+         * Raw data buffer.
+         */
+        std::vector<char> buffer;
+
+        /**
+         * Samples of all channels converted from spans.
+         */
+        std::vector<int> samples;
+
+        void writeChunk(const int* const* channels, sampleIndexType offset,
+                        unsigned int count);
+        void writeHeader();
+
+        WaveWriter(const WaveWriter&);
+        WaveWriter& operator=(const WaveWriter&);
+    };
+}
+
+#endif // WAVEWRITER_H
@@ -13,17 +13,22 @@
  */
 
 #include "Window.h"
+#include "PrecomputedTables.h"
 #include <algorithm>
 
 namespace Aquila
 {
-	Window::windowsCacheType Window::windowsCache;
+    /**
+     * Window cache, keyed by window type and length.
+     */
+    static Window::CacheType s_windows(&Window::createTable);
 
     /**
      * Returns window value for a given window type, size and position.
      *
      * Window is first looked up in cache. If it doesn't exist,
      * it is generated. The cached value is then returned.
+     * To window a whole frame, use getTable() instead.
      *
      * @param type window function type
      * @param n sample position in the window
@@ -32,40 +37,103 @@ namespace Aquila
      */
     double Window::apply(WindowType type, unsigned int n, unsigned int N)
     {
-        keyType key = std::make_pair(type, N);
+        return (*getTable(type, N))[n];
+    }
 
-        if (windowsCache.find(key) == windowsCache.end())
-            createWindow(key);
+    /**
+     * Returns a table of window values for a given type and size.
+     *
+     * The table is generated on first request. This method can be safely
+     * called from many threads.
+     *
+     * @param type window function type
+     * @param N window length
+     * @return shared pointer to N window values, aligned to SIMD_ALIGNMENT
+     * @since 2.6.0
+     */
+    Window::TablePointer Window::getTable(WindowType type, unsigned int N)
+    {
+        return s_windows.get(KeyType(type, N));
+    }
 
-        return windowsCache[key][n];
+    /**
+     * Returns the window cache, eg. to read its statistics or bound its size.
+     *
+     * @return reference to the window cache
+     * @since 2.6.0
+     */
+    Window::CacheType& Window::getCache()
+    {
+        return s_windows;
     }
 
     /**
-     * Generates new window vector for a given type and size.
+     * Generates a window table, as the window cache does on a miss.
      *
-     * Rectangular window is handled separately because it does not need
-     * any additional computation.
+     * Tables compiled into the library are copied instead, if available.
      *
-     * @param windowKey a cache key
+     * @param key window type and length
+     * @return shared pointer to new table
      */
-	void Window::createWindow(const keyType& windowKey)
-	{
-        WindowType type = windowKey.first;
-        unsigned int N = windowKey.second;
-
-        if (type != WIN_RECT)
+    Window::TablePointer Window::createTable(const KeyType& key)
+    {
+        const unsigned int N = key.second;
+        alignedVectorType* window = new alignedVectorType(N > 0 ? N : 1, 1.0);
+        const double* precomputed = PrecomputedTables::findWindow(key.first, N);
+        if (precomputed)
         {
-            winType window;
-            window.reserve(N);
-            std::generate_n(std::back_inserter(window), N, WinGenerator(type, N));
-            windowsCache[windowKey] = window;
+            std::copy(precomputed, precomputed + N, window->begin());
         }
-        else
+        else if (N > 1)
         {
-            winType window(N, 1.0);
-            windowsCache[windowKey] = window;
+            WindowFunction function = getFunction(key.first);
+            for (unsigned int n = 0; n < N; ++n)
+            {
+                (*window)[n] = function(n, N);
+            }
+        }
+
+        return TablePointer(window);
+    }
+
+    /**
+     * Returns the function generating a given window type.
+     *
+     * @param type window function type
+     * @return pointer to window function
+     */
+    Window::WindowFunction Window::getFunction(WindowType type)
+    {
+        switch (type)
+        {
+        case WIN_RECT:
+            return &Window::rectangular;
+        case WIN_HAMMING:
+            return &Window::hamming;
+        case WIN_HANN:
+            return &Window::hann;
+        case WIN_BARLETT:
+            return &Window::barlett;
+        case WIN_BLACKMAN:
+            return &Window::blackman;
+        case WIN_FLATTOP:
+            return &Window::flattop;
+        default:
+            return &Window::hamming;
         }
-	}
+    }
+
+    /**
+     * Rectangular window.
+     *
+     * The value does not depend on sample position nor window size.
+     *
+     * @return always 1.0
+     */
+    double Window::rectangular(unsigned int, unsigned int)
+    {
+        return 1.0;
+    }
 
     /**
      * Hamming window.
@@ -130,49 +198,4 @@ namespace Aquila
                 0.388 * std::cos(6.0 * M_PI * n / double(N - 1)) +
                 0.0322 * std::cos(8.0 * M_PI * n / double(N - 1));
     }
-
-    /**
-     * Creates the generator functor.
-     *
-     * @param type window function type
-     * @param N window size
-     */
-    Window::WinGenerator::WinGenerator(WindowType type, unsigned int N):
-        _N(N)
-    {
-        switch (type)
-        {
-        case WIN_HAMMING:
-            windowMethod = &Window::hamming;
-            break;
-        case WIN_HANN:
-            windowMethod = &Window::hann;
-            break;
-        case WIN_BARLETT:
-            windowMethod = &Window::barlett;
-            break;
-        case WIN_BLACKMAN:
-            windowMethod = &Window::blackman;
-            break;
-        case WIN_FLATTOP:
-            windowMethod = &Window::flattop;
-            break;
-        default:
-            windowMethod = &Window::hamming;
-            break;
-        }
-    }
-
-    /**
-     * Calculates next window sample.
-     *
-     * Each consecutive call will advance position by one sample.
-     *
-     * @return window sample
-     */
-    double Window::WinGenerator::operator()() const
-    {
-        static unsigned int n = 0;
-        return windowMethod(n++, _N);
-    }
 }
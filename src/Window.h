@@ -16,10 +16,11 @@
 #define WINDOW_H
 
 #include "global.h"
+#include "AlignedAllocator.h"
+#include "Cache.h"
 #include <cmath>
-#include <map>
 #include <utility>
-#include <vector>
+#include <boost/shared_ptr.hpp>
 
 namespace Aquila
 {
@@ -35,61 +36,50 @@ namespace Aquila
      *
      * Windows are cached with window type combined with its length
      * as a key. It is an efficient way to reduce calls to math functions.
+     * Cached tables are aligned and never change, so they can be kept and
+     * shared between threads; a table stays alive as long as it is held,
+     * even when evicted from a bounded cache.
 	 */
     class AQUILA_EXPORT Window
 	{
 	public:
-		static double apply(WindowType type, unsigned int n, unsigned int N);
-
-	private:
         /**
-         * Key type for the window cache.
+         * Shared pointer to an immutable window table.
          */
-        typedef std::pair<WindowType, unsigned int> keyType;
+        typedef boost::shared_ptr<const alignedVectorType> TablePointer;
 
         /**
-         *  Window vector type.
+         * Cache key - window type and length.
          */
-        typedef std::vector<double> winType;
+        typedef std::pair<WindowType, unsigned int> KeyType;
 
         /**
-         * Cache type.
+         * Type of the window cache.
          */
-        typedef std::map<keyType, winType> windowsCacheType;
+        typedef Cache<KeyType, TablePointer> CacheType;
+
+		static double apply(WindowType type, unsigned int n, unsigned int N);
+
+        static TablePointer getTable(WindowType type, unsigned int N);
+
+        static CacheType& getCache();
 
+        static TablePointer createTable(const KeyType& key);
+
+	private:
         /**
-         * Window cache implemented as a static map.
+         * Pointer to window function.
          */
-        static windowsCacheType windowsCache;
+        typedef double (*WindowFunction)(unsigned int, unsigned int);
 
-        static void createWindow(const keyType& windowKey);
+        static WindowFunction getFunction(WindowType type);
 
+        static double rectangular(unsigned int n, unsigned int N);
         static double hamming(unsigned int n, unsigned int N);
         static double hann(unsigned int n, unsigned int N);
         static double barlett(unsigned int n, unsigned int N);
         static double blackman(unsigned int n, unsigned int N);
         static double flattop(unsigned int n, unsigned int N);
-
-        /**
-         * Private functor class for window generation.
-         */
-        class WinGenerator
-        {
-        public:
-            WinGenerator(WindowType type, unsigned int N);
-            double operator()() const;
-
-        private:
-            /**
-             * Window size.
-             */
-            unsigned int _N;
-
-            /**
-             * Pointer to window function.
-             */
-            double (*windowMethod)(unsigned int, unsigned int);
-        };
 	};
 }
 
@@ -35,33 +35,23 @@ namespace Aquila
     }
 
     /**
-     * Calculates energy for each frame.
+     * Calculates energy of a batch of frames.
      *
-     * @param wav recording object
-     * @param options transform options
+     * @param frames pointers to frames
+     * @param count number of frames
+     * @param sampleFrequency sample frequency of the recording (unused)
+     * @param N frame length after zero padding (unused)
+     * @param transform transform object
+     * @param output count feature vectors
      */
-    void EnergyExtractor::process(WaveFile* wav, const TransformOptions& options)
+    void EnergyExtractor::processFrames(Frame* const* frames,
+                                        unsigned int count, unsigned int,
+                                        unsigned int, Transform& transform,
+                                        std::vector<double>* output)
     {
-        wavFilename = wav->getFilename();
-
-        unsigned int framesCount = wav->getFramesCount();
-        featureArray.resize(framesCount);
-
-        if (m_indicator)
-            m_indicator->start(0, framesCount-1);
-
-        Transform transform(options);
-        for (unsigned int i = 0; i < framesCount; ++i)
+        for (unsigned int i = 0; i < count; ++i)
         {
-            std::vector<double> params;
-            params.push_back(transform.frameLogEnergy(wav->frames[i]));
-            featureArray[i] = params;
-
-            if (m_indicator)
-                m_indicator->progress(i);
+            output[i][0] = transform.frameLogEnergy(frames[i]);
         }
-
-        if (m_indicator)
-            m_indicator->stop();
     }
 }
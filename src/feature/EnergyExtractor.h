@@ -27,7 +27,10 @@ namespace Aquila
         EnergyExtractor(unsigned int frameLength);
         ~EnergyExtractor();
 
-        void process(WaveFile* wav, const TransformOptions& options);
+    protected:
+        void processFrames(Frame* const* frames, unsigned int count,
+                           unsigned int sampleFrequency, unsigned int N,
+                           Transform& transform, std::vector<double>* output);
     };
 }
 
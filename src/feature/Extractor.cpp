@@ -14,6 +14,8 @@
 #include "FeatureReader.h"
 #include "FeatureWriter.h"
 #include "../Exceptions.h"
+#include "../FrameReader.h"
+#include <algorithm>
 #include <fstream>
 
 namespace Aquila
@@ -37,6 +39,182 @@ namespace Aquila
     {
     }
 
+    /**
+     * Calculates features for each frame of a recording.
+     *
+     * Frames are taken from the frame view of the recording, so this
+     * works also with lazy frames.
+     *
+     * @param wav recording object
+     * @param options transform options
+     */
+    void Extractor::process(WaveFile* wav, const TransformOptions& options)
+    {
+        process(wav->getFrameView(), wav->getSampleFrequency(),
+                wav->getSamplesPerFrameZP(), options);
+        wavFilename = wav->getFilename();
+    }
+
+    /**
+     * Calculates features for each frame of a frame view.
+     *
+     * Frame objects are created only for the batch being processed.
+     *
+     * @param frames view of all frames of a recording
+     * @param sampleFrequency sample frequency of the recording
+     * @param N frame length after zero padding
+     * @param options transform options
+     * @since 2.6.0
+     */
+    void Extractor::process(const FrameView& frames,
+                            unsigned int sampleFrequency, unsigned int N,
+                            const TransformOptions& options)
+    {
+        wavFilename.clear();
+
+        unsigned int framesCount = frames.getFramesCount();
+        featureArray.assign(framesCount,
+                            std::vector<double>(m_paramsPerFrame));
+
+        if (m_indicator)
+            m_indicator->start(0, framesCount-1);
+
+        if (framesCount > 0)
+        {
+            Transform transform(options);
+            std::vector<Frame> batchFrames;
+            std::vector<Frame*> batch;
+            batchFrames.reserve(FFT_BATCH_SIZE);
+            batch.reserve(FFT_BATCH_SIZE);
+            for (unsigned int i = 0; i < framesCount; i += FFT_BATCH_SIZE)
+            {
+                const unsigned int count =
+                    std::min(FFT_BATCH_SIZE, framesCount - i);
+                batchFrames.clear();
+                batch.clear();
+                for (unsigned int j = 0; j < count; ++j)
+                    batchFrames.push_back(frames.getFrame(i + j));
+                for (unsigned int j = 0; j < count; ++j)
+                    batch.push_back(&batchFrames[j]);
+
+                processBlock(&batch[0], count, i, sampleFrequency, N,
+                             transform, &featureArray[i]);
+            }
+        }
+
+        if (m_indicator)
+            m_indicator->stop();
+    }
+
+    /**
+     * Calculates features for each frame of a recording read block
+     * by block.
+     *
+     * Without a consumer, features are stored in the extractor as usual.
+     * Otherwise features of each block are passed to the consumer and
+     * only the audio of a single block is held in memory at once.
+     *
+     * @param reader frame reader at the first frame
+     * @param options transform options
+     * @param consumer optional receiver of the features
+     * @since 2.6.0
+     */
+    void Extractor::process(FrameReader& reader,
+                            const TransformOptions& options,
+                            FeatureConsumer* consumer)
+    {
+        wavFilename = reader.getFilename();
+        featureArray.clear();
+
+        if (m_indicator)
+            m_indicator->start(0, reader.getFramesCount()-1);
+
+        Transform transform(options);
+        featureArrayType block;
+        unsigned int count;
+        while ((count = reader.readFrames()) > 0)
+        {
+            const unsigned int first = reader.getFirstFrame();
+            std::vector<double>* output;
+            if (consumer)
+            {
+                block.resize(count, std::vector<double>(m_paramsPerFrame));
+                output = &block[0];
+            }
+            else
+            {
+                featureArray.resize(first + count,
+                                    std::vector<double>(m_paramsPerFrame));
+                output = &featureArray[first];
+            }
+
+            processBlock(&reader.getFrames()[0], count, first,
+                         reader.getSampleFrequency(),
+                         reader.getSamplesPerFrameZP(), transform, output);
+            if (consumer)
+                consumer->consume(first, block);
+        }
+
+        if (m_indicator)
+            m_indicator->stop();
+    }
+
+    /**
+     * Computes features of consecutive frames in batches.
+     *
+     * Progress is reported after each batch.
+     *
+     * @param frames pointers to frames
+     * @param count number of frames
+     * @param firstFrame number of the first frame in the recording
+     * @param sampleFrequency sample frequency of the recording
+     * @param N frame length after zero padding
+     * @param transform transform object
+     * @param output count feature vectors
+     * @since 2.6.0
+     */
+    void Extractor::processBlock(Frame* const* frames, unsigned int count,
+                                 unsigned int firstFrame,
+                                 unsigned int sampleFrequency, unsigned int N,
+                                 Transform& transform,
+                                 std::vector<double>* output)
+    {
+        for (unsigned int i = 0; i < count; i += FFT_BATCH_SIZE)
+        {
+            unsigned int batch = std::min(FFT_BATCH_SIZE, count - i);
+            processFrames(frames + i, batch, sampleFrequency, N, transform,
+                          output + i);
+
+            if (m_indicator)
+                m_indicator->progress(firstFrame + i + batch - 1);
+        }
+    }
+
+    /**
+     * Computes features of a batch of frames - to be reimplemented
+     * in derived classes.
+     *
+     * Extractors written before 2.6.0 reimplement process(WaveFile*, ...)
+     * instead; they keep working with WaveFile objects, but cannot process
+     * a FrameReader or a FrameView, so this implementation throws.
+     *
+     * @param frames pointers to frames
+     * @param count number of frames, at most FFT_BATCH_SIZE
+     * @param sampleFrequency sample frequency of the recording
+     * @param N frame length after zero padding
+     * @param transform transform object, shared by all batches
+     * @param output count feature vectors of m_paramsPerFrame values
+     * @throw Aquila::Exception always
+     * @since 2.6.0
+     */
+    void Extractor::processFrames(Frame* const*, unsigned int, unsigned int,
+                                  unsigned int, Transform&,
+                                  std::vector<double>*)
+    {
+        throw Exception("Extractor " + type + " does not implement "
+                        "processFrames()!");
+    }
+
     /**
      * Saves calculated feature to a writer object (usually to file).
      *
@@ -33,6 +33,16 @@ namespace Aquila
      */
     class FeatureReader;
 
+    /**
+     * Forward reference to streaming frame reader.
+     */
+    class FrameReader;
+
+    /**
+     * Forward reference to feature consumer class.
+     */
+    class FeatureConsumer;
+
     /**
      * Simple structure to provde header data for readers/writers.
      */
@@ -65,14 +75,13 @@ namespace Aquila
         Extractor(unsigned int frameLength, unsigned int paramsPerFrame);
         virtual ~Extractor();
 
-        /**
-         * To be reimplemented in derived classes.
-         *
-         * @param wav instance of wave file object
-         * @param options various transformation options
-         */
-        virtual void process(WaveFile* wav,
-                             const TransformOptions& options) = 0;
+        virtual void process(WaveFile* wav, const TransformOptions& options);
+
+        void process(FrameReader& reader, const TransformOptions& options,
+                     FeatureConsumer* consumer = 0);
+
+        void process(const FrameView& frames, unsigned int sampleFrequency,
+                     unsigned int N, const TransformOptions& options);
 
         bool save(FeatureWriter& writer);
 
@@ -149,6 +158,16 @@ namespace Aquila
             { return featureArray[frame]; }
 
     protected:
+        virtual void processFrames(Frame* const* frames, unsigned int count,
+                                   unsigned int sampleFrequency,
+                                   unsigned int N, Transform& transform,
+                                   std::vector<double>* output);
+
+        void processBlock(Frame* const* frames, unsigned int count,
+                          unsigned int firstFrame,
+                          unsigned int sampleFrequency, unsigned int N,
+                          Transform& transform, std::vector<double>* output);
+
         /**
          * Frame length.
          */
@@ -184,6 +203,31 @@ namespace Aquila
          */
         ProcessingIndicator* m_indicator;
     };
+
+
+    /**
+     * Abstract receiver of features computed from a FrameReader.
+     *
+     * Features passed to a consumer are not stored in the extractor,
+     * so that long recordings can be processed in constant memory.
+     */
+    class AQUILA_EXPORT FeatureConsumer
+    {
+    public:
+        /**
+         * Deletes the consumer.
+         */
+        virtual ~FeatureConsumer() {}
+
+        /**
+         * Receives features of a block of frames.
+         *
+         * @param firstFrame number of the first frame of the block
+         * @param features feature vectors of the frames
+         */
+        virtual void consume(unsigned int firstFrame,
+                             const Extractor::featureArrayType& features) = 0;
+    };
 }
 
 #endif /* EXTRACTOR_H_ */
@@ -15,8 +15,6 @@
 
 namespace Aquila
 {
-    MelFiltersBank* HfccExtractor::hfccFilters = 0;
-
     /**
      * Sets frame length and number of parameters per frame.
      *
@@ -37,73 +35,21 @@ namespace Aquila
     {
     }
 
-
-    /**
-     * Calculates HFCC features for each frame.
-     *
-     * @param wav recording object
-     * @param options transform options
-     */
-    void HfccExtractor::process(WaveFile* wav, const TransformOptions& options)
-    {
-        wavFilename = wav->getFilename();
-
-        unsigned int framesCount = wav->getFramesCount();
-        featureArray.resize(framesCount);
-
-        if (m_indicator)
-            m_indicator->start(0, framesCount-1);
-
-        unsigned int N = wav->getSamplesPerFrameZP();
-        updateFilters(wav->getSampleFrequency(), N);
-
-        spectrumType frameSpectrum(N);
-        std::vector<double> filtersOutput(MELFILTERS);
-        std::vector<double> frameHfcc(m_paramsPerFrame);
-        Transform transform(options);
-
-        // for each frame: FFT -> Mel filtration -> DCT
-        for (unsigned int i = 0; i < framesCount; ++i)
-        {
-            transform.fft(wav->frames[i], frameSpectrum);
-            hfccFilters->applyAll(frameSpectrum, N, filtersOutput);
-            transform.dct(filtersOutput, frameHfcc);
-            featureArray[i] = frameHfcc;
-
-            if (m_indicator)
-                m_indicator->progress(i);
-        }
-
-        if (m_indicator)
-            m_indicator->stop();
-    }
-
     /**
      * Updates the filter bank.
      *
-     * (Re)creates new filter bank when sample frequency or spectrum size
-     * changed. If requested, enables only some filters.
+     * Fetches a shared HFCC filter bank for the given sample frequency and
+     * spectrum size. Selection of enabled filters is applied separately.
      *
      * @param frequency sample frequency
      * @param N spectrum size
      */
     void HfccExtractor::updateFilters(unsigned int frequency, unsigned int N)
     {
-        if (!hfccFilters)
+        if (!filters || filters->getSampleFrequency() != frequency ||
+            filters->getSpectrumLength() != N)
         {
-            hfccFilters = new MelFiltersBank(frequency, N, true);
+            filters = MelFiltersBank::getHfcc(frequency, N);
         }
-        else
-        {
-            if (hfccFilters->getSampleFrequency() != frequency ||
-                hfccFilters->getSpectrumLength() != N)
-            {
-                delete hfccFilters;
-                hfccFilters = new MelFiltersBank(frequency, N, true);
-            }
-        }
-
-        if (enabledFilters)
-            hfccFilters->setEnabledFilters(enabledFilters);
     }
 }
@@ -26,14 +26,7 @@ namespace Aquila
         HfccExtractor(unsigned int frameLength, unsigned int paramsPerFrame);
         ~HfccExtractor();
 
-        void process(WaveFile* wav, const TransformOptions& options);
-
     protected:
-        /**
-         * Mel filters bank, static and common to all HFCC extractors.
-         */
-        static MelFiltersBank* hfccFilters;
-
         void updateFilters(unsigned int frequency, unsigned int N);
     };
 }
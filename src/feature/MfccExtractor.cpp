@@ -17,8 +17,6 @@
 
 namespace Aquila
 {
-    MelFiltersBank* MfccExtractor::filters = 0;
-
     /**
      * Sets frame length and number of parameters per frame.
      *
@@ -41,45 +39,38 @@ namespace Aquila
     }
 
     /**
-     * Calculates MFCC features for each frame.
+     * Calculates MFCC features of a batch of frames.
      *
-     * @param wav recording object
-     * @param options transform options
+     * @param frames pointers to frames
+     * @param count number of frames
+     * @param sampleFrequency sample frequency of the recording
+     * @param N frame length after zero padding
+     * @param transform transform object
+     * @param output count feature vectors
      */
-    void MfccExtractor::process(WaveFile* wav, const TransformOptions& options)
+    void MfccExtractor::processFrames(Frame* const* frames, unsigned int count,
+                                      unsigned int sampleFrequency,
+                                      unsigned int N, Transform& transform,
+                                      std::vector<double>* output)
     {
-        wavFilename = wav->getFilename();
-
-        unsigned int framesCount = wav->getFramesCount();
-        featureArray.resize(framesCount);
-
-        if (m_indicator)
-            m_indicator->start(0, framesCount-1);
-
-        unsigned int N = wav->getSamplesPerFrameZP();
-        updateFilters(wav->getSampleFrequency(), N);
-
-        spectrumType frameSpectrum(N);
-        std::vector<double> filtersOutput(MELFILTERS);
-        std::vector<double> frameMfcc(m_paramsPerFrame);
-        Transform transform(options);
-
-        // for each frame: FFT -> Mel filtration -> DCT
-        for (unsigned int i = 0; i < framesCount; ++i)
+        updateFilters(sampleFrequency, N);
+        if (spectra.empty() || spectra[0].size() != N / 2 + 1)
         {
-            transform.fft(wav->frames[i], frameSpectrum);
-            filters->applyAll(frameSpectrum, N, filtersOutput);
-            transform.dct(filtersOutput, frameMfcc);
-            featureArray[i] = frameMfcc;
-
-            if (m_indicator)
-                m_indicator->progress(i);
+            spectra.assign(FFT_BATCH_SIZE, std::vector<double>(N / 2 + 1));
+            filtersOutput.assign(FFT_BATCH_SIZE,
+                                 std::vector<double>(MELFILTERS));
         }
+        transform.setPeakSearch(false);
 
-        if (m_indicator)
-            m_indicator->stop();
+        // FFT magnitude -> Mel filtration -> DCT
+        transform.rfft(frames, count, &spectra[0], MAGNITUDE_ABS);
+        for (unsigned int b = 0; b < count; ++b)
+        {
+            filters->applyAll(spectra[b], N, filtersOutput[b], enabledFilters);
+        }
+        transform.dct(&filtersOutput[0], count, output);
     }
-    
+
     /**
      * Enables only selected Mel filters.
      */
@@ -97,29 +88,18 @@ namespace Aquila
     /**
      * Updates the filter bank.
      *
-     * (Re)creates new filter bank when sample frequency or spectrum size
-     * changed. If requested, enables only some filters.
+     * Fetches a shared filter bank for the given sample frequency and
+     * spectrum size. Selection of enabled filters is applied separately.
      *
      * @param frequency sample frequency
      * @param N spectrum size
      */
     void MfccExtractor::updateFilters(unsigned int frequency, unsigned int N)
     {
-        if (!filters)
+        if (!filters || filters->getSampleFrequency() != frequency ||
+            filters->getSpectrumLength() != N)
         {
-            filters = new MelFiltersBank(frequency, 200, N);
+            filters = MelFiltersBank::getMel(frequency, 200, N);
         }
-        else
-        {
-            if (filters->getSampleFrequency() != frequency ||
-                filters->getSpectrumLength() != N)
-            {
-                delete filters;
-                filters = new MelFiltersBank(frequency, 200, N);
-            }
-        }
-
-        if (enabledFilters)
-            filters->setEnabledFilters(enabledFilters);
     }
 }
@@ -27,21 +27,28 @@ namespace Aquila
         MfccExtractor(unsigned int frameLength, unsigned int paramsPerFrame);
         ~MfccExtractor();
 
-        void process(WaveFile* wav, const TransformOptions& options);
-
         void setEnabledMelFilters(bool enabled[]);
 
     protected:
         /**
-         * Mel filters bank, static and common to all MFCC extractors.
+         * Mel filters bank, shared by extractors of the same signal format.
          */
-        static MelFiltersBank* filters;
+        MelFiltersBank::PointerType filters;
 
         /**
          * Selection of enabled Mel filters.
          */
         bool* enabledFilters;
 
+        /**
+         * Spectra and filter outputs of a batch of frames.
+         */
+        std::vector<std::vector<double> > spectra, filtersOutput;
+
+        void processFrames(Frame* const* frames, unsigned int count,
+                           unsigned int sampleFrequency, unsigned int N,
+                           Transform& transform, std::vector<double>* output);
+
         virtual void updateFilters(unsigned int frequency, unsigned int N);
     };
 }
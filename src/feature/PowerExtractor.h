@@ -26,7 +26,10 @@ namespace Aquila
         PowerExtractor(unsigned int frameLength);
         ~PowerExtractor();
 
-        void process(WaveFile* wav, const TransformOptions& options);
+    protected:
+        void processFrames(Frame* const* frames, unsigned int count,
+                           unsigned int sampleFrequency, unsigned int N,
+                           Transform& transform, std::vector<double>* output);
     };
 }
 
@@ -0,0 +1,173 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+################################################################################
+# Generates PrecomputedTablesData.cpp - window, Mel filter and DCT tables
+# for fixed signal configurations, compiled into the library.
+#
+# Usage: python gen_tables.py > PrecomputedTablesData.cpp
+#
+# The formulas mirror Window.cpp, MelFilter.cpp and DctPlan.cpp operation by
+# operation, so that the tables are identical to those computed at runtime.
+# Regenerate the file after changing any of them, or CONFIGURATIONS below.
+################################################################################
+
+import math
+import sys
+
+# (sample frequency in Hz, frame length in samples = spectrum size)
+CONFIGURATIONS = [(16000, 512), (8000, 256)]
+
+# window functions precomputed for every frame length above
+WINDOWS = ['WIN_HAMMING']
+
+# Mel filter width used by MfccExtractor
+MEL_FILTER_WIDTH = 200
+
+# must match MELFILTERS in global.h
+MELFILTERS = 24
+
+# must match MATRIX_STRIDE_MULTIPLE in FftKernels.h
+MATRIX_STRIDE_MULTIPLE = 8
+
+VALUES_PER_LINE = 3
+
+
+def hamming(n, N):
+    return 0.53836 - 0.46164 * math.cos(2.0 * math.pi * n / float(N - 1))
+
+WINDOW_FUNCTIONS = {'WIN_HAMMING': hamming}
+
+
+def mel_to_linear(m):
+    return 700.0 * (math.exp(m / 1127.01048) - 1)
+
+
+def mel_filter(num, width, N, fs):
+    mel_min = num * width / 2.0
+    mel_center = mel_min + width / 2.0
+    mel_max = mel_min + width
+    f_min = mel_to_linear(mel_min) * (N / float(fs))
+    f_center = mel_to_linear(mel_center) * (N / float(fs))
+    f_max = mel_to_linear(mel_max) * (N / float(fs))
+    spectrum = []
+    for k in range(N):
+        if k < f_min or k > f_max:
+            value = 0.0
+        elif k < f_center:
+            value = k * 1.0 / (f_center - f_min) - \
+                f_min * 1.0 / (f_center - f_min)
+        else:
+            value = k * 1.0 / (f_center - f_max) - \
+                f_max * 1.0 / (f_center - f_max)
+        spectrum.append(value)
+    # only the nonzero part of the triangle is stored
+    nonzero = [k for k in range(N) if spectrum[k] != 0.0]
+    if not nonzero:
+        return 0, []
+    begin, end = nonzero[0], nonzero[-1] + 1
+    return begin, spectrum[begin:end]
+
+
+def dct_cosines(N, K):
+    stride = (N + MATRIX_STRIDE_MULTIPLE - 1) // MATRIX_STRIDE_MULTIPLE * \
+        MATRIX_STRIDE_MULTIPLE
+    c0 = math.sqrt(1.0 / N)
+    cn = math.sqrt(2.0 / N)
+    cosines = [0.0] * (K * stride)
+    for k in range(K):
+        c = c0 if 0 == k else cn
+        for n in range(N):
+            cosines[k * stride + n] = c * math.cos((math.pi * (2*n+1) * k) /
+                                                   (2 * N))
+    return stride, cosines
+
+
+def format_array(ctype, name, values, fmt):
+    lines = ['    static const %s %s[%d] = {' % (ctype, name, len(values))]
+    for i in range(0, len(values), VALUES_PER_LINE):
+        chunk = values[i:i + VALUES_PER_LINE]
+        lines.append('        ' + ', '.join([fmt % v for v in chunk]) + ',')
+    lines[-1] = lines[-1].rstrip(',')
+    lines.append('    };')
+    return '\n'.join(lines)
+
+
+def main():
+    out = []
+    out.append('''/**
+ * @file PrecomputedTablesData.cpp
+ *
+ * Precomputed tables - data generated by gen_tables.py, do not edit.
+ *
+ * @author Zbigniew Siciarz
+ * @date 2007-2010
+ * @version 2.6.0
+ * @since 2.6.0
+ */
+
+#include "PrecomputedTables.h"
+#include <boost/static_assert.hpp>
+
+namespace Aquila
+{
+    BOOST_STATIC_ASSERT(MELFILTERS == %d);
+''' % MELFILTERS)
+
+    frame_lengths = sorted(set([N for fs, N in CONFIGURATIONS]))
+    windows = []
+    for window in WINDOWS:
+        for N in frame_lengths:
+            name = 's_%s_%d' % (window.lower(), N)
+            values = [WINDOW_FUNCTIONS[window](n, N) for n in range(N)]
+            out.append(format_array('double', name, values, '%.17g'))
+            out.append('')
+            windows.append('        {%s, %d, %s}' % (window, N, name))
+
+    banks = []
+    for fs, N in CONFIGURATIONS:
+        begins, lengths, values = [], [], []
+        for i in range(MELFILTERS):
+            begin, spectrum = mel_filter(i, MEL_FILTER_WIDTH, N, fs)
+            begins.append(begin)
+            lengths.append(len(spectrum))
+            values.extend(spectrum)
+        name = 's_mel_%d_%d' % (fs, N)
+        out.append(format_array('unsigned int', name + '_begins', begins,
+                                '%d'))
+        out.append(format_array('unsigned int', name + '_lengths', lengths,
+                                '%d'))
+        out.append(format_array('double', name + '_values', values, '%.17g'))
+        out.append('')
+        banks.append('        {%d.0, %d, %d,\n         %s_begins, %s_lengths,'
+                     '\n         %s_values}'
+                     % (fs, MEL_FILTER_WIDTH, N, name, name, name))
+
+    stride, cosines = dct_cosines(MELFILTERS, MELFILTERS)
+    name = 's_dct_%d' % MELFILTERS
+    out.append(format_array('double', name, cosines, '%.17g'))
+    out.append('')
+
+    out.append('    const PrecomputedWindow PRECOMPUTED_WINDOWS[] = {')
+    out.append(',\n'.join(windows))
+    out.append('    };')
+    out.append('    const unsigned int PRECOMPUTED_WINDOWS_COUNT = %d;'
+               % len(windows))
+    out.append('')
+    out.append('    const PrecomputedMelBank PRECOMPUTED_MEL_BANKS[] = {')
+    out.append(',\n'.join(banks))
+    out.append('    };')
+    out.append('    const unsigned int PRECOMPUTED_MEL_BANKS_COUNT = %d;'
+               % len(banks))
+    out.append('')
+    out.append('    const PrecomputedDct PRECOMPUTED_DCTS[] = {')
+    out.append('        {%d, %d, %d, %s}' % (MELFILTERS, MELFILTERS, stride,
+                                              name))
+    out.append('    };')
+    out.append('    const unsigned int PRECOMPUTED_DCTS_COUNT = 1;')
+    out.append('}')
+    sys.stdout.write('\n'.join(out) + '\n')
+
+
+if __name__ == '__main__':
+    main()
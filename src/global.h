@@ -15,6 +15,7 @@
 #include <complex>
 #include <string>
 #include <vector>
+#include <boost/cstdint.hpp>
 
 
 #ifdef AQUILA_DLL
@@ -54,6 +55,14 @@ namespace Aquila
      * Spectrum type - a vector of complex values.
      */
     typedef std::vector<cplx> spectrumType;
+
+    /**
+     * Sample position or count in a recording.
+     *
+     * 64 bits wide, so that recordings longer than 2^32 samples (eg. day
+     * long RF64 captures) can be addressed.
+     */
+    typedef boost::uint64_t sampleIndexType;
 }
 
 #endif // GLOBAL_H
@@ -29,13 +29,38 @@ win32:AquilaDll {
     DEFINES    += QT_DLL AQUILA_DLL AQUILA_MAKEDLL
 }
 
+# BOOST
+win32 {
+    LIBS += -LF:\boost_1_41_0\stage\lib
+    LIBS += -llibboost_thread-mgw44-mt-s
+}
+unix {
+    LIBS += -lboost_thread-mt
+}
+
 
 HEADERS +=      WaveFile.h \
+    WaveReader.h \
+    WaveWriter.h \
+    FrameReader.h \
     Tools.h \
     Exceptions.h \
     Cache.h \
+    MappedFile.h \
+    SampleBuffer.h \
+    SampleSpan.h \
+    PrecomputedTables.h \
     Frame.h \
+    FrameView.h \
     Transform.h \
+    FftPlan.h \
+    DctPlan.h \
+    FftKernels.h \
+    PcmKernels.h \
+    AlignedAllocator.h \
+    Convolution.h \
+    LargeFft.h \
+    ThreadPool.h \
     Window.h \
     MelFilter.h \
     MelFiltersBank.h \
@@ -55,9 +80,23 @@ HEADERS +=      WaveFile.h \
     dtw/Dtw.h \
     global.h
 SOURCES +=       WaveFile.cpp \
+    WaveReader.cpp \
+    WaveWriter.cpp \
+    FrameReader.cpp \
     Tools.cpp \
     Frame.cpp \
+    FrameView.cpp \
+    MappedFile.cpp \
     Transform.cpp \
+    FftPlan.cpp \
+    DctPlan.cpp \
+    PrecomputedTables.cpp \
+    PrecomputedTablesData.cpp \
+    FftKernels.cpp \
+    PcmKernels.cpp \
+    Convolution.cpp \
+    LargeFft.cpp \
+    ThreadPool.cpp \
     Window.cpp \
     MelFilter.cpp \
     MelFiltersBank.cpp \
@@ -74,3 +113,7 @@ SOURCES +=       WaveFile.cpp \
     dtw/DtwPoint.cpp \
     dtw/functions.cpp \
     dtw/Dtw.cpp
+
+# regenerate precomputed tables with "make tables"
+tables.commands = python $$PWD/gen_tables.py > $$PWD/PrecomputedTablesData.cpp
+QMAKE_EXTRA_TARGETS += tables